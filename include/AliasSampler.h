@@ -0,0 +1,61 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       AliasSampler.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Random.h"
+#include "Vector.h"
+
+/* Anonymous structures. */
+typedef struct AliasSampler AliasSampler;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new AliasSampler, which draws indexes of a Vector in proportion to the weights of their elements.
+ * Weights - Vector whose elements are weighted. It is only read during construction.
+ * Weight - Returns the non-negative weight of a specified element.
+ *
+ * NOTE: The Weight function MUST be defined, and at least one weight must be positive.
+ * NOTE: The Sampler is never modified after construction, so it can be shared across threads.
+ * NOTE: The Sampler must be de-constructed after its usable life-span.
+ */
+AliasSampler* AliasSampler_new(const Vector* const weights, double(*weight)(const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns a random index, chosen with probability proportional to its weight. */
+unsigned int alias_next(const AliasSampler* const sampler);
+/* Returns the number of indexes which the Sampler chooses from. */
+size_t alias_size(const AliasSampler* const sampler);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void alias_destroy(AliasSampler* const sampler);
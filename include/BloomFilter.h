@@ -0,0 +1,78 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       BloomFilter.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct BloomFilter BloomFilter;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new BloomFilter, which answers whether a key may have been added.
+ * Capacity - Number of keys the Filter is sized for. Exceeding it raises the false positive rate.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ *        May be NULL if the Filter is only ever used through its `_hash` functions.
+ *
+ * Queries never report an added key as missing, but may report a missing key as added.
+ * At capacity, roughly one missing key in two hundred is reported as added.
+ *
+ * NOTE: Keys cannot be removed. See CuckooFilter for a filter which supports removal.
+ * NOTE: The Filter must be de-constructed after its usable life-span.
+ */
+BloomFilter* BloomFilter_new(const size_t capacity, unsigned int(*hash)(const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns false if the specified key was definitely never added to the Filter. */
+bool bloom_contains(const BloomFilter* const filter, const void* const key);
+/* Returns false if a key of the specified hash was definitely never added to the Filter. */
+bool bloom_contains_hash(const BloomFilter* const filter, const unsigned int hash);
+/* Queries several keys at once, storing each answer into the matching index of `results`. */
+void bloom_contains_batch(const BloomFilter* const filter, const void* const* const keys,
+                          const size_t count, bool* const results);
+/* Returns the number of keys the Filter is sized for. */
+size_t bloom_capacity(const BloomFilter* const filter);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Adds a key to the Filter. */
+void bloom_add(BloomFilter* const filter, const void* const key);
+/* Adds a key of the specified hash to the Filter. */
+void bloom_add_hash(BloomFilter* const filter, const unsigned int hash);
+/* Removes every key from the Filter. */
+void bloom_clear(BloomFilter* const filter);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void bloom_destroy(BloomFilter* const filter);
@@ -0,0 +1,103 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       ConcurrentDictionary.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+
+/* Anonymous structures. */
+typedef struct ConcurrentDictionary ConcurrentDictionary;
+typedef struct cdict_Iterator cdict_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new ConcurrentDictionary.
+ * Compare - Compares two keys. Returns -1, 0, or 1 based on how they compare.
+ * toString - Returns the String representation of a specified key/value pair.
+ *
+ * Readers never lock and never write to the Dictionary. Writers only lock the
+ * nodes along the path to the key, so writers to disjoint key ranges do not block one another.
+ *
+ * NOTE: The Compare function MUST be defined.
+ * NOTE: Removed keys may still be passed to `compare` by concurrent readers.
+ *       Do not de-allocate a removed key while other threads may be using the Dictionary.
+ * NOTE: The Dictionary must be de-constructed after its usable life-span.
+ */
+ConcurrentDictionary* ConcurrentDictionary_new(int(*compare)(const void*, const void*),
+                                               char*(*toString)(const void*, const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the value of a mapping whose key matches the specified key. */
+void* cdict_get(const ConcurrentDictionary* const dict, const void* const key);
+/* Returns the number of mappings in the Dictionary. */
+size_t cdict_size(const ConcurrentDictionary* const dict);
+/* Returns true if the Dictionary is empty. */
+bool cdict_empty(const ConcurrentDictionary* const dict);
+/* Returns true if the Dictionary contains a mapping with the specified key. */
+bool cdict_contains(const ConcurrentDictionary* const dict, const void* const key);
+/* Prints out the contents of the Dictionary to the console window. */
+void cdict_print(const ConcurrentDictionary* const dict);
+/* Returns a shallow copy of the Dictionary. */
+ConcurrentDictionary* cdict_clone(const ConcurrentDictionary* const dict);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Inserts a mapping into the Dictionary. */
+void* cdict_put(ConcurrentDictionary* const dict, const void* const key, const void* const value);
+/* Removes a mapping from the Dictionary whose key matches the specified key. */
+void* cdict_remove(ConcurrentDictionary* const dict, const void* const key);
+/* Removes all mappings from the Dictionary. */
+void cdict_clear(ConcurrentDictionary* const dict);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void cdict_destroy(ConcurrentDictionary* const dict);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator for the Dictionary.
+ * Mappings are iterated in ascending order of their keys.
+ *
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: The Dictionary may be modified during the life-span of the Iterator.
+ *       Mappings which are inserted or removed during iteration may or may not be iterated.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+cdict_Iterator* cdict_iter(const ConcurrentDictionary* const dict);
+
+/* Returns the iterator's current key/value pair and advances it forward. */
+void* cdict_iter_next(cdict_Iterator* const iter, void **value);
+/* Returns true if the iterator has a next key/value pair. */
+bool cdict_iter_has_next(const cdict_Iterator* const iter);
+/* De-constructor function. */
+void cdict_iter_destroy(cdict_Iterator* const iter);
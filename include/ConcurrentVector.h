@@ -0,0 +1,99 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       ConcurrentVector.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct ConcurrentVector ConcurrentVector;
+typedef struct cvect_Iterator cvect_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new ConcurrentVector, an append-only Vector.
+ * toString - Returns the String representation of a specified element.
+ *
+ * Elements are stored in segments which are never moved or de-allocated, so readers never lock.
+ * Appending only reserves an index atomically, so writers do not block one another.
+ * An element is published once it and every element before it have been written.
+ *
+ * NOTE: The Vector must be de-constructed after its usable life-span.
+ */
+ConcurrentVector* ConcurrentVector_new(char*(*toString)(const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the published element at the specified index. */
+void* cvect_at(const ConcurrentVector* const vect, const size_t index);
+/* Returns the last published element of the Vector. */
+void* cvect_back(const ConcurrentVector* const vect);
+/* Returns the number of published elements in the Vector. */
+size_t cvect_size(const ConcurrentVector* const vect);
+/* Returns true if the Vector has no published elements. */
+bool cvect_empty(const ConcurrentVector* const vect);
+/* Prints out the contents of the Vector to the console window. */
+void cvect_print(const ConcurrentVector* const vect);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Appends an element at the end of the Vector and returns its index. */
+size_t cvect_push_back(ConcurrentVector* const vect, const void* const data);
+/*
+ * Removes all elements from the Vector.
+ *
+ * NOTE: Unlike other operations, this function must not run alongside any other thread using the Vector.
+ */
+void cvect_clear(ConcurrentVector* const vect);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void cvect_destroy(ConcurrentVector* const vect);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator for the Vector.
+ * The Iterator iterates over the elements which were published when it was constructed.
+ *
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: Elements may be appended to the Vector during the life-span of the Iterator.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+cvect_Iterator* cvect_iter(const ConcurrentVector* const vect);
+
+/* Returns the iterator's current element and advances it forward. */
+void* cvect_iter_next(cvect_Iterator* const iter);
+/* Returns true if the iterator has a next element. */
+bool cvect_iter_has_next(const cvect_Iterator* const iter);
+/* De-constructor function. */
+void cvect_iter_destroy(cvect_Iterator* const iter);
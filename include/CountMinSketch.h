@@ -0,0 +1,80 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       CountMinSketch.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct CountMinSketch CountMinSketch;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new CountMinSketch, which estimates how many times each key of a stream was added.
+ * Width - Counters per row. Estimates exceed the true count by at most (e / width) * total,
+ *         with a probability of at least 1 - e^-depth.
+ * Depth - Number of rows, each hashing keys independently.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ *        May be NULL if the sketch is only ever used through its `_hash` functions.
+ *
+ * Estimates never fall below the true count.
+ * Sketches of the same dimensions and hash function can be merged, so each thread or shard
+ * may count its own part of a stream and combine the results afterwards.
+ *
+ * NOTE: The CountMinSketch must be de-constructed after its usable life-span.
+ */
+CountMinSketch* CountMinSketch_new(const size_t width, const unsigned int depth,
+                                   unsigned int(*hash)(const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the estimated number of times the specified key was added. */
+unsigned long long cms_estimate(const CountMinSketch* const cms, const void* const key);
+/* Returns the estimated number of times a key of the specified hash was added. */
+unsigned long long cms_estimate_hash(const CountMinSketch* const cms, const unsigned int hash);
+/* Returns the total of every count added to the sketch. */
+unsigned long long cms_total(const CountMinSketch* const cms);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Adds a key to the sketch the specified number of times. */
+void cms_add(CountMinSketch* const cms, const void* const key, const unsigned long long count);
+/* Adds a key of the specified hash to the sketch the specified number of times. */
+void cms_add_hash(CountMinSketch* const cms, const unsigned int hash, const unsigned long long count);
+/* Adds every count which was added to another sketch, as if it had been added to this one. */
+void cms_merge(CountMinSketch* const cms, const CountMinSketch* const other);
+/* Removes every count from the sketch. */
+void cms_clear(CountMinSketch* const cms);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void cms_destroy(CountMinSketch* const cms);
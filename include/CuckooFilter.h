@@ -0,0 +1,84 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       CuckooFilter.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+#include "../tools/Random.h"
+
+/* Anonymous structures. */
+typedef struct CuckooFilter CuckooFilter;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new CuckooFilter, which answers whether a key may have been added.
+ * Capacity - Number of keys the Filter is sized for.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ *        May be NULL if the Filter is only ever used through its `_hash` functions.
+ *
+ * Queries never report an added key as missing, but may report a missing key as added.
+ * Roughly one missing key in eight thousand is reported as added.
+ * Unlike a BloomFilter, keys can be removed.
+ *
+ * NOTE: Only remove keys which were added, otherwise an added key may be reported as missing.
+ * NOTE: The Filter must be de-constructed after its usable life-span.
+ */
+CuckooFilter* CuckooFilter_new(const size_t capacity, unsigned int(*hash)(const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns false if the specified key was definitely never added to the Filter. */
+bool cfilter_contains(const CuckooFilter* const filter, const void* const key);
+/* Returns false if a key of the specified hash was definitely never added to the Filter. */
+bool cfilter_contains_hash(const CuckooFilter* const filter, const unsigned int hash);
+/* Queries several keys at once, storing each answer into the matching index of `results`. */
+void cfilter_contains_batch(const CuckooFilter* const filter, const void* const* const keys,
+                            const size_t count, bool* const results);
+/* Returns the number of keys in the Filter. */
+size_t cfilter_size(const CuckooFilter* const filter);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Adds a key to the Filter. Returns false if the Filter is too full to hold it. */
+bool cfilter_add(CuckooFilter* const filter, const void* const key);
+/* Adds a key of the specified hash to the Filter. Returns false if the Filter is too full to hold it. */
+bool cfilter_add_hash(CuckooFilter* const filter, const unsigned int hash);
+/* Removes a key from the Filter and returns true if the removal was successful. */
+bool cfilter_remove(CuckooFilter* const filter, const void* const key);
+/* Removes a key of the specified hash from the Filter and returns true if the removal was successful. */
+bool cfilter_remove_hash(CuckooFilter* const filter, const unsigned int hash);
+/* Removes every key from the Filter. */
+void cfilter_clear(CuckooFilter* const filter);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void cfilter_destroy(CuckooFilter* const filter);
@@ -0,0 +1,108 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       CuckooTable.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct CuckooTable CuckooTable;
+typedef struct cuckoo_Iterator cuckoo_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new CuckooTable.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ *        Data used to calculate Hash/Equals should not change while the key is in the Table.
+ * Equals - Returns true if two keys are equivalent.
+ *          Two different keys in the Table may share the same hash result but cannot be equal.
+ * toString - Returns the String representation of a specified key/value pair.
+ *
+ * Every key can only be stored in one of two buckets, so lookups never probe more than two buckets.
+ * Readers never lock and never write to the Table. Writers only lock the buckets they modify.
+ *
+ * NOTE: The Hash and Equals functions MUST be defined.
+ * NOTE: Removed keys may still be passed to `equals` by concurrent readers.
+ *       Do not de-allocate a removed key while other threads may be using the Table.
+ * NOTE: The Table must be de-constructed after its usable life-span.
+ */
+CuckooTable* CuckooTable_new(unsigned int(*hash)(const void*),
+                             bool(*equals)(const void*, const void*),
+                             char*(*toString)(const void*, const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the value of a mapping whose key matches the specified key. */
+void* cuckoo_get(const CuckooTable* const table, const void* const key);
+/* Returns the number of mappings in the Table. */
+size_t cuckoo_size(const CuckooTable* const table);
+/* Returns true if the Table is empty. */
+bool cuckoo_empty(const CuckooTable* const table);
+/* Returns true if the Table contains a mapping with the specified key. */
+bool cuckoo_contains(const CuckooTable* const table, const void* const key);
+/* Prints out the contents of the Table to the console window. */
+void cuckoo_print(const CuckooTable* const table);
+/* Returns a shallow copy of the Table. */
+CuckooTable* cuckoo_clone(const CuckooTable* const table);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Inserts a mapping into the Table. */
+void* cuckoo_put(CuckooTable* const table, const void* const key, const void* const value);
+/* Removes a mapping from the Table whose key matches the specified key. */
+void* cuckoo_remove(CuckooTable* const table, const void* const key);
+/* Removes all mappings from the Table while preserving the capacity. */
+void cuckoo_clear(CuckooTable* const table);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void cuckoo_destroy(CuckooTable* const table);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator for the Table.
+ *
+ * NOTE: There is no guarantee of order among iterated elements.
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: The Table may be modified during the life-span of the Iterator.
+ *       Mappings which are inserted, moved, or removed during iteration may be iterated once, twice, or not at all.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+cuckoo_Iterator* cuckoo_iter(const CuckooTable* const table);
+
+/* Returns the iterator's current key/value pair and advances it forward. */
+void* cuckoo_iter_next(cuckoo_Iterator* const iter, void **value);
+/* Returns true if the iterator has a next key/value pair. */
+bool cuckoo_iter_has_next(const cuckoo_Iterator* const iter);
+/* De-constructor function. */
+void cuckoo_iter_destroy(cuckoo_Iterator* const iter);
@@ -33,6 +33,7 @@ SOFTWARE.
 #include "../tools/Synchronize.h"
 #include "../tools/Math.h"
 #include "Vector.h"
+#include "BloomFilter.h"
 
 /* Anonymous structures. */
 typedef struct Dictionary Dictionary;
@@ -63,6 +64,8 @@ size_t dict_size(const Dictionary* const dict);
 bool dict_empty(const Dictionary* const dict);
 /* Returns true if the Dictionary contains a mapping with the specified key. */
 bool dict_contains(const Dictionary* const dict, const void* const key);
+/* Returns the number of mappings in the Dictionary whose key matches the specified key. */
+size_t dict_count(const Dictionary* const dict, const void* const key);
 /* Prints out the contents of the Dictionary to the console window. */
 void dict_print(const Dictionary* const dict);
 /* Returns a shallow copy of the Dictionary. */
@@ -72,8 +75,33 @@ Dictionary* dict_clone(const Dictionary* const dict);
 
 /* Inserts a mapping into the Dictionary. */
 void* dict_put(Dictionary *const dict, const void *const key, const void *const value);
+/*
+ * Inserts a mapping into the Dictionary, even if the Dictionary already contains mappings with the same key.
+ *
+ * NOTE: Once a key has several mappings, `dict_get`, `dict_put`, and `dict_remove`
+ *       act on one of them. Use `dict_iter_key` and `dict_remove_all` to reach every mapping.
+ */
+void dict_insert(Dictionary* const dict, const void* const key, const void* const value);
 /* Removes a mapping from the Dictionary whose key matches the specified key. */
 void* dict_remove(Dictionary *const dict, const void *const key);
+/* Removes every mapping whose key matches the specified key and returns the number removed. */
+size_t dict_remove_all(Dictionary* const dict, const void* const key);
+/*
+ * Attaches a BloomFilter of the Dictionary's keys, or detaches it if `hash` is NULL.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ *        Keys which compare as equal must have equal hashes.
+ *
+ * NOTE: While attached, looking up a missing key usually costs one cache line rather than a tree walk.
+ */
+void dict_filter(Dictionary* const dict, unsigned int(*hash)(const void*));
+/*
+ * Switches the Dictionary into interval mode, or back out of it if `end` is NULL.
+ * End - Returns the end of the interval which starts at a specified key, given the key and its value.
+ *       Ends are compared with the Compare function, so they must be of the same type as the keys.
+ *
+ * NOTE: In interval mode, each mapping is the closed interval [key, end], and overlap queries become available.
+ */
+void dict_interval(Dictionary* const dict, const void*(*end)(const void*, const void*));
 /* Removes all mappings from the Dictionary. */
 void dict_clear(Dictionary* const dict);
 
@@ -91,6 +119,23 @@ void dict_destroy(Dictionary* const dict);
  * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
  */
 dict_Iterator* dict_iter(const Dictionary* const dict, const enum dict_iter_traversal traverse_type);
+/*
+ * Constructs a new Iterator over only the mappings whose key matches the specified key.
+ *
+ * NOTE: Mappings are iterated in the order in which they were inserted.
+ * NOTE: The same restrictions apply as with `dict_iter`.
+ */
+dict_Iterator* dict_iter_key(const Dictionary* const dict, const void* const key);
+/*
+ * Constructs a new Iterator over only the mappings whose interval overlaps the closed interval [low, high].
+ *
+ * NOTE: The Dictionary must be in interval mode.
+ * NOTE: Mappings are iterated in order of their key, the start of their interval.
+ * NOTE: The same restrictions apply as with `dict_iter`.
+ */
+dict_Iterator* dict_iter_overlap(const Dictionary* const dict, const void* const low, const void* const high);
+/* Constructs a new Iterator over only the mappings whose interval contains the specified point. */
+dict_Iterator* dict_iter_stab(const Dictionary* const dict, const void* const point);
 
 /* Returns the iterator's current key/value pair and advances it forward. */
 void* dict_iter_next(dict_Iterator* const iter, void **value);
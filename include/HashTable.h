@@ -32,6 +32,8 @@ SOFTWARE.
 #include "../tools/Memory.h"
 #include "../tools/Synchronize.h"
 #include "../tools/Math.h"
+#include "../tools/Random.h"
+#include "BloomFilter.h"
 
 /* Anonymous structures. */
 typedef struct HashTable HashTable;
@@ -64,19 +66,70 @@ size_t table_size(const HashTable* const table);
 bool table_empty(const HashTable* const table);
 /* Returns true if the Dictionary contains a mapping with the specified key. */
 bool table_contains(const HashTable* const table, const void* const key);
+/* Returns the number of mappings in the Table whose key matches the specified key. */
+size_t table_count(const HashTable* const table, const void* const key);
 /* Prints out the contents of the Table to the console window. */
 void table_print(const HashTable* const table);
 /* Returns a shallow copy of the Table. */
 HashTable* table_clone(const HashTable* const table);
+/* Returns the key of a mapping chosen uniformly at random, storing its value into `value` if non-NULL. */
+void* table_random(const HashTable* const table, void** const value);
+/*
+ * Visits the mappings of a bounded batch of buckets, resuming from a cursor.
+ * Visit - Called with each key/value pair and the `data` parameter.
+ *
+ * Begin a scan with a cursor of 0, then pass each returned cursor into the next call.
+ * The scan is complete once 0 is returned.
+ *
+ * NOTE: The Table is only locked during each call, so it may be modified in between calls.
+ * NOTE: Mappings present for the entire scan are visited exactly once, even across resizes.
+ *       Re-seeding the Table during the scan voids this guarantee.
+ * NOTE: The Visit function must not modify the Table.
+ */
+size_t table_scan(const HashTable* const table, size_t cursor, size_t count,
+                  void(*visit)(const void*, const void*, void*), void* const data);
 
 /* ~~~~~ Mutators ~~~~~ */
 
 /* Inserts a mapping into the Table. */
 void* table_put(HashTable* const table, const void* const key, const void* const value);
+/*
+ * Inserts a mapping into the Table, even if the Table already contains mappings with the same key.
+ *
+ * NOTE: Once a key has several mappings, `table_get`, `table_put`, and `table_remove`
+ *       act on one of them. Use `table_iter_key` and `table_remove_all` to reach every mapping.
+ */
+void table_insert(HashTable* const table, const void* const key, const void* const value);
 /* Removes a key/value pair from the Table and returns true if the removal was successful. */
 bool table_remove(HashTable* const table, const void* const key);
+/* Removes every mapping whose key matches the specified key and returns the number removed. */
+size_t table_remove_all(HashTable* const table, const void* const key);
 /* Changes the Table's capacity to accommodate at least the specified number of mappings. */
 void table_resize(HashTable *const table, const size_t min_size);
+/*
+ * Mixes a seed into the hashes of the Table's keys.
+ *
+ * NOTE: The seed only re-randomizes which bucket each hash is placed in.
+ *       Keys whose Hash results are equal still collide, and stay linear to search
+ *       unless the Table can compare them (see `table_compare`).
+ */
+void table_seed(HashTable* const table, const unsigned int seed);
+/*
+ * Sets the function which orders keys that share a hash, or NULL to remove it.
+ * Compare - Compares two keys. Returns a negative, zero, or positive value based on how they compare.
+ *           Keys must compare as zero exactly when the Equals function considers them equivalent.
+ *
+ * NOTE: With a Compare function, overly long chains become trees ordered by key,
+ *       so looking up a key is O(log(n)) even if every key shares a hash.
+ */
+void table_compare(HashTable* const table, int(*compare)(const void*, const void*));
+/*
+ * Attaches or detaches a BloomFilter of the Table's keys.
+ *
+ * NOTE: While attached, looking up a missing key usually costs one cache line rather than a bucket walk.
+ *       The Filter is kept up to date by insertions and re-built whenever the Table is compacted.
+ */
+void table_filter(HashTable* const table, const bool enabled);
 /* Removes all key/value pairs from the Table while preserving the capacity. */
 void table_clear(HashTable* const table);
 
@@ -89,12 +142,19 @@ void table_destroy(HashTable* const table);
 /*
  * Constructs a new Iterator for the Table.
  *
- * NOTE: There is no guarantee of order among iterated elements.
+ * NOTE: Mappings are iterated in the order in which they were first inserted.
  * NOTE: The Iterator must be de-constructed after its usable life-span.
  * NOTE: During the life-span of the Iterator, DO NOT modify the Table.
  * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
  */
 table_Iterator* table_iter(const HashTable* const table);
+/*
+ * Constructs a new Iterator over only the mappings whose key matches the specified key.
+ *
+ * NOTE: Mappings are iterated in the order in which they were inserted.
+ * NOTE: The same restrictions apply as with `table_iter`.
+ */
+table_Iterator* table_iter_key(const HashTable* const table, const void* const key);
 
 /* Returns the iterator's current key/value pair and advances it forward. */
 void* table_iter_next(table_Iterator* const iter, void **value);
@@ -0,0 +1,75 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       HyperLogLog.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct HyperLogLog HyperLogLog;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new HyperLogLog, which estimates the number of distinct keys in a stream.
+ * Precision - Between 4 and 16. The sketch uses 2^precision bytes, and its
+ *             typical error is 1.04 / sqrt(2^precision), ex. 0.8% at a precision of 14.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ *        May be NULL if the sketch is only ever used through its `_hash` functions.
+ *
+ * Sketches of the same precision and hash function can be merged, so each thread or shard
+ * may count its own part of a stream and combine the results afterwards.
+ *
+ * NOTE: The HyperLogLog must be de-constructed after its usable life-span.
+ */
+HyperLogLog* HyperLogLog_new(const unsigned int precision, unsigned int(*hash)(const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the estimated number of distinct keys which have been added. */
+unsigned long long hll_count(const HyperLogLog* const hll);
+/* Returns the precision of the sketch. */
+unsigned int hll_precision(const HyperLogLog* const hll);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Adds a key to the sketch. */
+void hll_add(HyperLogLog* const hll, const void* const key);
+/* Adds a key of the specified hash to the sketch. */
+void hll_add_hash(HyperLogLog* const hll, const unsigned int hash);
+/* Adds every key which was added to another sketch, as if it had been added to this one. */
+void hll_merge(HyperLogLog* const hll, const HyperLogLog* const other);
+/* Removes every key from the sketch. */
+void hll_clear(HyperLogLog* const hll);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void hll_destroy(HyperLogLog* const hll);
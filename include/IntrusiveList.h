@@ -0,0 +1,130 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       IntrusiveList.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+
+/* Link fields, embedded by the caller inside each element's structure. */
+typedef struct ilist_Link
+{
+    struct ilist_Link *next, *prev;
+} ilist_Link;
+
+/* Returns the structure of the specified type which contains the specified link member. */
+#define ILIST_ENTRY(link, type, member) ((type*)((char*)(link) - offsetof(type, member)))
+
+/* Anonymous structures. */
+typedef struct IntrusiveList IntrusiveList;
+typedef struct ilist_Iterator ilist_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new IntrusiveList.
+ * Offset - Offset of the ilist_Link member within each element, ex. offsetof(Task, link).
+ * Compare - Compares two elements. Returns -1, 0, or 1 based on how they compare.
+ * toString - Returns the String representation of a specified element.
+ *
+ * Elements carry their own links, so the List never allocates or frees memory for them.
+ * An element may only be inside one List per embedded link, and must out-live its membership.
+ * Links must be zero-initialized (or removed from their previous List) before insertion.
+ *
+ * NOTE: The IntrusiveList must be de-constructed after its usable life-span.
+ */
+IntrusiveList* IntrusiveList_new(const size_t offset,
+                                 int(*compare)(const void*, const void*),
+                                 char*(*toString)(const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the element at the front of the List. */
+void* ilist_front(const IntrusiveList* const list);
+/* Returns the element at the back of the List. */
+void* ilist_back(const IntrusiveList* const list);
+/* Returns the element after the specified element, or NULL if it is the back of the List. */
+void* ilist_next(const IntrusiveList* const list, const void* const data);
+/* Returns the element before the specified element, or NULL if it is the front of the List. */
+void* ilist_prev(const IntrusiveList* const list, const void* const data);
+/* Returns the number of elements in the List. */
+size_t ilist_size(const IntrusiveList* const list);
+/* Returns true if the List is empty. */
+bool ilist_empty(const IntrusiveList* const list);
+/* Returns true if the specified link is currently inside of a List. */
+bool ilist_linked(const ilist_Link* const link);
+/* Prints out the contents of the List to the console window. */
+void ilist_print(const IntrusiveList* const list);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Appends an element at the end of the List. */
+void ilist_push_back(IntrusiveList* const list, void* const data);
+/* Inserts an element at the front of the List. */
+void ilist_push_front(IntrusiveList* const list, void* const data);
+/* Inserts an element directly before an element which is already inside the List. */
+void ilist_insert_before(IntrusiveList* const list, void* const position, void* const data);
+/* Removes the specified element from the List. */
+void ilist_remove(IntrusiveList* const list, void* const data);
+/* Removes and returns the element at the end of the List. */
+void* ilist_pop_back(IntrusiveList* const list);
+/* Removes and returns the element at the front of the List. */
+void* ilist_pop_front(IntrusiveList* const list);
+/* Moves every element of another List onto the end of the List. */
+void ilist_splice(IntrusiveList* const list, IntrusiveList* const other);
+/* Removes all elements from the List. */
+void ilist_clear(IntrusiveList* const list);
+/* Sorts the elements inside the List in ascending order. */
+void ilist_sort(IntrusiveList* const list);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+/* NOTE: Elements are unlinked, but never freed. They belong to the caller. */
+void ilist_destroy(IntrusiveList* const list);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator for the List.
+ *
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: During the life-span of the Iterator, only modify the List through the Iterator.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+ilist_Iterator* ilist_iter(IntrusiveList* const list);
+
+/* Returns the iterator's current element and advances it forward. */
+void* ilist_iter_next(ilist_Iterator* const iter);
+/* Returns true if the iterator has a next element. */
+bool ilist_iter_has_next(const ilist_Iterator* const iter);
+/* Removes the last iterated element from the List. */
+void ilist_iter_remove(ilist_Iterator* const iter);
+/* De-constructor function. */
+void ilist_iter_destroy(ilist_Iterator* const iter);
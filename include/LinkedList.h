@@ -31,7 +31,7 @@ SOFTWARE.
 
 #include "../tools/Memory.h"
 #include "../tools/Synchronize.h"
-#include "C-Random/Random.h"
+#include "../tools/Random.h"
 
 /* Anonymous structures. */
 typedef struct LinkedList LinkedList;
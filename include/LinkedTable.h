@@ -0,0 +1,120 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       LinkedTable.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct LinkedTable LinkedTable;
+typedef struct ltable_Iterator ltable_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new LinkedTable, a hash table whose mappings are also kept in a doubly-linked order.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ *        Data used to calculate Hash/Equals should not change while the key is in the Table.
+ * Equals - Returns true if two keys are equivalent.
+ *          Two different keys in the Table may share the same hash result but cannot be equal.
+ * toString - Returns the String representation of a specified key/value pair.
+ * Access Order - If true, mappings are moved to the back of the order whenever they are read
+ *                or replaced (least-recently used first). Otherwise, the order is insertion order.
+ *
+ * NOTE: The Hash and Equals functions MUST be defined.
+ * NOTE: The Table must be de-constructed after its usable life-span.
+ */
+LinkedTable* LinkedTable_new(unsigned int(*hash)(const void*),
+                             bool(*equals)(const void*, const void*),
+                             char*(*toString)(const void*, const void*),
+                             const bool access_order);
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the value of a mapping whose key matches the specified key, re-ordering it in access order. */
+void* ltable_get(LinkedTable* const table, const void* const key);
+/* Returns the value of a mapping whose key matches the specified key, without re-ordering it. */
+void* ltable_peek(const LinkedTable* const table, const void* const key);
+/* Returns the key of the first mapping in order, storing its value into `value` if non-NULL. */
+void* ltable_front(const LinkedTable* const table, void** const value);
+/* Returns the key of the last mapping in order, storing its value into `value` if non-NULL. */
+void* ltable_back(const LinkedTable* const table, void** const value);
+/* Returns the number of mappings in the Table. */
+size_t ltable_size(const LinkedTable* const table);
+/* Returns true if the Table is empty. */
+bool ltable_empty(const LinkedTable* const table);
+/* Returns true if the Table contains a mapping with the specified key. */
+bool ltable_contains(const LinkedTable* const table, const void* const key);
+/* Prints out the contents of the Table to the console window. */
+void ltable_print(const LinkedTable* const table);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Inserts a mapping into the Table. */
+void* ltable_put(LinkedTable* const table, const void* const key, const void* const value);
+/* Removes a key/value pair from the Table and returns true if the removal was successful. */
+bool ltable_remove(LinkedTable* const table, const void* const key);
+/* Removes the first mapping in order, returning its key and storing its value into `value` if non-NULL. */
+void* ltable_pop_front(LinkedTable* const table, void** const value);
+/* Removes the last mapping in order, returning its key and storing its value into `value` if non-NULL. */
+void* ltable_pop_back(LinkedTable* const table, void** const value);
+/* Moves a mapping to the front of the order and returns true if the mapping exists. */
+bool ltable_move_front(LinkedTable* const table, const void* const key);
+/* Moves a mapping to the back of the order and returns true if the mapping exists. */
+bool ltable_move_back(LinkedTable* const table, const void* const key);
+/* Changes the Table's capacity to accommodate at least the specified number of mappings. */
+void ltable_resize(LinkedTable* const table, const size_t min_size);
+/* Removes all key/value pairs from the Table while preserving the capacity. */
+void ltable_clear(LinkedTable* const table);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void ltable_destroy(LinkedTable* const table);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator for the Table.
+ * Reverse - If true, mappings are iterated from the back of the order to the front.
+ *
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: During the life-span of the Iterator, DO NOT modify the Table.
+ *       In access order, this includes reading the Table through `ltable_get`.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+ltable_Iterator* ltable_iter(const LinkedTable* const table, const bool reverse);
+
+/* Returns the iterator's current key/value pair and advances it forward. */
+void* ltable_iter_next(ltable_Iterator* const iter, void** const value);
+/* Returns true if the iterator has a next key/value pair. */
+bool ltable_iter_has_next(const ltable_Iterator* const iter);
+/* De-constructor function. */
+void ltable_iter_destroy(ltable_Iterator* const iter);
@@ -0,0 +1,101 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       PackedVector.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct PackedVector PackedVector;
+typedef struct pvect_Iterator pvect_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new PackedVector, a compressed sequence of unsigned integers.
+ *
+ * Integers are stored by value rather than as pointers, and compressed in blocks of 128.
+ * Each block stores its integers in as few bits as the block's range or gaps require, so sorted
+ * lists of IDs and integers of small range shrink to a fraction of their uncompressed size.
+ * Integers remain randomly accessible, though sequential access through `pvect_copy` or the
+ * Iterator is much faster, decoding a whole block at a time.
+ *
+ * NOTE: The Vector must be de-constructed after its usable life-span.
+ */
+PackedVector* PackedVector_new();
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the integer at the specified index. */
+unsigned int pvect_at(const PackedVector* const vect, const size_t index);
+/* Copies `count` integers starting from the specified index into `out`. */
+void pvect_copy(const PackedVector* const vect, const size_t index, const size_t count, unsigned int* const out);
+/* Returns the number of integers in the Vector. */
+size_t pvect_size(const PackedVector* const vect);
+/* Returns true if the Vector is empty. */
+bool pvect_empty(const PackedVector* const vect);
+/* Returns the number of bytes which the Vector's integers occupy. */
+size_t pvect_bytes(const PackedVector* const vect);
+/* Prints out the contents of the Vector to the console window. */
+void pvect_print(const PackedVector* const vect);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Inserts an integer at the back of the Vector. */
+void pvect_push_back(PackedVector* const vect, const unsigned int value);
+/* Inserts `count` integers at the back of the Vector. */
+void pvect_append(PackedVector* const vect, const unsigned int* const values, const size_t count);
+/* Removes the integer at the back of the Vector and returns it. */
+unsigned int pvect_pop_back(PackedVector* const vect);
+/* Removes all integers from the Vector. */
+void pvect_clear(PackedVector* const vect);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void pvect_destroy(PackedVector* const vect);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator, starting from the specified index.
+ *
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: During the life-span of the Iterator, DO NOT modify the Vector.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+pvect_Iterator* pvect_iter(const PackedVector* const vect, const size_t index);
+
+/* Returns the iterator's current integer and advances it forward. */
+unsigned int pvect_iter_next(pvect_Iterator* const iter);
+/* Returns true if the iterator has a next integer. */
+bool pvect_iter_has_next(const pvect_Iterator* const iter);
+/* De-constructor function. */
+void pvect_iter_destroy(pvect_Iterator* const iter);
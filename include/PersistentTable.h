@@ -0,0 +1,112 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       PersistentTable.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct PersistentTable PersistentTable;
+typedef struct ptable_Iterator ptable_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new PersistentTable.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ *        Data used to calculate Hash/Equals should not change while the key is in the Table.
+ * Equals - Returns true if two keys are equivalent.
+ *          Two different keys in the Table may share the same hash result but cannot be equal.
+ * toString - Returns the String representation of a specified key/value pair.
+ *
+ * Clones share their structure with the Table they were cloned from, so cloning takes constant time.
+ * Updates only copy the parts of the structure which are shared with a clone.
+ * Parts which are not shared are updated in place, so building a Table before cloning it
+ * is as fast as building it in a single batch.
+ *
+ * NOTE: The Hash and Equals functions MUST be defined.
+ * NOTE: The Table must be de-constructed after its usable life-span.
+ */
+PersistentTable* PersistentTable_new(unsigned int(*hash)(const void*),
+                                     bool(*equals)(const void*, const void*),
+                                     char*(*toString)(const void*, const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the value of a mapping whose key matches the specified key. */
+void* ptable_get(const PersistentTable* const table, const void* const key);
+/* Returns the number of mappings in the Table. */
+size_t ptable_size(const PersistentTable* const table);
+/* Returns true if the Table is empty. */
+bool ptable_empty(const PersistentTable* const table);
+/* Returns true if the Table contains a mapping with the specified key. */
+bool ptable_contains(const PersistentTable* const table, const void* const key);
+/* Prints out the contents of the Table to the console window. */
+void ptable_print(const PersistentTable* const table);
+/*
+ * Returns a shallow copy of the Table.
+ *
+ * NOTE: The copy and the Table can be modified independently of one another.
+ */
+PersistentTable* ptable_clone(const PersistentTable* const table);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Inserts a mapping into the Table. */
+void* ptable_put(PersistentTable* const table, const void* const key, const void* const value);
+/* Removes a mapping from the Table whose key matches the specified key. */
+void* ptable_remove(PersistentTable* const table, const void* const key);
+/* Removes all mappings from the Table. */
+void ptable_clear(PersistentTable* const table);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void ptable_destroy(PersistentTable* const table);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator for the Table.
+ * The Iterator iterates over a snapshot of the Table taken when it was constructed.
+ *
+ * NOTE: There is no guarantee of order among iterated elements.
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: The Table may be modified during the life-span of the Iterator.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+ptable_Iterator* ptable_iter(const PersistentTable* const table);
+
+/* Returns the iterator's current key/value pair and advances it forward. */
+void* ptable_iter_next(ptable_Iterator* const iter, void **value);
+/* Returns true if the iterator has a next key/value pair. */
+bool ptable_iter_has_next(const ptable_Iterator* const iter);
+/* De-constructor function. */
+void ptable_iter_destroy(ptable_Iterator* const iter);
@@ -0,0 +1,106 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       RadixTree.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct RadixTree RadixTree;
+typedef struct radix_Iterator radix_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new RadixTree, an ordered map whose keys are strings of bytes.
+ * toString - Returns the String representation of a specified key/value pair.
+ *
+ * Keys are ordered byte-wise, with a key ordered before every longer key which it is a prefix of.
+ * Looking up a key costs time proportional to its length rather than to the size of the Tree.
+ * Keys may contain any bytes, so the length of each key must be specified.
+ * To use C strings as keys, pass their `strlen`.
+ *
+ * NOTE: Keys are referenced rather than copied. They must not change while they are in the Tree.
+ * NOTE: The Tree must be de-constructed after its usable life-span.
+ */
+RadixTree* RadixTree_new(char*(*toString)(const void*, const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the value of a mapping whose key matches the specified key. */
+void* radix_get(const RadixTree* const tree, const void* const key, const size_t length);
+/* Returns true if the Tree contains a mapping with the specified key. */
+bool radix_contains(const RadixTree* const tree, const void* const key, const size_t length);
+/* Returns the number of mappings in the Tree. */
+size_t radix_size(const RadixTree* const tree);
+/* Returns true if the Tree is empty. */
+bool radix_empty(const RadixTree* const tree);
+/* Prints out the contents of the Tree to the console window. */
+void radix_print(const RadixTree* const tree);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Inserts a mapping into the Tree. */
+void* radix_put(RadixTree* const tree, const void* const key, const size_t length, const void* const value);
+/* Removes a mapping from the Tree whose key matches the specified key. */
+void* radix_remove(RadixTree* const tree, const void* const key, const size_t length);
+/* Removes all mappings from the Tree. */
+void radix_clear(RadixTree* const tree);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void radix_destroy(RadixTree* const tree);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator over every mapping of the Tree, in key order.
+ *
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: During the life-span of the Iterator, DO NOT modify the Tree.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+radix_Iterator* radix_iter(const RadixTree* const tree);
+/* Constructs a new Iterator over the mappings whose keys start with the specified prefix, in key order. */
+radix_Iterator* radix_iter_prefix(const RadixTree* const tree, const void* const prefix, const size_t length);
+/*
+ * Constructs a new Iterator over the mappings whose keys are at least `low` and less than `high`, in key order.
+ * Either bound may be NULL, leaving that end of the range open.
+ */
+radix_Iterator* radix_iter_range(const RadixTree* const tree, const void* const low, const size_t low_length,
+                                 const void* const high, const size_t high_length);
+
+/* Returns the iterator's current key, its length, and its value, then advances the iterator forward. */
+void* radix_iter_next(radix_Iterator* const iter, size_t* const length, void** const value);
+/* Returns true if the iterator has a next key/value pair. */
+bool radix_iter_has_next(const radix_Iterator* const iter);
+/* De-constructor function. */
+void radix_iter_destroy(radix_Iterator* const iter);
@@ -0,0 +1,107 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       ReplicatedTable.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "HashTable.h"
+
+/* Anonymous structures. */
+typedef struct ReplicatedTable ReplicatedTable;
+typedef struct rtable_Iterator rtable_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new ReplicatedTable.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ *        Data used to calculate Hash/Equals should not change while the key is in the Table.
+ * Equals - Returns true if two keys are equivalent.
+ *          Two different keys in the Table may share the same hash result but cannot be equal.
+ * toString - Returns the String representation of a specified key/value pair.
+ *
+ * The Table keeps one HashTable replica per NUMA node. Writers append their operations to a shared log,
+ * and each replica applies the log when it is next used on its node, so readers only touch local memory.
+ * Every operation takes effect at a single point in time, as if there were only one HashTable.
+ *
+ * NOTE: The Hash and Equals functions MUST be defined.
+ * NOTE: The Table must be de-constructed after its usable life-span.
+ */
+ReplicatedTable* ReplicatedTable_new(unsigned int(*hash)(const void*),
+                                     bool(*equals)(const void*, const void*),
+                                     char*(*toString)(const void*, const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the value of a mapping whose key matches the specified key. */
+void* rtable_get(const ReplicatedTable* const table, const void* const key);
+/* Returns the number of mappings in the Table. */
+size_t rtable_size(const ReplicatedTable* const table);
+/* Returns true if the Table is empty. */
+bool rtable_empty(const ReplicatedTable* const table);
+/* Returns true if the Table contains a mapping with the specified key. */
+bool rtable_contains(const ReplicatedTable* const table, const void* const key);
+/* Prints out the contents of the Table to the console window. */
+void rtable_print(const ReplicatedTable* const table);
+/* Returns a shallow copy of the Table. */
+ReplicatedTable* rtable_clone(const ReplicatedTable* const table);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Inserts a mapping into the Table. */
+void* rtable_put(ReplicatedTable* const table, const void* const key, const void* const value);
+/* Removes a mapping from the Table whose key matches the specified key. */
+void* rtable_remove(ReplicatedTable* const table, const void* const key);
+/* Removes all mappings from the Table. */
+void rtable_clear(ReplicatedTable* const table);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void rtable_destroy(ReplicatedTable* const table);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator for the Table.
+ * The Iterator iterates over a snapshot of the Table taken when it was constructed.
+ *
+ * NOTE: Mappings are iterated in the order in which they were first inserted.
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: The Table may be modified during the life-span of the Iterator.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+rtable_Iterator* rtable_iter(const ReplicatedTable* const table);
+
+/* Returns the iterator's current key/value pair and advances it forward. */
+void* rtable_iter_next(rtable_Iterator* const iter, void **value);
+/* Returns true if the iterator has a next key/value pair. */
+bool rtable_iter_has_next(const rtable_Iterator* const iter);
+/* De-constructor function. */
+void rtable_iter_destroy(rtable_Iterator* const iter);
@@ -0,0 +1,76 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       Reservoir.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Random.h"
+#include "Vector.h"
+
+/* Anonymous structures. */
+typedef struct Reservoir Reservoir;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new Reservoir, which keeps a uniform random sample of a stream of elements.
+ * Capacity - Number of elements in the sample.
+ * toString - Returns the String representation of a specified element.
+ *
+ * Offer each element of a container, in any order, then read the sample.
+ * Every element offered so far is equally likely to be in the sample.
+ *
+ * NOTE: The Reservoir must be de-constructed after its usable life-span.
+ */
+Reservoir* Reservoir_new(const unsigned int capacity, char*(*toString)(const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the sampled element at the specified index. */
+void* res_at(const Reservoir* const res, const unsigned int index);
+/* Returns the number of elements in the sample. */
+size_t res_size(const Reservoir* const res);
+/* Returns the number of elements which have been offered to the Reservoir. */
+unsigned long long res_offered(const Reservoir* const res);
+/* Prints out the contents of the sample to the console window. */
+void res_print(const Reservoir* const res);
+/* Returns a new Vector containing the sample. */
+Vector* res_vector(const Reservoir* const res);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Offers an element of the stream to the Reservoir. */
+void res_offer(Reservoir* const res, const void* const data);
+/* Empties the sample and forgets every offered element. */
+void res_clear(Reservoir* const res);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void res_destroy(Reservoir* const res);
@@ -0,0 +1,112 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       RoaringBitmap.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct RoaringBitmap RoaringBitmap;
+typedef struct roar_Iterator roar_Iterator;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new RoaringBitmap, a compressed set of 32-bit unsigned integers.
+ *
+ * The integers are split into chunks of 65536 by their upper 16 bits. Each chunk is stored as
+ * whichever is smallest of a sorted array, a bitmap, or a list of runs, so both sparse and dense sets
+ * take little memory. Unions, intersections and differences operate on whole chunks at a time.
+ *
+ * NOTE: The bitmap must be de-constructed after its usable life-span.
+ */
+RoaringBitmap* RoaringBitmap_new();
+/*
+ * Constructs a new RoaringBitmap from the output of `roar_serialize`.
+ * Returns NULL if the buffer does not hold a valid serialized bitmap.
+ *
+ * NOTE: The bitmap must be de-constructed after its usable life-span.
+ */
+RoaringBitmap* RoaringBitmap_deserialize(const void* const buffer, const size_t length);
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns true if the bitmap contains the specified integer. */
+bool roar_contains(const RoaringBitmap* const bitmap, const unsigned int value);
+/* Returns the number of integers in the bitmap. */
+size_t roar_cardinality(const RoaringBitmap* const bitmap);
+/* Returns true if the bitmap is empty. */
+bool roar_empty(const RoaringBitmap* const bitmap);
+/* Prints out the contents of the bitmap to the console window. */
+void roar_print(const RoaringBitmap* const bitmap);
+/* Returns a new bitmap of the integers which are in either bitmap. */
+RoaringBitmap* roar_union(const RoaringBitmap* const bitmap, const RoaringBitmap* const other);
+/* Returns a new bitmap of the integers which are in both bitmaps. */
+RoaringBitmap* roar_intersection(const RoaringBitmap* const bitmap, const RoaringBitmap* const other);
+/* Returns a new bitmap of the integers which are in the first bitmap but not the second. */
+RoaringBitmap* roar_difference(const RoaringBitmap* const bitmap, const RoaringBitmap* const other);
+/* Returns the number of bytes which `roar_serialize` will write. */
+size_t roar_serialized_size(const RoaringBitmap* const bitmap);
+/* Writes the bitmap into the buffer in a portable format. Returns the number of bytes written. */
+size_t roar_serialize(const RoaringBitmap* const bitmap, void* const buffer);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Inserts an integer into the bitmap. Returns true if it was not already present. */
+bool roar_add(RoaringBitmap* const bitmap, const unsigned int value);
+/* Removes an integer from the bitmap. Returns true if it was present. */
+bool roar_remove(RoaringBitmap* const bitmap, const unsigned int value);
+/* Converts each chunk into runs where that is smaller, and back out of runs where it is not. */
+void roar_optimize(RoaringBitmap* const bitmap);
+/* Removes all integers from the bitmap. */
+void roar_clear(RoaringBitmap* const bitmap);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void roar_destroy(RoaringBitmap* const bitmap);
+
+/* ~~~~~ Iterator ~~~~~ */
+
+/*
+ * Constructs a new Iterator over the integers of the bitmap, in ascending order.
+ *
+ * NOTE: The Iterator must be de-constructed after its usable life-span.
+ * NOTE: During the life-span of the Iterator, DO NOT modify the bitmap.
+ * NOTE: The Iterator is NOT thread-safe. Do not share the Iterator across threads.
+ */
+roar_Iterator* roar_iter(const RoaringBitmap* const bitmap);
+
+/* Returns the iterator's current integer and advances it forward. */
+unsigned int roar_iter_next(roar_Iterator* const iter);
+/* Returns true if the iterator has a next integer. */
+bool roar_iter_has_next(const roar_Iterator* const iter);
+/* De-constructor function. */
+void roar_iter_destroy(roar_Iterator* const iter);
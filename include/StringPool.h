@@ -0,0 +1,84 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       StringPool.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "../tools/Math.h"
+
+/* Anonymous structures. */
+typedef struct StringPool StringPool;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new StringPool, which interns strings.
+ * shards - Number of independently locked partitions, rounded up to a power of two.
+ *
+ * Interning a string returns the pool's own copy of it, the same copy every time for equal strings.
+ * Interned strings can therefore be compared for equality by comparing their pointers.
+ * Each interned string also has an ID, which can be mapped back to the string.
+ * With one shard, IDs are handed out densely from zero in the order that strings are interned.
+ * With more shards, concurrent interning contends less, though IDs are no longer dense.
+ *
+ * NOTE: Interned strings and IDs remain valid until the pool is cleared or de-constructed.
+ * NOTE: The pool must be de-constructed after its usable life-span.
+ */
+StringPool* StringPool_new(const unsigned int shards);
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the interned copy of the specified string, or NULL if it has not been interned. */
+const char* pool_find(const StringPool* const pool, const char* const string);
+/* Returns the interned string of the specified ID. */
+const char* pool_string(const StringPool* const pool, const unsigned int id);
+/* Returns the ID of an interned string. */
+unsigned int pool_id(const char* const interned);
+/* Returns the length of an interned string. */
+size_t pool_length(const char* const interned);
+/* Returns the number of strings in the pool. */
+size_t pool_size(const StringPool* const pool);
+/* Returns the number of bytes which the pool's strings occupy. */
+size_t pool_bytes(const StringPool* const pool);
+/* Prints out the contents of the pool to the console window. */
+void pool_print(const StringPool* const pool);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Returns the interned copy of the specified string, interning it if necessary. */
+const char* pool_intern(StringPool* const pool, const char* const string);
+/* Returns the interned copy of the specified characters, interning them if necessary. */
+const char* pool_intern_slice(StringPool* const pool, const char* const string, const size_t length);
+/* Removes all strings from the pool. */
+void pool_clear(StringPool* const pool);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void pool_destroy(StringPool* const pool);
@@ -0,0 +1,79 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       TopK.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "../tools/Memory.h"
+#include "../tools/Synchronize.h"
+#include "CountMinSketch.h"
+#include "Vector.h"
+
+/* Anonymous structures. */
+typedef struct TopK TopK;
+
+/* ~~~~~ Constructors ~~~~~ */
+
+/*
+ * Constructs a new TopK, which tracks the most frequently added keys of a stream in fixed memory.
+ * K - Number of keys to track.
+ * Width, Depth - Dimensions of the CountMinSketch which estimates each key's count.
+ * Hash - Returns a (preferably) unique and large integer value from a specified key.
+ * Equals - Returns true if two keys are equivalent.
+ *
+ * Sketches of the same dimensions and hash function can be merged, so each thread or shard
+ * may count its own part of a stream and combine the results afterwards.
+ *
+ * NOTE: The Hash and Equals functions MUST be defined.
+ * NOTE: Tracked keys are referenced rather than copied, so they must out-live the TopK.
+ * NOTE: The TopK must be de-constructed after its usable life-span.
+ */
+TopK* TopK_new(const unsigned int k, const size_t width, const unsigned int depth,
+               unsigned int(*hash)(const void*), bool(*equals)(const void*, const void*));
+
+/* ~~~~~ Accessors ~~~~~ */
+
+/* Returns the estimated number of times the specified key was added. */
+unsigned long long topk_estimate(const TopK* const topk, const void* const key);
+/* Returns the number of keys currently tracked. */
+size_t topk_size(const TopK* const topk);
+/* Returns a new Vector of the tracked keys, from the most to the least frequently added. */
+Vector* topk_list(const TopK* const topk);
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/* Adds a key to the TopK the specified number of times. */
+void topk_add(TopK* const topk, const void* const key, const unsigned long long count);
+/* Adds every count which was added to another TopK, as if it had been added to this one. */
+void topk_merge(TopK* const topk, const TopK* const other);
+/* Removes every count and tracked key from the TopK. */
+void topk_clear(TopK* const topk);
+
+/* ~~~~~ De-constructors ~~~~~ */
+
+void topk_destroy(TopK* const topk);
@@ -32,12 +32,45 @@ SOFTWARE.
 #include "../tools/Memory.h"
 #include "../tools/Math.h"
 #include "../tools/Synchronize.h"
-#include "C-Random/Random.h"
+#include "../tools/Random.h"
 
 /* Anonymous structures. */
 typedef struct Vector Vector;
 typedef struct vect_Iterator vect_Iterator;
 
+/* Contiguous run of elements inside the Vector's storage. */
+typedef struct vect_Segment
+{
+    const void* const* data;
+    size_t length;
+} vect_Segment;
+
+/* Range of elements inside the Vector, referenced without copying. Unused segments have a length of zero. */
+typedef struct vect_View
+{
+    vect_Segment segments[2];
+    size_t size;
+} vect_View;
+
+/* Leading members of the Vector, exposed so that the unchecked accessors below can be inlined. */
+typedef struct vect_Layout
+{
+    const void** table;
+    unsigned int start, end;
+    size_t size, capacity;
+} vect_Layout;
+
+/*
+ * Unchecked accessors, which compile down to a load and a mask.
+ * They neither lock the Vector nor check the index, so the caller must guarantee both.
+ */
+#define VECT_LAYOUT(vect) ((const vect_Layout*)(vect))
+#define VECT_SIZE(vect) (VECT_LAYOUT(vect)->size)
+#define VECT_AT(vect, index) \
+    ((void*)VECT_LAYOUT(vect)->table[(VECT_LAYOUT(vect)->start + (index)) & (VECT_LAYOUT(vect)->capacity - 1)])
+#define VECT_FRONT(vect) ((void*)VECT_LAYOUT(vect)->table[VECT_LAYOUT(vect)->start])
+#define VECT_BACK(vect) ((void*)VECT_LAYOUT(vect)->table[VECT_LAYOUT(vect)->end])
+
 /* ~~~~~ Constructors ~~~~~ */
 
 /*
@@ -70,6 +103,17 @@ bool vect_contains(const Vector* const vect, const void* const data);
 void vect_print(const Vector* const vect);
 /* Returns a shallow copy of the Vector. */
 Vector* vect_clone(const Vector* const vect);
+/*
+ * Returns a View of the specified number of elements, starting at the specified index.
+ * The elements are exposed as one or two contiguous segments of the Vector's storage.
+ *
+ * NOTE: Any modification of the Vector invalidates the View. Clone the Vector to keep the View valid.
+ */
+vect_View vect_view(const Vector* const vect, const unsigned int index, const size_t length);
+/* Returns a new Vector of the specified number of elements, chosen at random without replacement. */
+Vector* vect_sample(const Vector* const vect, const unsigned int count);
+/* Returns the element at the specified index of the View. */
+void* vect_view_at(const vect_View* const view, const size_t index);
 
 /* ~~~~~ Mutators ~~~~~ */
 
@@ -99,6 +143,18 @@ void vect_clear(Vector* const vect);
 void vect_sort(const Vector* const vect);
 /* Shuffles the elements inside the Vector pseudo-randomly. */
 void vect_shuffle(const Vector* const vect);
+/*
+ * Shuffles the elements inside the Vector pseudo-randomly, using up to the specified number of threads.
+ *
+ * NOTE: Each thread draws from its own generator, so seeding does not make the result reproducible.
+ */
+void vect_shuffle_parallel(Vector* const vect, const unsigned int threads);
+/*
+ * Sets whether the Vector grows by read-copy-update, letting its accessors read without waiting on growth.
+ *
+ * NOTE: Do not change this setting while other threads are using the Vector.
+ */
+void vect_rcu(Vector* const vect, const bool enabled);
 
 /* ~~~~~ De-constructors ~~~~~ */
 
@@ -0,0 +1,143 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       AliasSampler.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/AliasSampler.h"
+
+/*
+ * Alias method:
+ * Each index owns a column of equal height. An index whose weight falls short of the column height shares
+ * its column with one alias, whose weight fills the rest. A draw picks a column, then one of its two indexes.
+ * Columns are built with Vose's algorithm. For details, see: Vose, "A Linear Algorithm For Generating
+ * Random Numbers With a Given Distribution".
+ */
+
+/* AliasSampler structure. */
+struct AliasSampler
+{
+    /* Chance that a column chooses its own index rather than its alias. */
+    double *chance;
+    unsigned int *alias;
+    size_t size;
+};
+
+/*
+ * Constructor function.
+ * Θ(n)
+ */
+AliasSampler* AliasSampler_new(const Vector* const weights, double(*weight)(const void*))
+{
+    io_assert(weights != NULL, IO_MSG_NULL_PTR);
+    io_assert(weight != NULL, IO_MSG_NOT_SUPPORTED);
+
+    const size_t size = vect_size(weights);
+    io_assert(size > 0, IO_MSG_EMPTY);
+
+    AliasSampler* const sampler = mem_calloc(1, sizeof(AliasSampler));
+    sampler->chance = mem_malloc(size * sizeof(double));
+    sampler->alias = mem_malloc(size * sizeof(unsigned int));
+    sampler->size = size;
+
+    double total = 0;
+    for (unsigned int i = 0; i < size; i++)
+    {
+        sampler->chance[i] = weight(vect_at(weights, i));
+        io_assert(sampler->chance[i] >= 0, IO_MSG_INVALID_SIZE);
+        total += sampler->chance[i];
+    }
+    io_assert(total > 0, IO_MSG_INVALID_SIZE);
+
+    /* Scale the weights so that a full column has a height of 1, then sort the columns into short and tall. */
+    unsigned int* const columns = mem_malloc(size * sizeof(unsigned int));
+    size_t short_count = 0, tall_start = size;
+    for (unsigned int i = 0; i < size; i++)
+    {
+        sampler->chance[i] *= size / total;
+        sampler->alias[i] = i;
+        if (sampler->chance[i] < 1)
+            columns[short_count++] = i;
+        else columns[--tall_start] = i;
+    }
+
+    /* Top up each short column with part of a tall one. The tall column may become short itself. */
+    while (short_count > 0 && tall_start < size)
+    {
+        const unsigned int low = columns[--short_count], high = columns[tall_start];
+        sampler->alias[low] = high;
+        sampler->chance[high] -= 1 - sampler->chance[low];
+        if (sampler->chance[high] < 1)
+        {
+            tall_start++;
+            columns[short_count++] = high;
+        }
+    }
+
+    /* Columns left over are full, apart from rounding error. */
+    while (short_count > 0)
+        sampler->chance[columns[--short_count]] = 1;
+    while (tall_start < size)
+        sampler->chance[columns[tall_start++]] = 1;
+
+    mem_free(columns, size * sizeof(unsigned int));
+    return sampler;
+}
+
+/*
+ * Returns a random index, chosen with probability proportional to its weight.
+ * Θ(1)
+ */
+unsigned int alias_next(const AliasSampler* const sampler)
+{
+    io_assert(sampler != NULL, IO_MSG_NULL_PTR);
+
+    const unsigned int column = rand_limit((unsigned int)sampler->size);
+    return rand_unit() < sampler->chance[column] ? column : sampler->alias[column];
+}
+
+/*
+ * Returns the number of indexes which the Sampler chooses from.
+ * Θ(1)
+ */
+size_t alias_size(const AliasSampler* const sampler)
+{
+    io_assert(sampler != NULL, IO_MSG_NULL_PTR);
+    return sampler->size;
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void alias_destroy(AliasSampler* const sampler)
+{
+    io_assert(sampler != NULL, IO_MSG_NULL_PTR);
+
+    mem_free(sampler->chance, sampler->size * sizeof(double));
+    mem_free(sampler->alias, sampler->size * sizeof(unsigned int));
+    mem_free(sampler, sizeof(AliasSampler));
+}
@@ -0,0 +1,253 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       BloomFilter.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/BloomFilter.h"
+#include <string.h>
+
+/* Bits of the Filter set aside for each key of its capacity. */
+#define BITS_PER_KEY 12
+/* Each block is 256 bits, which is half of a cache line. */
+#define BLOCK_WORDS 4
+#define BLOCK_BITS (BLOCK_WORDS * 64)
+#define BLOCK_SIZE (BLOCK_WORDS * sizeof(sync_Word))
+/* Number of bits which each key sets within its block. */
+#define LANES 8
+/* Keys hashed ahead of their probes during a batch query. */
+#define BATCH 16
+
+/*
+ * Split blocks:
+ * Every key maps to a single block and sets one bit in each 32-bit half of the block's words.
+ * A query therefore touches one aligned block, which never straddles a cache line, and the eight
+ * bit positions are independent multiplications which the compiler is free to vectorize.
+ * Bits are set with atomic OR, so the Filter can be read and added to without a lock.
+ * For details, see: Putze, Sanders, Singler, "Cache-, Hash- and Space-Efficient Bloom Filters".
+ */
+
+/* Odd constants which pick each lane's bit from the key's hash. */
+static const unsigned int SALT[LANES] =
+{
+    0x47B6137BU, 0x44974D91U, 0x8824AD5BU, 0xA2B7289DU,
+    0x705495C7U, 0x2DF1424BU, 0x9EFC4947U, 0x5C6BFB31U
+};
+
+/* BloomFilter structure. */
+struct BloomFilter
+{
+    /* Blocks, aligned to their size within the allocation. */
+    sync_Word *blocks;
+    void *allocation;
+    size_t block_count, capacity;
+
+    /* Function pointers. */
+    unsigned int(*hash)(const void*);
+};
+
+/* Local functions. */
+static const sync_Word* bloom_block(const BloomFilter* const filter, const unsigned int hash);
+static void bloom_masks(const unsigned int hash, unsigned long long* const masks);
+static bool bloom_probe(const sync_Word* const block, const unsigned int hash);
+
+/*
+ * Constructor function.
+ * Θ(c), where c is the capacity
+ */
+BloomFilter* BloomFilter_new(const size_t capacity, unsigned int(*hash)(const void*))
+{
+    io_assert(capacity > 0, IO_MSG_INVALID_SIZE);
+
+    BloomFilter* const filter = mem_calloc(1, sizeof(BloomFilter));
+    filter->block_count = (capacity * BITS_PER_KEY + BLOCK_BITS - 1) / BLOCK_BITS;
+    filter->capacity = capacity;
+    filter->hash = hash;
+
+    /* Over-allocate by one block so that the blocks can be aligned. */
+    filter->allocation = mem_calloc(filter->block_count + 1, BLOCK_SIZE);
+    const size_t address = (size_t)filter->allocation;
+    filter->blocks = (sync_Word*)((address + BLOCK_SIZE - 1) & ~(BLOCK_SIZE - 1));
+    return filter;
+}
+
+/*
+ * Returns false if the specified key was definitely never added to the Filter.
+ * The `hash` function must be defined to call this function.
+ * Θ(1)
+ */
+bool bloom_contains(const BloomFilter* const filter, const void* const key)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(filter->hash != NULL, IO_MSG_NOT_SUPPORTED);
+    return bloom_contains_hash(filter, filter->hash(key));
+}
+
+/*
+ * Returns false if a key of the specified hash was definitely never added to the Filter.
+ * Θ(1)
+ */
+bool bloom_contains_hash(const BloomFilter* const filter, const unsigned int hash)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    return bloom_probe(bloom_block(filter, hash), hash);
+}
+
+/*
+ * Queries several keys at once, storing each answer into the matching index of `results`.
+ * Keys are hashed in groups before any block is probed, so that the cache misses of the
+ * group's probes are independent of one another and can be overlapped by the processor.
+ * The `hash` function must be defined to call this function.
+ * Θ(n)
+ */
+void bloom_contains_batch(const BloomFilter* const filter, const void* const* const keys,
+                          const size_t count, bool* const results)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    io_assert(keys != NULL, IO_MSG_NULL_PTR);
+    io_assert(results != NULL, IO_MSG_NULL_PTR);
+    io_assert(filter->hash != NULL, IO_MSG_NOT_SUPPORTED);
+
+    unsigned int hashes[BATCH];
+    const sync_Word* blocks[BATCH];
+
+    for (size_t start = 0; start < count; start += BATCH)
+    {
+        const size_t length = count - start < BATCH ? count - start : BATCH;
+        for (size_t i = 0; i < length; i++)
+        {
+            io_assert(keys[start + i] != NULL, IO_MSG_NULL_PTR);
+            hashes[i] = filter->hash(keys[start + i]);
+            blocks[i] = bloom_block(filter, hashes[i]);
+        }
+        for (size_t i = 0; i < length; i++)
+            results[start + i] = bloom_probe(blocks[i], hashes[i]);
+    }
+}
+
+/*
+ * Returns the number of keys the Filter is sized for.
+ * Θ(1)
+ */
+size_t bloom_capacity(const BloomFilter* const filter)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    return filter->capacity;
+}
+
+/*
+ * Adds a key to the Filter.
+ * The `hash` function must be defined to call this function.
+ * Θ(1)
+ */
+void bloom_add(BloomFilter* const filter, const void* const key)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(filter->hash != NULL, IO_MSG_NOT_SUPPORTED);
+    bloom_add_hash(filter, filter->hash(key));
+}
+
+/*
+ * Adds a key of the specified hash to the Filter.
+ * Θ(1)
+ */
+void bloom_add_hash(BloomFilter* const filter, const unsigned int hash)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+
+    sync_Word* const block = (sync_Word*)bloom_block(filter, hash);
+    unsigned long long masks[BLOCK_WORDS];
+    bloom_masks(hash, masks);
+
+    for (size_t i = 0; i < BLOCK_WORDS; i++)
+        /* Skip the atomic operation if the bits are already set, as they often are. */
+        if (((unsigned long long)block[i] & masks[i]) != masks[i])
+            sync_fetch_or(&block[i], (LONG64)masks[i]);
+}
+
+/*
+ * Removes every key from the Filter.
+ *
+ * NOTE: Must not be called while other threads use the Filter.
+ * Θ(c), where c is the capacity
+ */
+void bloom_clear(BloomFilter* const filter)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    memset((void*)filter->blocks, 0, filter->block_count * BLOCK_SIZE);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void bloom_destroy(BloomFilter* const filter)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    mem_free(filter->allocation, (filter->block_count + 1) * BLOCK_SIZE);
+    mem_free(filter, sizeof(BloomFilter));
+}
+
+/*
+ * Returns the block which a key of the specified hash maps to.
+ * The hash is spread over 64 bits, whose upper half picks the block while the lower half picks the bits.
+ * Θ(1)
+ */
+static const sync_Word* bloom_block(const BloomFilter* const filter, const unsigned int hash)
+{
+    const unsigned int spread = (unsigned int)(((unsigned long long)hash * 0x9E3779B97F4A7C15ULL) >> 32);
+    return filter->blocks + MATH_FASTRANGE(spread, filter->block_count) * BLOCK_WORDS;
+}
+
+/*
+ * Computes the bits which a key of the specified hash sets in each word of its block.
+ * Θ(1)
+ */
+static void bloom_masks(const unsigned int hash, unsigned long long* const masks)
+{
+    for (size_t i = 0; i < BLOCK_WORDS; i++)
+        masks[i] = 0;
+    /* The top five bits of each product select a bit within a 32-bit half of a word. */
+    for (size_t i = 0; i < LANES; i++)
+        masks[i / 2] |= 1ULL << (((hash * SALT[i]) >> 27) + 32 * (i % 2));
+}
+
+/*
+ * Returns true if every bit which a key of the specified hash sets is set within the block.
+ * Θ(1)
+ */
+static bool bloom_probe(const sync_Word* const block, const unsigned int hash)
+{
+    unsigned long long masks[BLOCK_WORDS];
+    bloom_masks(hash, masks);
+
+    unsigned long long missing = 0;
+    for (size_t i = 0; i < BLOCK_WORDS; i++)
+        missing |= masks[i] & ~(unsigned long long)block[i];
+    return missing == 0;
+}
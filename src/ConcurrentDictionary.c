@@ -0,0 +1,764 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       ConcurrentDictionary.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/ConcurrentDictionary.h"
+
+/* Maximum number of keys in each kind of Node. */
+#define INNER_CAPACITY 64
+#define LEAF_CAPACITY 64
+
+/* A Node's version is odd while a writer holds it. */
+#define LOCKED(version) (((version) & 1) != 0)
+
+/*
+ * Optimistic lock coupling:
+ * Readers record a Node's version, read the Node, then check that the version did not change.
+ * Writers lock only the Nodes they modify by making the version odd, and bump it again when done.
+ * Nodes are never merged or de-allocated while the Dictionary is in use,
+ * so a reader holding a stale pointer always points to valid memory.
+ */
+
+/* Header shared by inner and leaf Nodes. */
+typedef struct cdict_Node
+{
+    sync_Word version;
+    volatile unsigned int count;
+    bool leaf;
+} cdict_Node;
+
+/* Inner Node structure. The subtree left of a key only holds keys less than or equal to it. */
+typedef struct cdict_Inner
+{
+    cdict_Node base;
+    const void *keys[INNER_CAPACITY];
+    cdict_Node *children[INNER_CAPACITY + 1];
+} cdict_Inner;
+
+/* Leaf Node structure. Leaves are chained together in ascending order. */
+typedef struct cdict_Leaf
+{
+    cdict_Node base;
+    const void *keys[LEAF_CAPACITY], *values[LEAF_CAPACITY];
+    struct cdict_Leaf *next;
+} cdict_Leaf;
+
+/* ConcurrentDictionary structure. */
+struct ConcurrentDictionary
+{
+    cdict_Node *volatile root;
+    /* Left-most leaf. Leaves only split rightwards, so this only changes on clear. */
+    cdict_Leaf *head;
+
+    /* Function pointers. */
+    int(*compare)(const void*, const void*);
+    char*(*toString)(const void*, const void*);
+};
+
+/* Structure to assist in looping through Dictionary. */
+struct cdict_Iterator
+{
+    /* Consistent copy of the leaf currently being iterated. */
+    const void *keys[LEAF_CAPACITY], *values[LEAF_CAPACITY];
+    unsigned int index, count;
+    /* Leaf to be copied once the current copy is exhausted. */
+    const cdict_Leaf *next;
+};
+
+/* Local functions. */
+static cdict_Leaf* cdict_Leaf_new();
+static cdict_Inner* cdict_Inner_new();
+static void cdict_Node_destroy(cdict_Node* const node);
+static LONG64 cdict_read_lock(const cdict_Node* const node, bool* const restart);
+static bool cdict_validate(const cdict_Node* const node, const LONG64 version);
+static bool cdict_upgrade(cdict_Node* const node, const LONG64 version);
+static void cdict_unlock(cdict_Node* const node);
+static unsigned int cdict_count(const cdict_Node* const node);
+static unsigned int cdict_lower_bound(const void* const* const keys, const unsigned int count, const void* const key,
+                                      int(*compare)(const void*, const void*), bool* const exact);
+static cdict_Node* cdict_child(const cdict_Inner* const inner, const void* const key,
+                               int(*compare)(const void*, const void*));
+static cdict_Node* cdict_descend(const ConcurrentDictionary* const dict, const void* const key, LONG64* const version);
+static bool cdict_try_get(const ConcurrentDictionary* const dict, const void* const key, const void** const value);
+static bool cdict_try_put(ConcurrentDictionary* const dict, const void* const key,
+                          const void* const value, const void** const replaced);
+static bool cdict_try_remove(ConcurrentDictionary* const dict, const void* const key, const void** const removed);
+static void cdict_split(ConcurrentDictionary* const dict, cdict_Inner* const parent, const LONG64 parent_version,
+                        cdict_Node* const node, const LONG64 version);
+static cdict_Node* cdict_split_leaf(cdict_Leaf* const leaf, const void** const separator);
+static cdict_Node* cdict_split_inner(cdict_Inner* const inner, const void** const separator);
+static unsigned int cdict_leaf_read(const cdict_Leaf* const leaf, const void** const keys,
+                                    const void** const values, const cdict_Leaf** const next);
+static void cdict_iter_load(cdict_Iterator* const iter, const cdict_Leaf* leaf);
+
+/*
+ * Constructor function.
+ * The `compare` function must be defined to call this function.
+ * Θ(1)
+ */
+ConcurrentDictionary* ConcurrentDictionary_new(int(*compare)(const void*, const void*),
+                                               char*(*toString)(const void*, const void*))
+{
+    io_assert(compare != NULL, IO_MSG_NOT_SUPPORTED);
+
+    ConcurrentDictionary* const dict = mem_calloc(1, sizeof(ConcurrentDictionary));
+    dict->head = cdict_Leaf_new();
+    dict->root = &dict->head->base;
+    dict->compare = compare;
+    dict->toString = toString;
+    return dict;
+}
+
+/*
+ * Returns the value of a mapping whose key matches the specified key.
+ * Returns NULL if no such mapping exists.
+ * Θ(log(n))
+ */
+void* cdict_get(const ConcurrentDictionary* const dict, const void* const key)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const void *value;
+    for (unsigned int attempt = 0; !cdict_try_get(dict, key, &value); attempt++)
+        sync_backoff(attempt);
+
+    return (void*)value;
+}
+
+/*
+ * Returns the number of mappings in the Dictionary.
+ * The count is exact unless the Dictionary is modified while it is being counted.
+ * Θ(n)
+ */
+size_t cdict_size(const ConcurrentDictionary* const dict)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+
+    size_t size = 0;
+    for (const cdict_Leaf *leaf = dict->head; leaf != NULL; )
+        size += cdict_leaf_read(leaf, NULL, NULL, &leaf);
+
+    return size;
+}
+
+/*
+ * Returns true if the Dictionary is empty.
+ * Ω(1), O(n)
+ */
+bool cdict_empty(const ConcurrentDictionary* const dict)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+
+    /* Leaves can be emptied by removals, so look for any non-empty leaf. */
+    for (const cdict_Leaf *leaf = dict->head; leaf != NULL; )
+        if (cdict_leaf_read(leaf, NULL, NULL, &leaf) > 0)
+            return false;
+
+    return true;
+}
+
+/*
+ * Returns true if the Dictionary contains a mapping with the specified key.
+ * Θ(log(n))
+ */
+bool cdict_contains(const ConcurrentDictionary* const dict, const void* const key)
+{
+    return cdict_get(dict, key) != NULL;
+}
+
+/*
+ * Prints out the contents of the Dictionary to the console window.
+ * Θ(n)
+ */
+void cdict_print(const ConcurrentDictionary* const dict)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+
+    printf("%c", '[');
+    cdict_Iterator* const iter = cdict_iter(dict);
+    while (cdict_iter_has_next(iter))
+    {
+        void *value;
+        const void* const key = cdict_iter_next(iter, &value);
+        printf("%s", dict->toString(key, value));
+        if (cdict_iter_has_next(iter)) printf(", ");
+    }
+    printf("]\n");
+    cdict_iter_destroy(iter);
+}
+
+/*
+ * Returns a shallow copy of the Dictionary.
+ * Θ(n * log(n))
+ */
+ConcurrentDictionary* cdict_clone(const ConcurrentDictionary* const dict)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+
+    ConcurrentDictionary* const copy = ConcurrentDictionary_new(dict->compare, dict->toString);
+
+    cdict_Iterator* const iter = cdict_iter(dict);
+    while (cdict_iter_has_next(iter))
+    {
+        void *value;
+        const void* const key = cdict_iter_next(iter, &value);
+        cdict_put(copy, key, value);
+    }
+    cdict_iter_destroy(iter);
+
+    return copy;
+}
+
+/*
+ * Inserts a mapping into the Dictionary.
+ * If the Dictionary already contained a mapping for the key, the old value is replaced.
+ * Returns the replaced value or NULL if this is a new mapping.
+ * Θ(log(n))
+ */
+void* cdict_put(ConcurrentDictionary* const dict, const void* const key, const void* const value)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+
+    const void *replaced;
+    for (unsigned int attempt = 0; !cdict_try_put(dict, key, value, &replaced); attempt++)
+        sync_backoff(attempt);
+
+    return (void*)replaced;
+}
+
+/*
+ * Removes a mapping from the Dictionary whose key matches the specified key.
+ * Returns the value of the removed mapping or NULL if no such mapping exists.
+ * Θ(log(n))
+ */
+void* cdict_remove(ConcurrentDictionary* const dict, const void* const key)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const void *removed;
+    for (unsigned int attempt = 0; !cdict_try_remove(dict, key, &removed); attempt++)
+        sync_backoff(attempt);
+
+    return (void*)removed;
+}
+
+/*
+ * Removes all mappings from the Dictionary.
+ * NOTE: Unlike other operations, this function must not run alongside any other thread using the Dictionary.
+ * Θ(n)
+ */
+void cdict_clear(ConcurrentDictionary* const dict)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+
+    cdict_Node_destroy(dict->root);
+    dict->head = cdict_Leaf_new();
+    dict->root = &dict->head->base;
+}
+
+/*
+ * De-constructor function.
+ * Θ(n)
+ */
+void cdict_destroy(ConcurrentDictionary* const dict)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+
+    cdict_Node_destroy(dict->root);
+    mem_free(dict, sizeof(ConcurrentDictionary));
+}
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+cdict_Iterator* cdict_iter(const ConcurrentDictionary* const dict)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+
+    cdict_Iterator* const iter = mem_calloc(1, sizeof(cdict_Iterator));
+    cdict_iter_load(iter, dict->head);
+    return iter;
+}
+
+/*
+ * Returns the iterator's current key/value pair and advances it forward.
+ * The key will be returned and the value will be assigned to the data of the parameter.
+ * Ω(1), O(n)
+ */
+void* cdict_iter_next(cdict_Iterator* const iter, void **value)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+    io_assert(cdict_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+
+    const void* const key = iter->keys[iter->index];
+    *value = (void*)iter->values[iter->index++];
+
+    /* Copy the next leaf ahead of time so that `has_next` never has to. */
+    if (iter->index >= iter->count)
+        cdict_iter_load(iter, iter->next);
+
+    return (void*)key;
+}
+
+/*
+ * Returns true if the iterator has a next key/value pair.
+ * Θ(1)
+ */
+bool cdict_iter_has_next(const cdict_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return iter->index < iter->count;
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void cdict_iter_destroy(cdict_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    mem_free(iter, sizeof(cdict_Iterator));
+}
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+static cdict_Leaf* cdict_Leaf_new()
+{
+    cdict_Leaf* const leaf = mem_calloc(1, sizeof(cdict_Leaf));
+    leaf->base.leaf = true;
+    return leaf;
+}
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+static cdict_Inner* cdict_Inner_new()
+{
+    return mem_calloc(1, sizeof(cdict_Inner));
+}
+
+/*
+ * De-constructs a Node and all Nodes beneath it.
+ * Θ(n)
+ */
+static void cdict_Node_destroy(cdict_Node* const node)
+{
+    if (node->leaf)
+        mem_free(node, sizeof(cdict_Leaf));
+    else
+    {
+        cdict_Inner* const inner = (cdict_Inner*)node;
+        for (unsigned int i = 0; i <= node->count; i++)
+            cdict_Node_destroy(inner->children[i]);
+        mem_free(inner, sizeof(cdict_Inner));
+    }
+}
+
+/*
+ * Returns the version of a Node before reading it.
+ * `restart` is set if a writer currently holds the Node.
+ * Θ(1)
+ */
+static LONG64 cdict_read_lock(const cdict_Node* const node, bool* const restart)
+{
+    const LONG64 version = sync_load(&node->version);
+    if (LOCKED(version)) *restart = true;
+    return version;
+}
+
+/*
+ * Returns true if a Node has not been modified since its version was read.
+ * Θ(1)
+ */
+static bool cdict_validate(const cdict_Node* const node, const LONG64 version)
+{
+    sync_load_fence();
+    return sync_load(&node->version) == version;
+}
+
+/*
+ * Locks a Node for writing if it has not been modified since its version was read.
+ * Returns true if the lock was obtained.
+ * Θ(1)
+ */
+static bool cdict_upgrade(cdict_Node* const node, const LONG64 version)
+{
+    return sync_cas(&node->version, version, version + 1);
+}
+
+/*
+ * Unlocks a Node which was locked for writing.
+ * Θ(1)
+ */
+static void cdict_unlock(cdict_Node* const node)
+{
+    sync_fetch_add(&node->version, 1);
+}
+
+/*
+ * Returns the number of keys in a Node.
+ * A reader racing with a writer could see any count, so it is clamped to the Node's capacity.
+ * Θ(1)
+ */
+static unsigned int cdict_count(const cdict_Node* const node)
+{
+    const unsigned int count = node->count, capacity = node->leaf ? LEAF_CAPACITY : INNER_CAPACITY;
+    return count < capacity ? count : capacity;
+}
+
+/*
+ * Returns the index of the first key which is greater than or equal to the specified key.
+ * `exact` is set to true if the key at that index matches the specified key.
+ * Θ(log(n))
+ */
+static unsigned int cdict_lower_bound(const void* const* const keys, const unsigned int count, const void* const key,
+                                      int(*compare)(const void*, const void*), bool* const exact)
+{
+    unsigned int lower = 0, upper = count;
+    *exact = false;
+
+    while (lower < upper)
+    {
+        const unsigned int middle = lower + (upper - lower) / 2;
+        const void* const probe = keys[middle];
+        /* Only a reader racing with a writer can see an empty slot. Validation will reject the result. */
+        if (probe == NULL) return middle;
+
+        const int compared = (key == probe) ? 0 : compare(key, probe);
+        if (compared < 0) upper = middle;
+        else if (compared > 0) lower = middle + 1;
+        else
+        {
+            *exact = true;
+            return middle;
+        }
+    }
+
+    return lower;
+}
+
+/*
+ * Returns the child of an inner Node whose subtree would contain the specified key.
+ * Returns NULL if a racing writer left the child slot empty.
+ * Θ(log(n))
+ */
+static cdict_Node* cdict_child(const cdict_Inner* const inner, const void* const key,
+                               int(*compare)(const void*, const void*))
+{
+    bool exact;
+    const unsigned int index = cdict_lower_bound(inner->keys, cdict_count(&inner->base), key, compare, &exact);
+    return *(cdict_Node* volatile*)&inner->children[index];
+}
+
+/*
+ * Optimistically descends from the root to the leaf which would contain the specified key.
+ * Each child's version is read before its parent is validated, so no split can slip in between.
+ * Returns NULL if the descent must be restarted.
+ * Θ(log(n))
+ */
+static cdict_Node* cdict_descend(const ConcurrentDictionary* const dict, const void* const key, LONG64* const version)
+{
+    bool restart = false;
+    cdict_Node *node = sync_load_ptr(&dict->root);
+    *version = cdict_read_lock(node, &restart);
+    if (restart || node != dict->root) return NULL;
+
+    while (!node->leaf)
+    {
+        cdict_Node* const child = cdict_child((cdict_Inner*)node, key, dict->compare);
+        if (child == NULL) return NULL;
+        const LONG64 child_version = cdict_read_lock(child, &restart);
+        if (restart || !cdict_validate(node, *version)) return NULL;
+
+        node = child;
+        *version = child_version;
+    }
+
+    return node;
+}
+
+/*
+ * Attempts to look up the value of the specified key without locking.
+ * Returns false if a racing writer was detected and the lookup must be retried.
+ * Θ(log(n))
+ */
+static bool cdict_try_get(const ConcurrentDictionary* const dict, const void* const key, const void** const value)
+{
+    LONG64 version;
+    const cdict_Leaf* const leaf = (const cdict_Leaf*)cdict_descend(dict, key, &version);
+    if (leaf == NULL) return false;
+
+    bool exact;
+    const unsigned int index = cdict_lower_bound(leaf->keys, cdict_count(&leaf->base), key, dict->compare, &exact);
+    *value = exact ? leaf->values[index] : NULL;
+
+    return cdict_validate(&leaf->base, version);
+}
+
+/*
+ * Attempts to insert a mapping into the Dictionary, locking only the leaf it is inserted into.
+ * Full Nodes found on the way down are split first, which always requires a retry.
+ * Returns false if the insertion must be retried.
+ * Θ(log(n))
+ */
+static bool cdict_try_put(ConcurrentDictionary* const dict, const void* const key,
+                          const void* const value, const void** const replaced)
+{
+    bool restart = false;
+    cdict_Node *node = sync_load_ptr(&dict->root);
+    LONG64 version = cdict_read_lock(node, &restart);
+    if (restart || node != dict->root) return false;
+
+    cdict_Inner *parent = NULL;
+    LONG64 parent_version = 0;
+
+    while (true)
+    {
+        /* Split eagerly, so a split never has to propagate further than one parent. */
+        if (node->count >= (node->leaf ? LEAF_CAPACITY : INNER_CAPACITY))
+        {
+            cdict_split(dict, parent, parent_version, node, version);
+            return false;
+        }
+        if (node->leaf) break;
+
+        cdict_Node* const child = cdict_child((cdict_Inner*)node, key, dict->compare);
+        if (child == NULL) return false;
+        const LONG64 child_version = cdict_read_lock(child, &restart);
+        if (restart || !cdict_validate(node, version)) return false;
+
+        parent = (cdict_Inner*)node;
+        parent_version = version;
+        node = child;
+        version = child_version;
+    }
+
+    /* A leaf's range of keys can only shrink by splitting it, which would have changed its version. */
+    if (!cdict_upgrade(node, version)) return false;
+
+    cdict_Leaf* const leaf = (cdict_Leaf*)node;
+    bool exact;
+    const unsigned int index = cdict_lower_bound(leaf->keys, node->count, key, dict->compare, &exact);
+    if (exact)
+    {
+        *replaced = leaf->values[index];
+        leaf->values[index] = value;
+    }
+    else
+    {
+        const size_t moved = (node->count - index) * sizeof(void*);
+        memmove(&leaf->keys[index + 1], &leaf->keys[index], moved);
+        memmove(&leaf->values[index + 1], &leaf->values[index], moved);
+        leaf->keys[index] = key;
+        leaf->values[index] = value;
+        node->count++;
+        *replaced = NULL;
+    }
+
+    cdict_unlock(node);
+    return true;
+}
+
+/*
+ * Attempts to remove a mapping from the Dictionary, locking only the leaf it is removed from.
+ * Leaves are never merged; their space is reused by later insertions.
+ * Returns false if the removal must be retried.
+ * Θ(log(n))
+ */
+static bool cdict_try_remove(ConcurrentDictionary* const dict, const void* const key, const void** const removed)
+{
+    LONG64 version;
+    cdict_Node* const node = cdict_descend(dict, key, &version);
+    if (node == NULL || !cdict_upgrade(node, version)) return false;
+
+    cdict_Leaf* const leaf = (cdict_Leaf*)node;
+    bool exact;
+    const unsigned int index = cdict_lower_bound(leaf->keys, node->count, key, dict->compare, &exact);
+    *removed = NULL;
+    if (exact)
+    {
+        *removed = leaf->values[index];
+        const size_t moved = (node->count - index - 1) * sizeof(void*);
+        memmove(&leaf->keys[index], &leaf->keys[index + 1], moved);
+        memmove(&leaf->values[index], &leaf->values[index + 1], moved);
+        node->count--;
+    }
+
+    cdict_unlock(node);
+    return true;
+}
+
+/*
+ * Splits a full Node in two and inserts the separator into its parent.
+ * If either Node was modified since its version was read, nothing is done.
+ * The caller must restart its descent either way.
+ * Θ(1)
+ */
+static void cdict_split(ConcurrentDictionary* const dict, cdict_Inner* const parent, const LONG64 parent_version,
+                        cdict_Node* const node, const LONG64 version)
+{
+    if (parent != NULL && !cdict_upgrade(&parent->base, parent_version)) return;
+    if (!cdict_upgrade(node, version))
+    {
+        if (parent != NULL) cdict_unlock(&parent->base);
+        return;
+    }
+    /* Another writer may have already given the old root a parent. */
+    if (parent == NULL && node != dict->root)
+    {
+        cdict_unlock(node);
+        return;
+    }
+
+    const void *separator;
+    cdict_Node* const sibling = node->leaf ? cdict_split_leaf((cdict_Leaf*)node, &separator)
+                                           : cdict_split_inner((cdict_Inner*)node, &separator);
+
+    if (parent != NULL)
+    {
+        /* Parents are split on the way down, so there is always room for the separator. */
+        bool exact;
+        const unsigned int index = cdict_lower_bound(parent->keys, parent->base.count,
+                                                     separator, dict->compare, &exact);
+        const unsigned int shifted = parent->base.count - index;
+        memmove(&parent->keys[index + 1], &parent->keys[index], shifted * sizeof(void*));
+        memmove(&parent->children[index + 2], &parent->children[index + 1], shifted * sizeof(cdict_Node*));
+        parent->keys[index] = separator;
+        parent->children[index + 1] = sibling;
+        parent->base.count++;
+    }
+    else
+    {
+        /* The tree grows a level. */
+        cdict_Inner* const root = cdict_Inner_new();
+        root->keys[0] = separator;
+        root->children[0] = node;
+        root->children[1] = sibling;
+        root->base.count = 1;
+        sync_store_ptr(&dict->root, root);
+    }
+
+    cdict_unlock(node);
+    if (parent != NULL) cdict_unlock(&parent->base);
+}
+
+/*
+ * Moves the upper half of a locked leaf into a new leaf and returns it.
+ * The separator is set to the greatest key remaining in the old leaf.
+ * Θ(1)
+ */
+static cdict_Node* cdict_split_leaf(cdict_Leaf* const leaf, const void** const separator)
+{
+    cdict_Leaf* const sibling = cdict_Leaf_new();
+    const unsigned int kept = leaf->base.count / 2, moved = leaf->base.count - kept;
+
+    memcpy(sibling->keys, &leaf->keys[kept], moved * sizeof(void*));
+    memcpy(sibling->values, &leaf->values[kept], moved * sizeof(void*));
+    sibling->base.count = moved;
+    sibling->next = leaf->next;
+
+    leaf->base.count = kept;
+    /* The sibling is fully built before any reader can reach it. */
+    sync_store_ptr(&leaf->next, sibling);
+    *separator = leaf->keys[kept - 1];
+
+    return &sibling->base;
+}
+
+/*
+ * Moves the upper half of a locked inner Node into a new inner Node and returns it.
+ * The middle key is removed from both Nodes and becomes the separator.
+ * Θ(1)
+ */
+static cdict_Node* cdict_split_inner(cdict_Inner* const inner, const void** const separator)
+{
+    cdict_Inner* const sibling = cdict_Inner_new();
+    const unsigned int kept = inner->base.count / 2, moved = inner->base.count - kept - 1;
+
+    memcpy(sibling->keys, &inner->keys[kept + 1], moved * sizeof(void*));
+    memcpy(sibling->children, &inner->children[kept + 1], (moved + 1) * sizeof(cdict_Node*));
+    sibling->base.count = moved;
+
+    *separator = inner->keys[kept];
+    inner->base.count = kept;
+
+    return &sibling->base;
+}
+
+/*
+ * Reads a consistent snapshot of a leaf, waiting out any writer which holds it.
+ * The leaf's keys and values are copied if `keys` and `values` are non-NULL.
+ * Returns the number of keys in the snapshot.
+ * Θ(1)
+ */
+static unsigned int cdict_leaf_read(const cdict_Leaf* const leaf, const void** const keys,
+                                    const void** const values, const cdict_Leaf** const next)
+{
+    for (unsigned int attempt = 0; ; attempt++)
+    {
+        bool restart = false;
+        const LONG64 version = cdict_read_lock(&leaf->base, &restart);
+        if (!restart)
+        {
+            const unsigned int count = cdict_count(&leaf->base);
+            if (keys != NULL)
+                for (unsigned int i = 0; i < count; i++)
+                {
+                    keys[i] = leaf->keys[i];
+                    values[i] = leaf->values[i];
+                }
+            *next = *(cdict_Leaf* volatile*)&leaf->next;
+
+            if (cdict_validate(&leaf->base, version))
+                return count;
+        }
+        sync_backoff(attempt);
+    }
+}
+
+/*
+ * Copies the next non-empty leaf, starting at the specified leaf, into the iterator.
+ * Ω(1), O(n)
+ */
+static void cdict_iter_load(cdict_Iterator* const iter, const cdict_Leaf* leaf)
+{
+    iter->index = iter->count = 0;
+    /* Leaves can be emptied by removals, so skip over them. */
+    while (leaf != NULL && iter->count == 0)
+        iter->count = cdict_leaf_read(leaf, iter->keys, iter->values, &leaf);
+    iter->next = leaf;
+}
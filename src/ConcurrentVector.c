@@ -0,0 +1,298 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       ConcurrentVector.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/ConcurrentVector.h"
+#include <limits.h>
+
+/* The first segment holds 2^FIRST_SEGMENT_BITS elements, and each segment after holds twice the one before. */
+#define FIRST_SEGMENT_BITS 4
+#define FIRST_SEGMENT ((size_t)1 << FIRST_SEGMENT_BITS)
+/* Enough segments to address every index. */
+#define SEGMENTS (sizeof(size_t) * CHAR_BIT - FIRST_SEGMENT_BITS)
+/* Number of elements in the specified segment. */
+#define SEGMENT_SIZE(segment) (FIRST_SEGMENT << (segment))
+
+/*
+ * Appending:
+ * A writer reserves an index by incrementing `reserved`, allocates the index's segment if no other
+ * writer has, then stores its element. Segments start out zeroed, so a slot holding NULL has not been written.
+ * Writers then advance `published` over every written slot, so a slow writer only holds back publication
+ * of the elements after its own, and whichever writer finishes last publishes them.
+ */
+
+/* ConcurrentVector structure. */
+struct ConcurrentVector
+{
+    const void* volatile *volatile segments[SEGMENTS];
+    /* Number of indices which have been handed out to writers. */
+    sync_Word reserved;
+    /* Number of elements at the front of the Vector which have all been written. */
+    sync_Word published;
+
+    /* Function pointers. */
+    char*(*toString)(const void*);
+};
+
+/* Structure to assist in looping through Vector. */
+struct cvect_Iterator
+{
+    size_t index, end;
+    const ConcurrentVector *ref;
+};
+
+/* Local functions. */
+static const void* volatile* cvect_slot(const ConcurrentVector* const vect, const size_t index, const bool allocate);
+static void cvect_publish(ConcurrentVector* const vect);
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+ConcurrentVector* ConcurrentVector_new(char*(*toString)(const void*))
+{
+    ConcurrentVector* const vect = mem_calloc(1, sizeof(ConcurrentVector));
+    vect->toString = toString;
+    return vect;
+}
+
+/*
+ * Returns the published element at the specified index.
+ * Θ(1)
+ */
+void* cvect_at(const ConcurrentVector* const vect, const size_t index)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+    io_assert(index < (size_t)sync_load(&vect->published), IO_MSG_OUT_OF_BOUNDS);
+
+    return sync_load_ptr(cvect_slot(vect, index, false));
+}
+
+/*
+ * Returns the last published element of the Vector.
+ * Θ(1)
+ */
+void* cvect_back(const ConcurrentVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    const size_t size = (size_t)sync_load(&vect->published);
+    io_assert(size > 0, IO_MSG_EMPTY);
+
+    return sync_load_ptr(cvect_slot(vect, size - 1, false));
+}
+
+/*
+ * Returns the number of published elements in the Vector.
+ * Θ(1)
+ */
+size_t cvect_size(const ConcurrentVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+    return (size_t)sync_load(&vect->published);
+}
+
+/*
+ * Returns true if the Vector has no published elements.
+ * Θ(1)
+ */
+bool cvect_empty(const ConcurrentVector* const vect)
+{
+    return cvect_size(vect) == 0;
+}
+
+/*
+ * Prints out the contents of the Vector to the console window.
+ * Θ(n)
+ */
+void cvect_print(const ConcurrentVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+    io_assert(vect->toString != NULL, IO_MSG_NOT_SUPPORTED);
+
+    cvect_Iterator* const iter = cvect_iter(vect);
+    printf("%c", '[');
+    while (cvect_iter_has_next(iter))
+    {
+        printf("%s", vect->toString(cvect_iter_next(iter)));
+        if (cvect_iter_has_next(iter)) printf(", ");
+    }
+    printf("]\n");
+    cvect_iter_destroy(iter);
+}
+
+/*
+ * Appends an element at the end of the Vector and returns its index.
+ * The element is published once every element before it has been written.
+ * Θ(1) amortized
+ */
+size_t cvect_push_back(ConcurrentVector* const vect, const void* const data)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+    io_assert(data != NULL, IO_MSG_NULL_PTR);
+
+    const size_t index = (size_t)sync_fetch_add(&vect->reserved, 1);
+    sync_store_ptr(cvect_slot(vect, index, true), data);
+    /* The store must be visible before scanning, or two writers may each miss the other's element. */
+    sync_fence();
+    cvect_publish(vect);
+
+    return index;
+}
+
+/*
+ * Removes all elements from the Vector.
+ * The first segment is kept for future use.
+ * Θ(n)
+ */
+void cvect_clear(ConcurrentVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    for (unsigned int i = 0; i < SEGMENTS && vect->segments[i] != NULL; i++)
+    {
+        if (i == 0)
+            memset((void*)vect->segments[i], 0, SEGMENT_SIZE(i) * sizeof(void*));
+        else
+        {
+            mem_free((void*)vect->segments[i], SEGMENT_SIZE(i) * sizeof(void*));
+            vect->segments[i] = NULL;
+        }
+    }
+    vect->reserved = vect->published = 0;
+}
+
+/*
+ * De-constructor function.
+ * Θ(log(n))
+ */
+void cvect_destroy(ConcurrentVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    for (unsigned int i = 0; i < SEGMENTS && vect->segments[i] != NULL; i++)
+        mem_free((void*)vect->segments[i], SEGMENT_SIZE(i) * sizeof(void*));
+    mem_free(vect, sizeof(ConcurrentVector));
+}
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+cvect_Iterator* cvect_iter(const ConcurrentVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    cvect_Iterator* const iter = mem_calloc(1, sizeof(cvect_Iterator));
+    iter->end = (size_t)sync_load(&vect->published);
+    iter->ref = vect;
+    return iter;
+}
+
+/*
+ * Returns the iterator's current element and advances it forward.
+ * Θ(1)
+ */
+void* cvect_iter_next(cvect_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    io_assert(cvect_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+
+    return sync_load_ptr(cvect_slot(iter->ref, iter->index++, false));
+}
+
+/*
+ * Returns true if the iterator has a next element.
+ * Θ(1)
+ */
+bool cvect_iter_has_next(const cvect_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return iter->index < iter->end;
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void cvect_iter_destroy(cvect_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    mem_free(iter, sizeof(cvect_Iterator));
+}
+
+/*
+ * Returns the slot of the specified index.
+ * If its segment does not exist, it is allocated if `allocate` is true, otherwise NULL is returned.
+ * Θ(1)
+ */
+static const void* volatile* cvect_slot(const ConcurrentVector* const vect, const size_t index, const bool allocate)
+{
+    /* Offsetting by the first segment's size makes the highest set bit select the segment. */
+    const size_t position = index + FIRST_SEGMENT;
+    const unsigned int high = math_ilog2(position);
+    const unsigned int segment = high - FIRST_SEGMENT_BITS;
+
+    const void* volatile *slots = sync_load_ptr(&vect->segments[segment]);
+    if (slots == NULL)
+    {
+        if (!allocate) return NULL;
+
+        /* Several writers may race to allocate the segment. Only one of them wins. */
+        const void* volatile* const allocated = mem_calloc(SEGMENT_SIZE(segment), sizeof(void*));
+        if (sync_cas_ptr(&((ConcurrentVector*)vect)->segments[segment], NULL, allocated))
+            slots = allocated;
+        else
+        {
+            mem_free((void*)allocated, SEGMENT_SIZE(segment) * sizeof(void*));
+            slots = sync_load_ptr(&vect->segments[segment]);
+        }
+    }
+
+    return &slots[position - ((size_t)1 << high)];
+}
+
+/*
+ * Advances the published count over every element which has been written.
+ * Ω(1), O(p), where p is the number of writers
+ */
+static void cvect_publish(ConcurrentVector* const vect)
+{
+    while (true)
+    {
+        const LONG64 published = sync_load(&vect->published);
+        if (published >= sync_load(&vect->reserved)) return;
+
+        const void* volatile* const slot = cvect_slot(vect, (size_t)published, false);
+        /* The next element is still being written. Its writer will publish it. */
+        if (slot == NULL || sync_load_ptr(slot) == NULL) return;
+
+        /* Failing means another writer advanced it. Either way, try the next element. */
+        (void)sync_cas(&vect->published, published, published + 1);
+    }
+}
@@ -0,0 +1,259 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       CountMinSketch.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/CountMinSketch.h"
+#include <string.h>
+#include <limits.h>
+
+/* Column of the specified row which a key of the spread hash halves is counted in. */
+#define COLUMN(h1, h2, row, width) MATH_FASTRANGE((h1) + (row) * (h2), width)
+
+/*
+ * Estimation:
+ * Each row adds a key's count to one counter, chosen by a hash of its own. Other keys which share
+ * the counter can only inflate it, so the smallest of a key's counters is its closest estimate.
+ * The rows' hashes are derived from two halves of one spread hash, h1 + row * h2, rather than
+ * hashing each key once per row. Counters are only ever summed, so two sketches are merged by
+ * adding their counters element-wise, a loop which compilers vectorize.
+ * For details, see: Cormode, Muthukrishnan, "An Improved Data Stream Summary: The Count-Min Sketch".
+ */
+
+/* CountMinSketch structure. */
+struct CountMinSketch
+{
+    /* Rows of counters, stored one after another. */
+    unsigned long long *counters;
+    size_t width;
+    unsigned int depth;
+    unsigned long long total;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+
+    /* Function pointers. */
+    unsigned int(*hash)(const void*);
+};
+
+/* Local functions. */
+static void cms_spread(const unsigned int hash, unsigned int* const h1, unsigned int* const h2);
+
+/*
+ * Constructor function.
+ * Θ(w * d), where w and d are the width and depth
+ */
+CountMinSketch* CountMinSketch_new(const size_t width, const unsigned int depth,
+                                   unsigned int(*hash)(const void*))
+{
+    io_assert(width > 0, IO_MSG_INVALID_SIZE);
+    io_assert(depth > 0, IO_MSG_INVALID_SIZE);
+
+    CountMinSketch* const cms = mem_calloc(1, sizeof(CountMinSketch));
+    cms->counters = mem_calloc(width * depth, sizeof(unsigned long long));
+    cms->width = width;
+    cms->depth = depth;
+    cms->hash = hash;
+    cms->rw_sync = ReadWriteSync_new();
+    return cms;
+}
+
+/*
+ * Returns the estimated number of times the specified key was added.
+ * The `hash` function must be defined to call this function.
+ * Θ(d), where d is the depth
+ */
+unsigned long long cms_estimate(const CountMinSketch* const cms, const void* const key)
+{
+    io_assert(cms != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(cms->hash != NULL, IO_MSG_NOT_SUPPORTED);
+    return cms_estimate_hash(cms, cms->hash(key));
+}
+
+/*
+ * Returns the estimated number of times a key of the specified hash was added.
+ * Θ(d), where d is the depth
+ */
+unsigned long long cms_estimate_hash(const CountMinSketch* const cms, const unsigned int hash)
+{
+    io_assert(cms != NULL, IO_MSG_NULL_PTR);
+
+    unsigned int h1, h2;
+    cms_spread(hash, &h1, &h2);
+    unsigned long long estimate = ULLONG_MAX;
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(cms->rw_sync);
+
+    for (unsigned int row = 0; row < cms->depth; row++)
+    {
+        const unsigned long long counter = cms->counters[row * cms->width + COLUMN(h1, h2, row, cms->width)];
+        if (counter < estimate) estimate = counter;
+    }
+
+    /* Unlock the data structure. */
+    sync_read_end(cms->rw_sync);
+
+    return estimate;
+}
+
+/*
+ * Returns the total of every count added to the sketch.
+ * Θ(1)
+ */
+unsigned long long cms_total(const CountMinSketch* const cms)
+{
+    io_assert(cms != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(cms->rw_sync);
+
+    const unsigned long long total = cms->total;
+
+    /* Unlock the data structure. */
+    sync_read_end(cms->rw_sync);
+
+    return total;
+}
+
+/*
+ * Adds a key to the sketch the specified number of times.
+ * The `hash` function must be defined to call this function.
+ * Θ(d), where d is the depth
+ */
+void cms_add(CountMinSketch* const cms, const void* const key, const unsigned long long count)
+{
+    io_assert(cms != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(cms->hash != NULL, IO_MSG_NOT_SUPPORTED);
+    cms_add_hash(cms, cms->hash(key), count);
+}
+
+/*
+ * Adds a key of the specified hash to the sketch the specified number of times.
+ * Θ(d), where d is the depth
+ */
+void cms_add_hash(CountMinSketch* const cms, const unsigned int hash, const unsigned long long count)
+{
+    io_assert(cms != NULL, IO_MSG_NULL_PTR);
+
+    unsigned int h1, h2;
+    cms_spread(hash, &h1, &h2);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(cms->rw_sync);
+
+    for (unsigned int row = 0; row < cms->depth; row++)
+        cms->counters[row * cms->width + COLUMN(h1, h2, row, cms->width)] += count;
+    cms->total += count;
+
+    /* Unlock the data structure. */
+    sync_write_end(cms->rw_sync);
+}
+
+/*
+ * Adds every count which was added to another sketch, as if it had been added to this one.
+ * Both sketches must have the same dimensions and hash function.
+ * Θ(w * d), where w and d are the width and depth
+ */
+void cms_merge(CountMinSketch* const cms, const CountMinSketch* const other)
+{
+    io_assert(cms != NULL, IO_MSG_NULL_PTR);
+    io_assert(other != NULL, IO_MSG_NULL_PTR);
+    io_assert(cms != other, IO_MSG_NOT_SUPPORTED);
+    io_assert(cms->width == other->width && cms->depth == other->depth, IO_MSG_NOT_SUPPORTED);
+
+    /* Copy the other sketch's counters first, so that the two sketches are never locked at once. */
+    const size_t length = cms->width * cms->depth;
+    unsigned long long* const merged = mem_malloc(length * sizeof(unsigned long long));
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(other->rw_sync);
+
+    memcpy(merged, other->counters, length * sizeof(unsigned long long));
+    const unsigned long long total = other->total;
+
+    /* Unlock the data structure. */
+    sync_read_end(other->rw_sync);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(cms->rw_sync);
+
+    unsigned long long* const counters = cms->counters;
+    for (size_t i = 0; i < length; i++)
+        counters[i] += merged[i];
+    cms->total += total;
+
+    /* Unlock the data structure. */
+    sync_write_end(cms->rw_sync);
+
+    mem_free(merged, length * sizeof(unsigned long long));
+}
+
+/*
+ * Removes every count from the sketch.
+ * Θ(w * d), where w and d are the width and depth
+ */
+void cms_clear(CountMinSketch* const cms)
+{
+    io_assert(cms != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(cms->rw_sync);
+
+    memset(cms->counters, 0, cms->width * cms->depth * sizeof(unsigned long long));
+    cms->total = 0;
+
+    /* Unlock the data structure. */
+    sync_write_end(cms->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void cms_destroy(CountMinSketch* const cms)
+{
+    io_assert(cms != NULL, IO_MSG_NULL_PTR);
+    mem_free(cms->counters, cms->width * cms->depth * sizeof(unsigned long long));
+    sync_destroy(cms->rw_sync);
+    mem_free(cms, sizeof(CountMinSketch));
+}
+
+/*
+ * Spreads a 32-bit hash over 64 bits, then splits it into the two halves which pick each row's column.
+ * Θ(1)
+ */
+static void cms_spread(const unsigned int hash, unsigned int* const h1, unsigned int* const h2)
+{
+    const unsigned long long spread = math_fmix64(hash);
+
+    /* An odd step keeps the rows' hashes distinct from one another. */
+    *h1 = (unsigned int)(spread >> 32);
+    *h2 = (unsigned int)spread | 1;
+}
@@ -0,0 +1,420 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       CuckooFilter.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/CuckooFilter.h"
+#include <string.h>
+
+/* Fingerprints held by each bucket, packed into one 64-bit word. */
+#define SLOTS 4
+#define FINGERPRINT_BITS 16
+#define FINGERPRINT_MASK 0xFFFFULL
+/* Buckets are sized so that the Filter is at most this full at capacity. */
+#define LOAD_FACTOR 0.95
+/* Evictions attempted before an insertion gives up. */
+#define MAX_KICKS 500
+/* Keys hashed ahead of their probes during a batch query. */
+#define BATCH 16
+
+/* Copies of the lowest bit and highest bit of every fingerprint slot. */
+#define LANE_LOW 0x0001000100010001ULL
+#define LANE_HIGH 0x8000800080008000ULL
+/* Non-zero if any fingerprint slot of the word is zero. */
+#define HAS_ZERO(word) (((word) - LANE_LOW) & ~(word) & LANE_HIGH)
+/* Non-zero if any fingerprint slot of the bucket holds the fingerprint. */
+#define HAS_FINGERPRINT(bucket, fingerprint) HAS_ZERO((bucket) ^ ((fingerprint) * LANE_LOW))
+
+/*
+ * Partial-key cuckoo hashing:
+ * Each key is reduced to a 16-bit fingerprint which may be placed into one of two buckets.
+ * The second bucket is derived from the first bucket and the fingerprint alone, so a fingerprint
+ * can be evicted to its other bucket without knowing its key. A bucket's four fingerprints share
+ * a single word, which is checked for a fingerprint without looping over its slots.
+ * An insertion which runs out of evictions parks the last evicted fingerprint as a victim,
+ * after which the Filter is considered full.
+ * For details, see: Fan, Andersen, Kaminsky, Mitzenmacher, "Cuckoo Filter: Practically Better Than Bloom".
+ */
+
+/* CuckooFilter structure. */
+struct CuckooFilter
+{
+    unsigned long long *buckets;
+    size_t bucket_count, size;
+    /* Fingerprint which could not be placed, and one of its buckets. */
+    unsigned long long victim;
+    size_t victim_bucket;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+
+    /* Function pointers. */
+    unsigned int(*hash)(const void*);
+};
+
+/* Local functions. */
+static void cfilter_locate(const CuckooFilter* const filter, const unsigned int hash,
+                           unsigned long long* const fingerprint, size_t* const bucket);
+static size_t cfilter_alternate(const CuckooFilter* const filter, const size_t bucket,
+                                const unsigned long long fingerprint);
+static bool cfilter_lookup(const CuckooFilter* const filter, const unsigned long long fingerprint,
+                           const size_t bucket);
+static bool cfilter_place(CuckooFilter* const filter, const size_t bucket, const unsigned long long fingerprint);
+static bool cfilter_erase(CuckooFilter* const filter, const size_t bucket, const unsigned long long fingerprint);
+
+/*
+ * Constructor function.
+ * Θ(c), where c is the capacity
+ */
+CuckooFilter* CuckooFilter_new(const size_t capacity, unsigned int(*hash)(const void*))
+{
+    io_assert(capacity > 0, IO_MSG_INVALID_SIZE);
+
+    CuckooFilter* const filter = mem_calloc(1, sizeof(CuckooFilter));
+    /* Alternate buckets are found by XOR, so the bucket count must be a power of two. */
+    filter->bucket_count = math_next_pow2((size_t)(capacity / (SLOTS * LOAD_FACTOR)) + 1);
+    filter->buckets = mem_calloc(filter->bucket_count, sizeof(unsigned long long));
+    filter->hash = hash;
+    filter->rw_sync = ReadWriteSync_new();
+    return filter;
+}
+
+/*
+ * Returns false if the specified key was definitely never added to the Filter.
+ * The `hash` function must be defined to call this function.
+ * Θ(1)
+ */
+bool cfilter_contains(const CuckooFilter* const filter, const void* const key)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(filter->hash != NULL, IO_MSG_NOT_SUPPORTED);
+    return cfilter_contains_hash(filter, filter->hash(key));
+}
+
+/*
+ * Returns false if a key of the specified hash was definitely never added to the Filter.
+ * Θ(1)
+ */
+bool cfilter_contains_hash(const CuckooFilter* const filter, const unsigned int hash)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+
+    unsigned long long fingerprint;
+    size_t bucket;
+    cfilter_locate(filter, hash, &fingerprint, &bucket);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(filter->rw_sync);
+
+    const bool found = cfilter_lookup(filter, fingerprint, bucket);
+
+    /* Unlock the data structure. */
+    sync_read_end(filter->rw_sync);
+
+    return found;
+}
+
+/*
+ * Queries several keys at once, storing each answer into the matching index of `results`.
+ * The Filter is locked once for the whole batch, and keys are hashed in groups before any
+ * bucket is probed, so that the group's cache misses can be overlapped by the processor.
+ * The `hash` function must be defined to call this function.
+ * Θ(n)
+ */
+void cfilter_contains_batch(const CuckooFilter* const filter, const void* const* const keys,
+                            const size_t count, bool* const results)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    io_assert(keys != NULL, IO_MSG_NULL_PTR);
+    io_assert(results != NULL, IO_MSG_NULL_PTR);
+    io_assert(filter->hash != NULL, IO_MSG_NOT_SUPPORTED);
+
+    unsigned long long fingerprints[BATCH];
+    size_t buckets[BATCH];
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(filter->rw_sync);
+
+    for (size_t start = 0; start < count; start += BATCH)
+    {
+        const size_t length = count - start < BATCH ? count - start : BATCH;
+        for (size_t i = 0; i < length; i++)
+        {
+            io_assert(keys[start + i] != NULL, IO_MSG_NULL_PTR);
+            cfilter_locate(filter, filter->hash(keys[start + i]), &fingerprints[i], &buckets[i]);
+        }
+        for (size_t i = 0; i < length; i++)
+            results[start + i] = cfilter_lookup(filter, fingerprints[i], buckets[i]);
+    }
+
+    /* Unlock the data structure. */
+    sync_read_end(filter->rw_sync);
+}
+
+/*
+ * Returns the number of keys in the Filter.
+ * Θ(1)
+ */
+size_t cfilter_size(const CuckooFilter* const filter)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(filter->rw_sync);
+
+    const size_t size = filter->size;
+
+    /* Unlock the data structure. */
+    sync_read_end(filter->rw_sync);
+
+    return size;
+}
+
+/*
+ * Adds a key to the Filter. Returns false if the Filter is too full to hold it.
+ * The `hash` function must be defined to call this function.
+ * see: cfilter_add_hash
+ * Ω(1), O(k), where k is the maximum number of evictions
+ */
+bool cfilter_add(CuckooFilter* const filter, const void* const key)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(filter->hash != NULL, IO_MSG_NOT_SUPPORTED);
+    return cfilter_add_hash(filter, filter->hash(key));
+}
+
+/*
+ * Adds a key of the specified hash to the Filter. Returns false if the Filter is too full to hold it.
+ * When both buckets are full, random fingerprints are evicted into their alternate buckets.
+ * Ω(1), O(k), where k is the maximum number of evictions
+ */
+bool cfilter_add_hash(CuckooFilter* const filter, const unsigned int hash)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+
+    unsigned long long fingerprint;
+    size_t bucket;
+    cfilter_locate(filter, hash, &fingerprint, &bucket);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(filter->rw_sync);
+
+    /* A parked victim means the last insertion already failed to find room. */
+    bool added = filter->victim == 0;
+    if (added)
+    {
+        if (!cfilter_place(filter, bucket, fingerprint))
+        {
+            bucket = rand_bool() ? bucket : cfilter_alternate(filter, bucket, fingerprint);
+            unsigned int kicks = 0;
+            for (; kicks < MAX_KICKS; kicks++)
+            {
+                /* Swap the fingerprint with a random resident, then re-home the resident. */
+                const unsigned int shift = rand_limit(SLOTS) * FINGERPRINT_BITS;
+                const unsigned long long resident = (filter->buckets[bucket] >> shift) & FINGERPRINT_MASK;
+                filter->buckets[bucket] ^= (resident ^ fingerprint) << shift;
+                fingerprint = resident;
+
+                bucket = cfilter_alternate(filter, bucket, fingerprint);
+                if (cfilter_place(filter, bucket, fingerprint))
+                    break;
+            }
+
+            /* Every fingerprint other than the last evicted one has a home; park that one. */
+            if (kicks == MAX_KICKS)
+            {
+                filter->victim = fingerprint;
+                filter->victim_bucket = bucket;
+            }
+        }
+        filter->size++;
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(filter->rw_sync);
+
+    return added;
+}
+
+/*
+ * Removes a key from the Filter and returns true if the removal was successful.
+ * The `hash` function must be defined to call this function.
+ * Θ(1)
+ */
+bool cfilter_remove(CuckooFilter* const filter, const void* const key)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(filter->hash != NULL, IO_MSG_NOT_SUPPORTED);
+    return cfilter_remove_hash(filter, filter->hash(key));
+}
+
+/*
+ * Removes a key of the specified hash from the Filter and returns true if the removal was successful.
+ * Freeing a slot gives a parked victim the chance to return to one of its buckets.
+ * Θ(1)
+ */
+bool cfilter_remove_hash(CuckooFilter* const filter, const unsigned int hash)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+
+    unsigned long long fingerprint;
+    size_t bucket;
+    cfilter_locate(filter, hash, &fingerprint, &bucket);
+    const size_t alternate = cfilter_alternate(filter, bucket, fingerprint);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(filter->rw_sync);
+
+    bool removed = cfilter_erase(filter, bucket, fingerprint) || cfilter_erase(filter, alternate, fingerprint);
+    if (removed && filter->victim != 0)
+    {
+        const size_t victim_alternate = cfilter_alternate(filter, filter->victim_bucket, filter->victim);
+        if (cfilter_place(filter, filter->victim_bucket, filter->victim) ||
+            cfilter_place(filter, victim_alternate, filter->victim))
+            filter->victim = 0;
+    }
+    else if (!removed && filter->victim == fingerprint &&
+             (filter->victim_bucket == bucket || filter->victim_bucket == alternate))
+    {
+        filter->victim = 0;
+        removed = true;
+    }
+    if (removed) filter->size--;
+
+    /* Unlock the data structure. */
+    sync_write_end(filter->rw_sync);
+
+    return removed;
+}
+
+/*
+ * Removes every key from the Filter.
+ * Θ(c), where c is the capacity
+ */
+void cfilter_clear(CuckooFilter* const filter)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(filter->rw_sync);
+
+    memset(filter->buckets, 0, filter->bucket_count * sizeof(unsigned long long));
+    filter->victim = 0;
+    filter->size = 0;
+
+    /* Unlock the data structure. */
+    sync_write_end(filter->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void cfilter_destroy(CuckooFilter* const filter)
+{
+    io_assert(filter != NULL, IO_MSG_NULL_PTR);
+    mem_free(filter->buckets, filter->bucket_count * sizeof(unsigned long long));
+    sync_destroy(filter->rw_sync);
+    mem_free(filter, sizeof(CuckooFilter));
+}
+
+/*
+ * Computes the fingerprint and first bucket of a key of the specified hash.
+ * The hash is spread over 64 bits; the top bits become the fingerprint, and the rest pick the bucket.
+ * Fingerprints are never zero, since zero marks an empty slot.
+ * Θ(1)
+ */
+static void cfilter_locate(const CuckooFilter* const filter, const unsigned int hash,
+                           unsigned long long* const fingerprint, size_t* const bucket)
+{
+    const unsigned long long spread = (unsigned long long)hash * 0x9E3779B97F4A7C15ULL;
+    *fingerprint = spread >> (64 - FINGERPRINT_BITS);
+    if (*fingerprint == 0) *fingerprint = 1;
+    *bucket = (size_t)(spread >> 16) & (filter->bucket_count - 1);
+}
+
+/*
+ * Returns the other bucket of a fingerprint which is placed in the specified bucket.
+ * Applying this twice returns the original bucket.
+ * Θ(1)
+ */
+static size_t cfilter_alternate(const CuckooFilter* const filter, const size_t bucket,
+                                const unsigned long long fingerprint)
+{
+    return (bucket ^ (size_t)(fingerprint * 0x5BD1E995ULL)) & (filter->bucket_count - 1);
+}
+
+/*
+ * Returns true if the fingerprint is in either of its buckets, or is the parked victim.
+ * Θ(1)
+ */
+static bool cfilter_lookup(const CuckooFilter* const filter, const unsigned long long fingerprint,
+                           const size_t bucket)
+{
+    const size_t alternate = cfilter_alternate(filter, bucket, fingerprint);
+    if (HAS_FINGERPRINT(filter->buckets[bucket], fingerprint) ||
+        HAS_FINGERPRINT(filter->buckets[alternate], fingerprint))
+        return true;
+    return filter->victim == fingerprint && (filter->victim_bucket == bucket || filter->victim_bucket == alternate);
+}
+
+/*
+ * Places the fingerprint into an empty slot of the bucket and returns true if there was room.
+ * Θ(1)
+ */
+static bool cfilter_place(CuckooFilter* const filter, const size_t bucket, const unsigned long long fingerprint)
+{
+    unsigned long long* const word = &filter->buckets[bucket];
+    for (unsigned int shift = 0; shift < SLOTS * FINGERPRINT_BITS; shift += FINGERPRINT_BITS)
+        if (((*word >> shift) & FINGERPRINT_MASK) == 0)
+        {
+            *word |= fingerprint << shift;
+            return true;
+        }
+    return false;
+}
+
+/*
+ * Removes one copy of the fingerprint from the bucket and returns true if it was found.
+ * Θ(1)
+ */
+static bool cfilter_erase(CuckooFilter* const filter, const size_t bucket, const unsigned long long fingerprint)
+{
+    unsigned long long* const word = &filter->buckets[bucket];
+    if (!HAS_FINGERPRINT(*word, fingerprint))
+        return false;
+    for (unsigned int shift = 0; shift < SLOTS * FINGERPRINT_BITS; shift += FINGERPRINT_BITS)
+        if (((*word >> shift) & FINGERPRINT_MASK) == fingerprint)
+        {
+            *word &= ~(FINGERPRINT_MASK << shift);
+            return true;
+        }
+    return false;
+}
@@ -0,0 +1,885 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       CuckooTable.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/CuckooTable.h"
+
+/* Number of key/value pairs which each bucket can hold. */
+#define SLOTS 4
+/* Number of locks which the buckets are divided between. Must be a power of 2. */
+#define STRIPES 128
+/* Array capacity components. */
+#define DEFAULT_INITIAL_BUCKETS 16
+#define GROW_FACTOR 2
+/* Maximum number of buckets explored when searching for a displacement path. */
+#define SEARCH_LIMIT 256
+/* Maximum number of evictions while re-hashing a single key into a grown array. */
+#define EVICTION_LIMIT 512
+/* Size of a cache line, used to keep each lock apart from its neighbors. */
+#define CACHE_LINE 64
+
+/* A stripe's version is odd while a writer holds it. */
+#define LOCKED(version) (((version) & 1) != 0)
+/* Index of the stripe which guards a bucket. */
+#define STRIPE(bucket) ((bucket) & (STRIPES - 1))
+/* The two buckets which a hash may be stored in. The alternate bucket of the alternate bucket is the primary. */
+#define PRIMARY(hash, mask) ((size_t)(hash) & (mask))
+#define ALTERNATE(bucket, hash, mask) (((bucket) ^ ((((hash) >> 24) + 1) * (size_t)0x5BD1E995U)) & (mask))
+
+/*
+ * Bucketized cuckoo hashing:
+ * Each key may only be stored in its primary or alternate bucket, each holding several slots.
+ * When both are full, a breadth-first search finds the shortest chain of keys to move into their
+ * other bucket, freeing a slot. Keys are moved one at a time from the end of the chain,
+ * so a key is always reachable from one of its two buckets.
+ *
+ * Buckets are guarded by striped version locks. Readers record the versions of both stripes,
+ * read both buckets, then check that neither version changed.
+ * Grown arrays replace the old array, which is retired rather than de-allocated,
+ * so a reader holding a stale array always points to valid memory.
+ */
+
+/* Bucket structure. An empty slot has a NULL key. */
+typedef struct cuckoo_Bucket
+{
+    unsigned int hashes[SLOTS];
+    const void *keys[SLOTS], *values[SLOTS];
+} cuckoo_Bucket;
+
+/* Array of buckets. Retired arrays are kept in a list until the Table is de-constructed. */
+typedef struct cuckoo_Array
+{
+    size_t mask;
+    struct cuckoo_Array *retired;
+    cuckoo_Bucket buckets[];
+} cuckoo_Array;
+
+/* Stripe structure. Holds the version lock and the number of mappings in the stripe's buckets. */
+typedef struct cuckoo_Stripe
+{
+    sync_Word version;
+    sync_Word count;
+    char padding[CACHE_LINE - 2 * sizeof(sync_Word)];
+} cuckoo_Stripe;
+
+/* CuckooTable structure. */
+struct CuckooTable
+{
+    cuckoo_Array *volatile array;
+    cuckoo_Stripe stripes[STRIPES];
+
+    /* Function pointers. */
+    bool(*equals)(const void*, const void*);
+    unsigned int(*hash)(const void*);
+    char*(*toString)(const void*, const void*);
+};
+
+/* Step of a displacement path. The key in `slot` of the parent's bucket moves into `bucket`. */
+typedef struct cuckoo_Step
+{
+    size_t bucket;
+    int parent;
+    unsigned int slot;
+} cuckoo_Step;
+
+/* Structure to assist in looping through Table. */
+struct cuckoo_Iterator
+{
+    /* Consistent copy of the bucket currently being iterated. */
+    const void *keys[SLOTS], *values[SLOTS];
+    unsigned int index, count;
+    /* Bucket to be copied once the current copy is exhausted. */
+    size_t bucket;
+    const cuckoo_Array *array;
+    const CuckooTable *ref;
+};
+
+/* Local functions. */
+static cuckoo_Array* cuckoo_Array_new(const size_t buckets);
+static void cuckoo_Array_destroy(cuckoo_Array* const array);
+static unsigned int cuckoo_hash(const CuckooTable* const table, const void* const key);
+static unsigned int cuckoo_find(const CuckooTable* const table, const cuckoo_Bucket* const bucket,
+                                const void* const key, const unsigned int hash);
+static unsigned int cuckoo_free_slot(const cuckoo_Bucket* const bucket);
+static void cuckoo_lock(cuckoo_Stripe* const stripe);
+static void cuckoo_unlock(cuckoo_Stripe* const stripe);
+static void cuckoo_lock_pair(CuckooTable* const table, const size_t first, const size_t second);
+static void cuckoo_unlock_pair(CuckooTable* const table, const size_t first, const size_t second);
+static void cuckoo_lock_all(CuckooTable* const table);
+static void cuckoo_unlock_all(CuckooTable* const table);
+static bool cuckoo_try_get(const CuckooTable* const table, const void* const key,
+                           const unsigned int hash, const void** const value);
+static bool cuckoo_try_put(CuckooTable* const table, const void* const key, const void* const value,
+                           const unsigned int hash, const void** const replaced);
+static bool cuckoo_try_remove(CuckooTable* const table, const void* const key,
+                              const unsigned int hash, const void** const removed);
+static bool cuckoo_displace(CuckooTable* const table, const cuckoo_Array* const array,
+                            const size_t first, const size_t second);
+static bool cuckoo_move(CuckooTable* const table, const cuckoo_Array* const array,
+                        const size_t from, const unsigned int slot, const size_t to);
+static void cuckoo_grow(CuckooTable* const table, const cuckoo_Array* const array);
+static cuckoo_Array* cuckoo_rehash(const cuckoo_Array* const array, const size_t buckets);
+static void cuckoo_store(cuckoo_Bucket* const bucket, const unsigned int slot,
+                         const unsigned int hash, const void* const key, const void* const value);
+static unsigned int cuckoo_bucket_read(const CuckooTable* const table, const cuckoo_Bucket* const bucket,
+                                       const size_t index, const void** const keys, const void** const values);
+static void cuckoo_iter_load(cuckoo_Iterator* const iter);
+
+/*
+ * Constructor function.
+ * The `hash` function must be defined to call this function.
+ * The `equals` function must be defined to call this function.
+ * Θ(1)
+ */
+CuckooTable* CuckooTable_new(unsigned int(*hash)(const void*),
+                             bool(*equals)(const void*, const void*),
+                             char*(*toString)(const void*, const void*))
+{
+    io_assert(hash != NULL, IO_MSG_NOT_SUPPORTED);
+    io_assert(equals != NULL, IO_MSG_NOT_SUPPORTED);
+
+    CuckooTable* const table = mem_calloc(1, sizeof(CuckooTable));
+    table->array = cuckoo_Array_new(DEFAULT_INITIAL_BUCKETS);
+    table->hash = hash;
+    table->equals = equals;
+    table->toString = toString;
+    return table;
+}
+
+/*
+ * Returns the value of a mapping whose key matches the specified key.
+ * Returns NULL if no such mapping exists.
+ * Θ(1)
+ */
+void* cuckoo_get(const CuckooTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const unsigned int hash = cuckoo_hash(table, key);
+    const void *value;
+    for (unsigned int attempt = 0; !cuckoo_try_get(table, key, hash, &value); attempt++)
+        sync_backoff(attempt);
+
+    return (void*)value;
+}
+
+/*
+ * Returns the number of mappings in the Table.
+ * The count is exact unless the Table is modified while it is being counted.
+ * Θ(1)
+ */
+size_t cuckoo_size(const CuckooTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    LONG64 size = 0;
+    for (unsigned int i = 0; i < STRIPES; i++)
+        size += sync_load(&table->stripes[i].count);
+
+    /* A mapping moving between stripes may be counted in neither. */
+    return size > 0 ? (size_t)size : 0;
+}
+
+/*
+ * Returns true if the Table is empty.
+ * Θ(1)
+ */
+bool cuckoo_empty(const CuckooTable* const table)
+{
+    return cuckoo_size(table) == 0;
+}
+
+/*
+ * Returns true if the Table contains a mapping with the specified key.
+ * Θ(1)
+ */
+bool cuckoo_contains(const CuckooTable* const table, const void* const key)
+{
+    return cuckoo_get(table, key) != NULL;
+}
+
+/*
+ * Prints out the contents of the Table to the console window.
+ * Θ(n)
+ */
+void cuckoo_print(const CuckooTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    printf("%c", '[');
+    cuckoo_Iterator* const iter = cuckoo_iter(table);
+    while (cuckoo_iter_has_next(iter))
+    {
+        void *value;
+        const void* const key = cuckoo_iter_next(iter, &value);
+        printf("%s", table->toString(key, value));
+        if (cuckoo_iter_has_next(iter)) printf(", ");
+    }
+    printf("]\n");
+    cuckoo_iter_destroy(iter);
+}
+
+/*
+ * Returns a shallow copy of the Table.
+ * Θ(n)
+ */
+CuckooTable* cuckoo_clone(const CuckooTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    CuckooTable* const copy = CuckooTable_new(table->hash, table->equals, table->toString);
+
+    cuckoo_Iterator* const iter = cuckoo_iter(table);
+    while (cuckoo_iter_has_next(iter))
+    {
+        void *value;
+        const void* const key = cuckoo_iter_next(iter, &value);
+        cuckoo_put(copy, key, value);
+    }
+    cuckoo_iter_destroy(iter);
+
+    return copy;
+}
+
+/*
+ * Inserts a mapping into the Table.
+ * If the Table already contained a mapping for the key, the old value is replaced.
+ * Returns the replaced value or NULL if this is a new mapping.
+ * Θ(1) amortized
+ */
+void* cuckoo_put(CuckooTable* const table, const void* const key, const void* const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+
+    const unsigned int hash = cuckoo_hash(table, key);
+    const void *replaced;
+    for (unsigned int attempt = 0; !cuckoo_try_put(table, key, value, hash, &replaced); attempt++)
+        sync_backoff(attempt);
+
+    return (void*)replaced;
+}
+
+/*
+ * Removes a mapping from the Table whose key matches the specified key.
+ * Returns the value of the removed mapping or NULL if no such mapping exists.
+ * Θ(1)
+ */
+void* cuckoo_remove(CuckooTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const unsigned int hash = cuckoo_hash(table, key);
+    const void *removed;
+    for (unsigned int attempt = 0; !cuckoo_try_remove(table, key, hash, &removed); attempt++)
+        sync_backoff(attempt);
+
+    return (void*)removed;
+}
+
+/*
+ * Removes all mappings from the Table while preserving the capacity.
+ * Θ(c), where c is the capacity
+ */
+void cuckoo_clear(CuckooTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    cuckoo_lock_all(table);
+
+    cuckoo_Array* const array = table->array;
+    memset(array->buckets, 0, (array->mask + 1) * sizeof(cuckoo_Bucket));
+    for (unsigned int i = 0; i < STRIPES; i++)
+        table->stripes[i].count = 0;
+
+    cuckoo_unlock_all(table);
+}
+
+/*
+ * De-constructor function.
+ * Θ(c), where c is the capacity
+ */
+void cuckoo_destroy(CuckooTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    cuckoo_Array *array = table->array;
+    while (array != NULL)
+    {
+        cuckoo_Array* const retired = array->retired;
+        cuckoo_Array_destroy(array);
+        array = retired;
+    }
+    mem_free(table, sizeof(CuckooTable));
+}
+
+/*
+ * Constructor function.
+ * Ω(1), O(c), where c is the capacity
+ */
+cuckoo_Iterator* cuckoo_iter(const CuckooTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    cuckoo_Iterator* const iter = mem_calloc(1, sizeof(cuckoo_Iterator));
+    iter->ref = table;
+    iter->array = sync_load_ptr(&table->array);
+    cuckoo_iter_load(iter);
+    return iter;
+}
+
+/*
+ * Returns the iterator's current key/value pair and advances it forward.
+ * The key will be returned and the value will be assigned to the data of the parameter.
+ * Ω(1), O(c), where c is the capacity
+ */
+void* cuckoo_iter_next(cuckoo_Iterator* const iter, void **value)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+    io_assert(cuckoo_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+
+    const void* const key = iter->keys[iter->index];
+    *value = (void*)iter->values[iter->index++];
+
+    /* Copy the next bucket ahead of time so that `has_next` never has to. */
+    if (iter->index >= iter->count)
+        cuckoo_iter_load(iter);
+
+    return (void*)key;
+}
+
+/*
+ * Returns true if the iterator has a next key/value pair.
+ * Θ(1)
+ */
+bool cuckoo_iter_has_next(const cuckoo_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return iter->index < iter->count;
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void cuckoo_iter_destroy(cuckoo_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    mem_free(iter, sizeof(cuckoo_Iterator));
+}
+
+/*
+ * Constructor function.
+ * The number of buckets must be a power of 2.
+ * Θ(n)
+ */
+static cuckoo_Array* cuckoo_Array_new(const size_t buckets)
+{
+    cuckoo_Array* const array = mem_calloc(1, sizeof(cuckoo_Array) + buckets * sizeof(cuckoo_Bucket));
+    array->mask = buckets - 1;
+    return array;
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+static void cuckoo_Array_destroy(cuckoo_Array* const array)
+{
+    mem_free(array, sizeof(cuckoo_Array) + (array->mask + 1) * sizeof(cuckoo_Bucket));
+}
+
+/*
+ * Returns the hash of a key, mixed so that every bit affects the chosen buckets.
+ * Θ(1)
+ */
+static unsigned int cuckoo_hash(const CuckooTable* const table, const void* const key)
+{
+    return math_fmix32(table->hash(key));
+}
+
+/*
+ * Returns the slot of the bucket whose key matches the specified key, or SLOTS if there is none.
+ * Θ(1)
+ */
+static unsigned int cuckoo_find(const CuckooTable* const table, const cuckoo_Bucket* const bucket,
+                                const void* const key, const unsigned int hash)
+{
+    for (unsigned int i = 0; i < SLOTS; i++)
+    {
+        /* A reader racing with a writer may see a torn slot. Validation will reject the result. */
+        const void* const probe = *(const void* volatile*)&bucket->keys[i];
+        if (probe != NULL && bucket->hashes[i] == hash && (probe == key || table->equals(key, probe)))
+            return i;
+    }
+    return SLOTS;
+}
+
+/*
+ * Returns the first empty slot of the bucket, or SLOTS if the bucket is full.
+ * Θ(1)
+ */
+static unsigned int cuckoo_free_slot(const cuckoo_Bucket* const bucket)
+{
+    for (unsigned int i = 0; i < SLOTS; i++)
+        if (*(const void* volatile*)&bucket->keys[i] == NULL)
+            return i;
+    return SLOTS;
+}
+
+/*
+ * Locks a stripe for writing, waiting out any other writer which holds it.
+ * Θ(1)
+ */
+static void cuckoo_lock(cuckoo_Stripe* const stripe)
+{
+    for (unsigned int attempt = 0; ; attempt++)
+    {
+        const LONG64 version = sync_load(&stripe->version);
+        if (!LOCKED(version) && sync_cas(&stripe->version, version, version + 1))
+            return;
+        sync_backoff(attempt);
+    }
+}
+
+/*
+ * Unlocks a stripe which was locked for writing.
+ * Θ(1)
+ */
+static void cuckoo_unlock(cuckoo_Stripe* const stripe)
+{
+    sync_fetch_add(&stripe->version, 1);
+}
+
+/*
+ * Locks the stripes of two buckets. Stripes are always locked in ascending order to prevent deadlocks.
+ * Θ(1)
+ */
+static void cuckoo_lock_pair(CuckooTable* const table, const size_t first, const size_t second)
+{
+    const size_t a = STRIPE(first), b = STRIPE(second);
+    cuckoo_lock(&table->stripes[a < b ? a : b]);
+    if (a != b) cuckoo_lock(&table->stripes[a < b ? b : a]);
+}
+
+/*
+ * Unlocks the stripes of two buckets.
+ * Θ(1)
+ */
+static void cuckoo_unlock_pair(CuckooTable* const table, const size_t first, const size_t second)
+{
+    const size_t a = STRIPE(first), b = STRIPE(second);
+    cuckoo_unlock(&table->stripes[a]);
+    if (a != b) cuckoo_unlock(&table->stripes[b]);
+}
+
+/*
+ * Locks every stripe, in ascending order.
+ * Θ(1)
+ */
+static void cuckoo_lock_all(CuckooTable* const table)
+{
+    for (unsigned int i = 0; i < STRIPES; i++)
+        cuckoo_lock(&table->stripes[i]);
+}
+
+/*
+ * Unlocks every stripe.
+ * Θ(1)
+ */
+static void cuckoo_unlock_all(CuckooTable* const table)
+{
+    for (unsigned int i = 0; i < STRIPES; i++)
+        cuckoo_unlock(&table->stripes[i]);
+}
+
+/*
+ * Attempts to look up the value of the specified key without locking.
+ * Returns false if a racing writer was detected and the lookup must be retried.
+ * Θ(1)
+ */
+static bool cuckoo_try_get(const CuckooTable* const table, const void* const key,
+                           const unsigned int hash, const void** const value)
+{
+    const cuckoo_Array* const array = sync_load_ptr(&table->array);
+    const size_t first = PRIMARY(hash, array->mask), second = ALTERNATE(first, hash, array->mask);
+    const cuckoo_Stripe *const a = &table->stripes[STRIPE(first)], *const b = &table->stripes[STRIPE(second)];
+
+    const LONG64 version_a = sync_load(&a->version), version_b = sync_load(&b->version);
+    if (LOCKED(version_a) || LOCKED(version_b)) return false;
+
+    *value = NULL;
+    const cuckoo_Bucket* bucket = &array->buckets[first];
+    unsigned int slot = cuckoo_find(table, bucket, key, hash);
+    if (slot == SLOTS)
+    {
+        bucket = &array->buckets[second];
+        slot = cuckoo_find(table, bucket, key, hash);
+    }
+    if (slot != SLOTS) *value = *(const void* volatile*)&bucket->values[slot];
+
+    /* The array is only replaced while every stripe is locked, so unchanged versions imply the same array. */
+    sync_load_fence();
+    return sync_load(&a->version) == version_a && sync_load(&b->version) == version_b
+           && array == sync_load_ptr(&table->array);
+}
+
+/*
+ * Attempts to insert a mapping into the Table, locking only the two buckets it may be stored in.
+ * If both buckets are full, room is made for the mapping and the insertion must be retried.
+ * Returns false if the insertion must be retried.
+ * Θ(1) amortized
+ */
+static bool cuckoo_try_put(CuckooTable* const table, const void* const key, const void* const value,
+                           const unsigned int hash, const void** const replaced)
+{
+    const cuckoo_Array* const array = sync_load_ptr(&table->array);
+    const size_t first = PRIMARY(hash, array->mask), second = ALTERNATE(first, hash, array->mask);
+
+    cuckoo_lock_pair(table, first, second);
+    /* The Table may have grown before the locks were obtained. */
+    if (array != table->array)
+    {
+        cuckoo_unlock_pair(table, first, second);
+        return false;
+    }
+
+    cuckoo_Bucket *const a = &table->array->buckets[first], *const b = &table->array->buckets[second];
+    cuckoo_Bucket *bucket = a;
+    unsigned int slot = cuckoo_find(table, a, key, hash);
+    if (slot == SLOTS)
+    {
+        bucket = b;
+        slot = cuckoo_find(table, b, key, hash);
+    }
+
+    /* Duplicate key entered; update the value. */
+    if (slot != SLOTS)
+    {
+        *replaced = bucket->values[slot];
+        bucket->values[slot] = value;
+        cuckoo_unlock_pair(table, first, second);
+        return true;
+    }
+
+    size_t index = first;
+    bucket = a;
+    slot = cuckoo_free_slot(a);
+    if (slot == SLOTS)
+    {
+        index = second;
+        bucket = b;
+        slot = cuckoo_free_slot(b);
+    }
+
+    if (slot != SLOTS)
+    {
+        cuckoo_store(bucket, slot, hash, key, value);
+        table->stripes[STRIPE(index)].count++;
+        *replaced = NULL;
+        cuckoo_unlock_pair(table, first, second);
+        return true;
+    }
+
+    /* Both buckets are full. Make room by displacing other keys, or grow the Table if no room can be made. */
+    cuckoo_unlock_pair(table, first, second);
+    if (!cuckoo_displace(table, array, first, second))
+        cuckoo_grow(table, array);
+    return false;
+}
+
+/*
+ * Attempts to remove a mapping from the Table, locking only the two buckets it may be stored in.
+ * Returns false if the removal must be retried.
+ * Θ(1)
+ */
+static bool cuckoo_try_remove(CuckooTable* const table, const void* const key,
+                              const unsigned int hash, const void** const removed)
+{
+    const cuckoo_Array* const array = sync_load_ptr(&table->array);
+    const size_t first = PRIMARY(hash, array->mask), second = ALTERNATE(first, hash, array->mask);
+
+    cuckoo_lock_pair(table, first, second);
+    if (array != table->array)
+    {
+        cuckoo_unlock_pair(table, first, second);
+        return false;
+    }
+
+    size_t index = first;
+    cuckoo_Bucket *bucket = &table->array->buckets[first];
+    unsigned int slot = cuckoo_find(table, bucket, key, hash);
+    if (slot == SLOTS)
+    {
+        index = second;
+        bucket = &table->array->buckets[second];
+        slot = cuckoo_find(table, bucket, key, hash);
+    }
+
+    *removed = NULL;
+    if (slot != SLOTS)
+    {
+        *removed = bucket->values[slot];
+        bucket->keys[slot] = NULL;
+        table->stripes[STRIPE(index)].count--;
+    }
+
+    cuckoo_unlock_pair(table, first, second);
+    return true;
+}
+
+/*
+ * Searches breadth-first for the shortest chain of keys which can be moved to free a slot
+ * in either of the two specified buckets, then moves those keys starting from the end of the chain.
+ * The search reads the buckets without locking. Each move re-checks its buckets under their locks.
+ * Returns false if no chain was found, meaning the Table must grow.
+ * Ω(1), O(SEARCH_LIMIT)
+ */
+static bool cuckoo_displace(CuckooTable* const table, const cuckoo_Array* const array,
+                            const size_t first, const size_t second)
+{
+    cuckoo_Step steps[SEARCH_LIMIT];
+    unsigned int head = 0, tail = 0;
+    int found = -1;
+
+    steps[tail++] = (cuckoo_Step){ first, -1, 0 };
+    if (second != first) steps[tail++] = (cuckoo_Step){ second, -1, 0 };
+
+    for (; head < tail && found < 0; head++)
+    {
+        const cuckoo_Bucket* const bucket = &array->buckets[steps[head].bucket];
+        if (cuckoo_free_slot(bucket) != SLOTS)
+            found = (int)head;
+        else if (tail + SLOTS <= SEARCH_LIMIT)
+            for (unsigned int i = 0; i < SLOTS; i++)
+                steps[tail++] = (cuckoo_Step){
+                    ALTERNATE(steps[head].bucket, bucket->hashes[i], array->mask), (int)head, i };
+    }
+
+    if (found < 0) return false;
+
+    /* Move the keys, starting with the one whose other bucket has a free slot. */
+    for (int step = found; steps[step].parent >= 0; step = steps[step].parent)
+    {
+        const cuckoo_Step* const parent = &steps[steps[step].parent];
+        /* Another writer changed the path. The caller retries, which searches again. */
+        if (!cuckoo_move(table, array, parent->bucket, steps[step].slot, steps[step].bucket))
+            break;
+    }
+
+    return true;
+}
+
+/*
+ * Moves the key in a slot of one bucket into a free slot of its other bucket.
+ * Returns false if the key or the free slot no longer exists.
+ * Θ(1)
+ */
+static bool cuckoo_move(CuckooTable* const table, const cuckoo_Array* const array,
+                        const size_t from, const unsigned int slot, const size_t to)
+{
+    cuckoo_lock_pair(table, from, to);
+
+    bool moved = false;
+    if (array == table->array)
+    {
+        cuckoo_Bucket *const source = &table->array->buckets[from], *const target = &table->array->buckets[to];
+        const unsigned int free = cuckoo_free_slot(target);
+        if (source->keys[slot] != NULL && free != SLOTS && from != to
+            && ALTERNATE(from, source->hashes[slot], array->mask) == to)
+        {
+            cuckoo_store(target, free, source->hashes[slot], source->keys[slot], source->values[slot]);
+            source->keys[slot] = NULL;
+            table->stripes[STRIPE(from)].count--;
+            table->stripes[STRIPE(to)].count++;
+            moved = true;
+        }
+    }
+
+    cuckoo_unlock_pair(table, from, to);
+    return moved;
+}
+
+/*
+ * Replaces the array with a larger one, unless another writer already has.
+ * Every stripe is locked while the array is replaced. The old array is retired.
+ * Θ(n)
+ */
+static void cuckoo_grow(CuckooTable* const table, const cuckoo_Array* const array)
+{
+    cuckoo_lock_all(table);
+
+    if (table->array == array)
+    {
+        size_t buckets = (array->mask + 1) * GROW_FACTOR;
+        cuckoo_Array *grown;
+        /* A cycle of evictions is very unlikely, and is resolved by growing further. */
+        while ((grown = cuckoo_rehash(array, buckets)) == NULL)
+            buckets *= GROW_FACTOR;
+        grown->retired = table->array;
+
+        /* Keys have changed buckets, so the stripes must be re-counted. */
+        for (unsigned int i = 0; i < STRIPES; i++)
+            table->stripes[i].count = 0;
+        for (size_t i = 0; i < buckets; i++)
+            for (unsigned int j = 0; j < SLOTS; j++)
+                if (grown->buckets[i].keys[j] != NULL)
+                    table->stripes[STRIPE(i)].count++;
+
+        sync_store_ptr(&table->array, grown);
+    }
+
+    cuckoo_unlock_all(table);
+}
+
+/*
+ * Returns a new array of the specified number of buckets containing every mapping of the array.
+ * The new array is private, so it is filled by evicting keys without locking.
+ * Returns NULL if a key could not be placed.
+ * Θ(n)
+ */
+static cuckoo_Array* cuckoo_rehash(const cuckoo_Array* const array, const size_t buckets)
+{
+    cuckoo_Array* const grown = cuckoo_Array_new(buckets);
+
+    for (size_t i = 0; i <= array->mask; i++)
+        for (unsigned int j = 0; j < SLOTS; j++)
+        {
+            const cuckoo_Bucket* const old = &array->buckets[i];
+            if (old->keys[j] == NULL) continue;
+
+            unsigned int hash = old->hashes[j];
+            const void *key = old->keys[j], *value = old->values[j];
+            size_t index = PRIMARY(hash, grown->mask);
+
+            for (unsigned int evictions = 0; key != NULL; evictions++)
+            {
+                if (evictions > EVICTION_LIMIT)
+                {
+                    cuckoo_Array_destroy(grown);
+                    return NULL;
+                }
+
+                cuckoo_Bucket *bucket = &grown->buckets[index];
+                unsigned int slot = cuckoo_free_slot(bucket);
+                if (slot == SLOTS)
+                {
+                    cuckoo_Bucket* const alternate = &grown->buckets[ALTERNATE(index, hash, grown->mask)];
+                    const unsigned int alternate_slot = cuckoo_free_slot(alternate);
+                    if (alternate_slot != SLOTS)
+                    {
+                        bucket = alternate;
+                        slot = alternate_slot;
+                    }
+                }
+
+                if (slot != SLOTS)
+                {
+                    cuckoo_store(bucket, slot, hash, key, value);
+                    key = NULL;
+                }
+                else
+                {
+                    /* Swap the key with a victim, then carry the victim to its other bucket. */
+                    slot = evictions % SLOTS;
+                    const unsigned int victim_hash = bucket->hashes[slot];
+                    const void *const victim_key = bucket->keys[slot], *const victim_value = bucket->values[slot];
+                    cuckoo_store(bucket, slot, hash, key, value);
+                    hash = victim_hash;
+                    key = victim_key;
+                    value = victim_value;
+                    index = ALTERNATE(index, hash, grown->mask);
+                }
+            }
+        }
+
+    return grown;
+}
+
+/*
+ * Stores a mapping into an empty slot of a locked bucket.
+ * The key is stored last, so the slot only appears occupied once it is complete.
+ * Θ(1)
+ */
+static void cuckoo_store(cuckoo_Bucket* const bucket, const unsigned int slot,
+                         const unsigned int hash, const void* const key, const void* const value)
+{
+    bucket->hashes[slot] = hash;
+    bucket->values[slot] = value;
+    sync_store_ptr(&bucket->keys[slot], key);
+}
+
+/*
+ * Reads a consistent snapshot of a bucket's mappings, waiting out any writer which holds it.
+ * Returns the number of mappings in the snapshot.
+ * Θ(1)
+ */
+static unsigned int cuckoo_bucket_read(const CuckooTable* const table, const cuckoo_Bucket* const bucket,
+                                       const size_t index, const void** const keys, const void** const values)
+{
+    const cuckoo_Stripe* const stripe = &table->stripes[STRIPE(index)];
+    for (unsigned int attempt = 0; ; attempt++)
+    {
+        const LONG64 version = sync_load(&stripe->version);
+        if (!LOCKED(version))
+        {
+            unsigned int count = 0;
+            for (unsigned int i = 0; i < SLOTS; i++)
+            {
+                const void* const key = *(const void* volatile*)&bucket->keys[i];
+                if (key == NULL) continue;
+                keys[count] = key;
+                values[count++] = *(const void* volatile*)&bucket->values[i];
+            }
+
+            sync_load_fence();
+            if (sync_load(&stripe->version) == version)
+                return count;
+        }
+        sync_backoff(attempt);
+    }
+}
+
+/*
+ * Copies the next non-empty bucket into the iterator.
+ * Ω(1), O(c), where c is the capacity
+ */
+static void cuckoo_iter_load(cuckoo_Iterator* const iter)
+{
+    iter->index = iter->count = 0;
+    while (iter->count == 0 && iter->bucket <= iter->array->mask)
+    {
+        iter->count = cuckoo_bucket_read(iter->ref, &iter->array->buckets[iter->bucket],
+                                         iter->bucket, iter->keys, iter->values);
+        iter->bucket++;
+    }
+}
@@ -29,6 +29,9 @@ SOFTWARE.
 
 #include "../include/Dictionary.h"
 
+/* Smallest capacity of an attached filter. */
+#define FILTER_MIN_CAPACITY 16
+
 /* Node Colors.
  * RED and LEFT must be false for Calloc initialization */
 #define RED (bool)false
@@ -50,6 +53,8 @@ typedef struct dict_Node
 {
     const void *key, *value;
     struct dict_Node *left, *right, *parent;
+    /* Greatest interval end within the Node's subtree, maintained in interval mode. */
+    const void *max_end;
     bool color;
 } dict_Node;
 
@@ -58,6 +63,10 @@ struct Dictionary
 {
     dict_Node *root;
     size_t size;
+    /* Optional filter of the keys in the Dictionary, or NULL. */
+    BloomFilter *filter;
+    /* Removals since the filter was last re-built, each of which leaves stale bits behind. */
+    size_t filter_removals;
 
     /* Synchronization. */
     ReadWriteSync *rw_sync;
@@ -65,6 +74,8 @@ struct Dictionary
     /* Function pointers. */
     int(*compare)(const void*, const void*);
     char*(*toString)(const void*, const void*);
+    unsigned int(*hash)(const void*);
+    const void*(*end)(const void*, const void*);
 };
 
 /* Structure to assist in looping through Dictionary. */
@@ -73,8 +84,13 @@ struct dict_Iterator
     const dict_Node *current;
     Vector *stack;
 
-    /* Function pointer. */
+    /* Bounds of an overlap query. */
+    const void *low, *high;
+
+    /* Function pointers. */
     dict_Node*(*next)(dict_Iterator*);
+    int(*compare)(const void*, const void*);
+    const void*(*end)(const void*, const void*);
 };
 
 /* Local functions. */
@@ -82,7 +98,16 @@ static dict_Node* dict_Node_new(const void* const key, const void* const value);
 static void dict_Node_destroy(dict_Node* const node);
 static void dict_delete(Dictionary *const dict, dict_Node *const node);
 static dict_Node* dict_binary_search(const Dictionary* const dict, const void* const key, int* const compared);
+static dict_Node* dict_first_equal(const Dictionary* const dict, const void* const key);
 static dict_Node* dict_successor(const dict_Node* const node);
+static dict_Node* dict_next(const dict_Node* node);
+static void* dict_erase(Dictionary* const dict, dict_Node* located);
+static bool dict_filtered(const Dictionary* const dict, const void* const key);
+static void dict_filter_add(Dictionary* const dict, const void* const key);
+static void dict_filter_fill(Dictionary* const dict);
+static void dict_augment(const Dictionary* const dict, dict_Node* const node);
+static void dict_augment_path(const Dictionary* const dict, dict_Node* node);
+static void dict_augment_all(const Dictionary* const dict, dict_Node* const node);
 static dict_Node* dict_sibling(const dict_Node* const child);
 static dict_Node* dict_uncle(const dict_Node* const child);
 static unsigned int dict_height(const dict_Node *const node);
@@ -94,6 +119,10 @@ static dict_Node* dict_iter_next_node(dict_Iterator* const iter);
 static dict_Node* dict_iter_in_order(dict_Iterator* const iter);
 static dict_Node* dict_iter_pre_order(dict_Iterator* const iter);
 static dict_Node* dict_iter_post_order(dict_Iterator* const iter);
+static dict_Node* dict_iter_equal(dict_Iterator* const iter);
+static dict_Node* dict_iter_overlapping(dict_Iterator* const iter);
+static void dict_overlap_descend(dict_Iterator* const iter, const dict_Node* node);
+static void dict_overlap_seek(dict_Iterator* const iter);
 static void dict_heapify(const dict_Node* const current, const dict_Node** const arr, const unsigned int index);
 static void dict_print_tree(const Dictionary* const dict);
 
@@ -128,7 +157,7 @@ void* dict_get(const Dictionary* const dict, const void* const key)
     sync_read_start(dict->rw_sync);
 
     int compared;
-    const dict_Node* const searched = dict_binary_search(dict, key, &compared);
+    const dict_Node* const searched = dict_filtered(dict, key) ? NULL : dict_binary_search(dict, key, &compared);
     const void* const value = (searched != NULL && compared == 0) ? searched->value : NULL;
 
     /* Unlock the data structure. */
@@ -188,7 +217,8 @@ bool dict_contains(const Dictionary* const dict, const void* const key)
     sync_read_start(dict->rw_sync);
 
     int compared;
-    const bool located = dict_binary_search(dict, key, &compared) != NULL && compared == 0;
+    const bool located = !dict_filtered(dict, key) &&
+                         dict_binary_search(dict, key, &compared) != NULL && compared == 0;
 
     /* Unlock the data structure. */
     sync_read_end(dict->rw_sync);
@@ -196,6 +226,31 @@ bool dict_contains(const Dictionary* const dict, const void* const key)
     return located;
 }
 
+/*
+ * Returns the number of mappings in the Dictionary whose key matches the specified key.
+ * Θ(log(n) + k), where k is the number of mappings with the key
+ */
+size_t dict_count(const Dictionary* const dict, const void* const key)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    size_t count = 0;
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(dict->rw_sync);
+
+    /* Mappings with the same key are adjacent in order. */
+    for (const dict_Node* node = dict_filtered(dict, key) ? NULL : dict_first_equal(dict, key);
+         node != NULL && dict->compare(key, node->key) == 0; node = dict_next(node))
+        count++;
+
+    /* Unlock the data structure. */
+    sync_read_end(dict->rw_sync);
+
+    return count;
+}
+
 /*
  * Prints out the contents of the Dictionary to the console window.
  * Θ(n)
@@ -232,6 +287,7 @@ Dictionary* dict_clone(const Dictionary* const dict)
     io_assert(dict != NULL, IO_MSG_NULL_PTR);
 
     Dictionary* const copy = Dictionary_new(dict->compare, dict->toString);
+    copy->end = dict->end;
 
     /* Lock the data structure to future writers. */
     sync_read_start(dict->rw_sync);
@@ -242,13 +298,15 @@ Dictionary* dict_clone(const Dictionary* const dict)
     {
         void *value;
         const void* const key = dict_iter_next(iter, &value);
-        dict_put(copy, key, value);
+        dict_insert(copy, key, value);
     }
     dict_iter_destroy(iter);
 
     /* Unlock the data structure. */
     sync_read_end(dict->rw_sync);
 
+    if (dict->hash != NULL)
+        dict_filter(copy, dict->hash);
     return copy;
 }
 
@@ -281,20 +339,25 @@ void* dict_put(Dictionary *const dict, const void *const key, const void *const
         {
             node->color = BLACK;
             dict->root = node;
+            dict_augment_path(dict, node);
         }
         /* Insert the Node, then repair then enforce the Red/Black properties. */
         else
         {
             dict_assign_child(located, node, compared > 0);
+            dict_augment_path(dict, node);
             dict_red_red(dict, node);
         }
 
         dict->size++;
+        dict_filter_add(dict, key);
     }
     else
     {
         replaced = located->value;
         located->value = value;
+        /* The new value may end its interval elsewhere. */
+        dict_augment_path(dict, located);
     }
 
     /* Unlock the data structure. */
@@ -303,6 +366,53 @@ void* dict_put(Dictionary *const dict, const void *const key, const void *const
     return (void*)replaced;
 }
 
+/*
+ * Inserts a mapping into the Dictionary, even if the Dictionary already contains mappings with the same key.
+ * Mappings with the same key are kept beside one another in order, in the order they were inserted.
+ * Θ(log(n))
+ */
+void dict_insert(Dictionary* const dict, const void* const key, const void* const value)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+
+    dict_Node* const node = dict_Node_new(key, value);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(dict->rw_sync);
+
+    /* Ties go right-wards, placing the Node after every Node with the same key. */
+    dict_Node *parent = NULL, *current = dict->root;
+    bool direction = LEFT;
+    while (current != NULL)
+    {
+        parent = current;
+        direction = dict->compare(key, current->key) < 0 ? LEFT : RIGHT;
+        current = CHILD(current, direction);
+    }
+
+    /* Dictionary is empty, insert Node as the root. */
+    if (parent == NULL)
+    {
+        node->color = BLACK;
+        dict->root = node;
+        dict_augment_path(dict, node);
+    }
+    /* Insert the Node, then repair then enforce the Red/Black properties. */
+    else
+    {
+        dict_assign_child(parent, node, direction);
+        dict_augment_path(dict, node);
+        dict_red_red(dict, node);
+    }
+    dict->size++;
+    dict_filter_add(dict, key);
+
+    /* Unlock the data structure. */
+    sync_write_end(dict->rw_sync);
+}
+
 /*
  * Removes a mapping from the Dictionary whose key matches the specified key.
  * Returns the value of the removed mapping or NULL if no such mapping exists.
@@ -319,32 +429,86 @@ void* dict_remove(Dictionary *const dict, const void *const key)
     sync_write_start(dict->rw_sync);
 
     int compared;
-    dict_Node* located = dict_binary_search(dict, key, &compared);
+    dict_Node* const located = dict_binary_search(dict, key, &compared);
     /* If Node is located, then we can safely say that we will delete it. */
     if (located != NULL && compared == 0)
+        removed = dict_erase(dict, located);
+
+    /* Unlock the data structure. */
+    sync_write_end(dict->rw_sync);
+
+    return (void*)removed;
+}
+
+/*
+ * Removes every mapping whose key matches the specified key and returns the number removed.
+ * Θ((k + 1) * log(n)), where k is the number of mappings with the key
+ */
+size_t dict_remove_all(Dictionary* const dict, const void* const key)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    size_t removed = 0;
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(dict->rw_sync);
+
+    /* Deletion may re-arrange the tree, so each mapping is searched for from the root. */
+    for (dict_Node* located = dict_first_equal(dict, key); located != NULL; located = dict_first_equal(dict, key))
     {
-        /* Two children: find in-order successor, delete that one instead. */
-        if (located->left != NULL && located->right != NULL)
-        {
-            dict_Node* const successor = dict_successor(located);
-            located->key = successor->key;
-            located->value = successor->value;
-            located = successor;
-        }
+        dict_erase(dict, located);
+        removed++;
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(dict->rw_sync);
+
+    return removed;
+}
+
+/*
+ * Attaches a BloomFilter of the Dictionary's keys, or detaches it if `hash` is NULL.
+ * Θ(n)
+ */
+void dict_filter(Dictionary* const dict, unsigned int(*hash)(const void*))
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
 
-        if (COLOR(located) == BLACK && !ROOT(located))
-            dict_double_black(dict, located);
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(dict->rw_sync);
 
-        /* Remove the Node from the Dictionary. */
-        removed = located->value;
-        dict_delete(dict, located);
-        dict->size--;
+    dict->hash = hash;
+    if (hash != NULL)
+        dict_filter_fill(dict);
+    else if (dict->filter != NULL)
+    {
+        bloom_destroy(dict->filter);
+        dict->filter = NULL;
     }
 
     /* Unlock the data structure. */
     sync_write_end(dict->rw_sync);
+}
 
-    return (void*)removed;
+/*
+ * Switches the Dictionary into interval mode, or back out of it if `end` is NULL.
+ * Each Node is augmented with the greatest interval end within its subtree.
+ * Θ(n)
+ */
+void dict_interval(Dictionary* const dict, const void*(*end)(const void*, const void*))
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(dict->rw_sync);
+
+    dict->end = end;
+    if (end != NULL)
+        dict_augment_all(dict, dict->root);
+
+    /* Unlock the data structure. */
+    sync_write_end(dict->rw_sync);
 }
 
 /*
@@ -376,6 +540,11 @@ void dict_clear(Dictionary* const dict)
 
     dict->size = 0;
     dict->root = NULL;
+    if (dict->filter != NULL)
+    {
+        bloom_clear(dict->filter);
+        dict->filter_removals = 0;
+    }
 
     /* Unlock the data structure. */
     sync_write_end(dict->rw_sync);
@@ -388,6 +557,8 @@ void dict_clear(Dictionary* const dict)
 void dict_destroy(Dictionary* const dict)
 {
     dict_clear(dict);
+    if (dict->filter != NULL)
+        bloom_destroy(dict->filter);
     sync_destroy(dict->rw_sync);
     mem_free(dict, sizeof(Dictionary));
 }
@@ -423,6 +594,66 @@ dict_Iterator* dict_iter(const Dictionary* const dict, const enum dict_iter_trav
     return iter;
 }
 
+/*
+ * Constructs a new Iterator over only the mappings whose key matches the specified key.
+ * Θ(log(n))
+ */
+dict_Iterator* dict_iter_key(const Dictionary* const dict, const void* const key)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    dict_Iterator* const iter = mem_calloc(1, sizeof(dict_Iterator));
+
+    iter->stack = Vector_new(NULL, NULL);
+    iter->next = &dict_iter_equal;
+    iter->compare = dict->compare;
+
+    /* The Stack only ever holds the next mapping to be iterated. */
+    const dict_Node* const first = dict_filtered(dict, key) ? NULL : dict_first_equal(dict, key);
+    if (first != NULL)
+        vect_push_front(iter->stack, first);
+
+    return iter;
+}
+
+/*
+ * Constructs a new Iterator over only the mappings whose interval overlaps [low, high].
+ * Subtrees whose greatest end precedes `low` are skipped, as is everything starting after `high`.
+ * Θ(log(n))
+ */
+dict_Iterator* dict_iter_overlap(const Dictionary* const dict, const void* const low, const void* const high)
+{
+    io_assert(dict != NULL, IO_MSG_NULL_PTR);
+    io_assert(low != NULL, IO_MSG_NULL_PTR);
+    io_assert(high != NULL, IO_MSG_NULL_PTR);
+    io_assert(dict->end != NULL, IO_MSG_NOT_SUPPORTED);
+
+    dict_Iterator* const iter = mem_calloc(1, sizeof(dict_Iterator));
+
+    iter->stack = Vector_new(NULL, NULL);
+    iter->next = &dict_iter_overlapping;
+    iter->compare = dict->compare;
+    iter->end = dict->end;
+    iter->low = low;
+    iter->high = high;
+
+    /* The top of the Stack is the next mapping to be iterated, above the Nodes still to be explored. */
+    dict_overlap_descend(iter, dict->root);
+    dict_overlap_seek(iter);
+
+    return iter;
+}
+
+/*
+ * Constructs a new Iterator over only the mappings whose interval contains the specified point.
+ * Θ(log(n))
+ */
+dict_Iterator* dict_iter_stab(const Dictionary* const dict, const void* const point)
+{
+    return dict_iter_overlap(dict, point, point);
+}
+
 /*
  * Returns the iterator's current key/value pair and advances it forward.
  * The key will be returned and the value will be assigned to the data of the parameter.
@@ -545,6 +776,154 @@ dict_Node* dict_binary_search(const Dictionary* const dict, const void* const ke
     return NULL;
 }
 
+/*
+ * Returns the first Node in order whose key matches the specified key.
+ * Returns NULL if no such Node exists.
+ * Θ(log(n))
+ */
+static dict_Node* dict_first_equal(const Dictionary* const dict, const void* const key)
+{
+    const dict_Node *current = dict->root, *first = NULL;
+    while (current != NULL)
+    {
+        const int compared = key == current->key ? 0 : dict->compare(key, current->key);
+        /* Continue left-wards after a match, since an earlier match may remain. */
+        if (compared == 0)
+            first = current;
+        current = compared > 0 ? current->right : current->left;
+    }
+    return (dict_Node*)first;
+}
+
+/*
+ * Returns the Node which follows the specified Node in order, or NULL if it is the last.
+ * Ω(1), O(log(n))
+ */
+static dict_Node* dict_next(const dict_Node* node)
+{
+    if (node->right != NULL)
+        return dict_successor(node);
+    /* Climb until arriving from a left subtree. */
+    while (!ROOT(node) && DIRECTION(node, PARENT(node)) == RIGHT)
+        node = PARENT(node);
+    return PARENT(node);
+}
+
+/*
+ * Removes the specified Node's mapping from the Dictionary and returns its value.
+ * Note: The Dictionary must already be locked.
+ * Θ(log(n))
+ */
+static void* dict_erase(Dictionary* const dict, dict_Node* located)
+{
+    const void* const removed = located->value;
+
+    /* Two children: find in-order successor, delete that one instead. */
+    if (located->left != NULL && located->right != NULL)
+    {
+        dict_Node* const successor = dict_successor(located);
+        located->key = successor->key;
+        located->value = successor->value;
+        dict_augment_path(dict, located);
+        located = successor;
+    }
+
+    if (COLOR(located) == BLACK && !ROOT(located))
+        dict_double_black(dict, located);
+
+    /* Remove the Node from the Dictionary, then drop its interval from its ancestors. */
+    dict_Node* const parent = PARENT(located);
+    dict_delete(dict, located);
+    dict_augment_path(dict, parent);
+    dict->size--;
+
+    /* Clear out the stale bits once removals outnumber the mappings. */
+    if (dict->filter != NULL && ++dict->filter_removals > dict->size)
+        dict_filter_fill(dict);
+    return (void*)removed;
+}
+
+/*
+ * Returns true if the Dictionary's filter rules out the specified key.
+ * Θ(1)
+ */
+static bool dict_filtered(const Dictionary* const dict, const void* const key)
+{
+    return dict->filter != NULL && !bloom_contains(dict->filter, key);
+}
+
+/*
+ * Adds a newly inserted key to the Dictionary's filter, if it has one.
+ * The filter is re-built larger once the Dictionary out-grows it.
+ * Θ(1) amortized
+ */
+static void dict_filter_add(Dictionary* const dict, const void* const key)
+{
+    if (dict->filter == NULL) return;
+    if (dict->size > bloom_capacity(dict->filter))
+        dict_filter_fill(dict);
+    else bloom_add(dict->filter, key);
+}
+
+/*
+ * Re-builds the Dictionary's filter from only the keys in the Dictionary.
+ * The filter is sized to twice the number of mappings, leaving room to grow.
+ * Note: The Dictionary must already be locked, and its hash function defined.
+ * Θ(n)
+ */
+static void dict_filter_fill(Dictionary* const dict)
+{
+    if (dict->filter != NULL)
+        bloom_destroy(dict->filter);
+    const size_t capacity = dict->size * 2;
+    dict->filter = BloomFilter_new(capacity < FILTER_MIN_CAPACITY ? FILTER_MIN_CAPACITY : capacity, dict->hash);
+    dict->filter_removals = 0;
+
+    /* Walk the tree in order, starting from its left-most Node. */
+    const dict_Node *node = dict->root;
+    while (node != NULL && node->left != NULL)
+        node = node->left;
+    for (; node != NULL; node = dict_next(node))
+        bloom_add(dict->filter, node->key);
+}
+
+/*
+ * Re-computes the greatest interval end within the Node's subtree from its own interval and its children.
+ * Θ(1)
+ */
+static void dict_augment(const Dictionary* const dict, dict_Node* const node)
+{
+    const void *max_end = dict->end(node->key, node->value);
+    if (node->left != NULL && dict->compare(node->left->max_end, max_end) > 0)
+        max_end = node->left->max_end;
+    if (node->right != NULL && dict->compare(node->right->max_end, max_end) > 0)
+        max_end = node->right->max_end;
+    node->max_end = max_end;
+}
+
+/*
+ * Re-computes the greatest interval ends from the specified Node up to the root, if in interval mode.
+ * Θ(log(n))
+ */
+static void dict_augment_path(const Dictionary* const dict, dict_Node* node)
+{
+    if (dict->end == NULL) return;
+    for (; node != NULL; node = PARENT(node))
+        dict_augment(dict, node);
+}
+
+/*
+ * Re-computes the greatest interval ends of every Node in the specified subtree.
+ * Θ(n)
+ */
+static void dict_augment_all(const Dictionary* const dict, dict_Node* const node)
+{
+    if (node == NULL) return;
+    dict_augment_all(dict, node->left);
+    dict_augment_all(dict, node->right);
+    dict_augment(dict, node);
+}
+
 /*
  * Returns the successor of the specified Node.
  * The success is the left-most Node in the right subtree.
@@ -618,6 +997,13 @@ void dict_rotate(Dictionary *const dict, dict_Node *const child, dict_Node *cons
     const bool rotate_dir = DIRECTION(child, parent);
     dict_assign_child(parent, CHILD(child, !rotate_dir), rotate_dir);
     dict_assign_child(child, parent, !rotate_dir);
+
+    /* The parent is now below the child, so it is re-computed first. */
+    if (dict->end != NULL)
+    {
+        dict_augment(dict, parent);
+        dict_augment(dict, child);
+    }
 }
 
 /*
@@ -795,6 +1181,75 @@ dict_Node* dict_iter_in_order(dict_Iterator* const iter)
     return (dict_Node*)iterated;
 }
 
+/*
+ * Iterates the next mapping which shares the key of the previous one.
+ * Ω(1), O(log(n))
+ */
+static dict_Node* dict_iter_equal(dict_Iterator* const iter)
+{
+    const dict_Node* const iterated = vect_front(iter->stack);
+    vect_pop_front(iter->stack);
+
+    /* Mappings with the same key are adjacent in order. */
+    const dict_Node* const next = dict_next(iterated);
+    if (next != NULL && iter->compare(next->key, iterated->key) == 0)
+        vect_push_front(iter->stack, next);
+
+    return (dict_Node*)iterated;
+}
+
+/*
+ * Iterates the next mapping whose interval overlaps the query, then seeks out the one after it.
+ * Ω(1), O(log(n))
+ */
+static dict_Node* dict_iter_overlapping(dict_Iterator* const iter)
+{
+    const dict_Node* const iterated = vect_front(iter->stack);
+    vect_pop_front(iter->stack);
+    dict_overlap_seek(iter);
+    return (dict_Node*)iterated;
+}
+
+/*
+ * Pushes the left spine of the specified subtree, stopping at any subtree which ends before the query.
+ * Θ(log(n))
+ */
+static void dict_overlap_descend(dict_Iterator* const iter, const dict_Node* node)
+{
+    while (node != NULL && iter->compare(node->max_end, iter->low) >= 0)
+    {
+        vect_push_front(iter->stack, node);
+        node = node->left;
+    }
+}
+
+/*
+ * Explores the Stack in order until a Node overlapping the query is found, leaving it on top.
+ * Since Nodes are ordered by start, the search ends at the first Node starting after the query.
+ * Ω(1), O(log(n)) amortized per mapping iterated
+ */
+static void dict_overlap_seek(dict_Iterator* const iter)
+{
+    while (!vect_empty(iter->stack))
+    {
+        const dict_Node* const node = vect_front(iter->stack);
+        vect_pop_front(iter->stack);
+
+        if (iter->compare(node->key, iter->high) > 0)
+        {
+            vect_clear(iter->stack);
+            return;
+        }
+
+        dict_overlap_descend(iter, node->right);
+        if (iter->compare(iter->end(node->key, node->value), iter->low) >= 0)
+        {
+            vect_push_front(iter->stack, node);
+            return;
+        }
+    }
+}
+
 /*
  * Iterates the next element using pre-order traversal.
  * Θ(1)
@@ -29,20 +29,50 @@ SOFTWARE.
 
 #include "../include/HashTable.h"
 #include <math.h>
+#include <limits.h>
 
 /* Array capacity components. */
 #define DEFAULT_INITIAL_CAPACITY 16
 #define LOAD_FACTOR 0.75f
 #define GROW_FACTOR 2
+/* Tables grow by half of their capacity rather than doubling, since capacities need not be powers of two. */
+#define GROWN_CAPACITY(capacity) ((capacity) + (capacity) / 2)
+
+/* Bucket of a hash. Buckets split the range of hashes into equal, ordered intervals. */
+#define BUCKET(hash, capacity) MATH_FASTRANGE(hash, capacity)
+/* Number of entries which a Table of the specified capacity can hold. */
+#define DESIGN_LOAD(capacity) ((size_t)((capacity) * LOAD_FACTOR))
+/* Marks an empty bucket or the end of a bucket's chain. */
+#define TABLE_END UINT_MAX
+/* Chains longer than this are converted into a tree bin. */
+#define TREEIFY_THRESHOLD 8
+/* Tree bins smaller than this are converted back into a chain. */
+#define UNTREEIFY_THRESHOLD 6
+/* Bucket flag which marks the remaining bits as the index of a tree bin. */
+#define TABLE_BIN ((unsigned int)1 << (sizeof(unsigned int) * CHAR_BIT - 1))
+#define IS_BIN(bucket) ((bucket) != TABLE_END && ((bucket) & TABLE_BIN))
+/* Height of a tree bin node, where an empty subtree has a height of 0. */
+#define HEIGHT(bin, node) ((node) == TABLE_END ? 0 : (bin)->nodes[node].height)
 
-/* Modulus of (a, b) where b is a positive base 2 integer. */
-#define MODULUS(operand, base_2_num) (operand & (base_2_num - 1))
-
-/* HashTable structure. */
+/*
+ * HashTable structure.
+ * Entries are stored densely in insertion order, while buckets only store the index of an entry.
+ * Removed entries leave a hole which is reclaimed the next time the entries are compacted.
+ */
 struct HashTable
 {
-    struct table_Bucket **buckets;
+    struct table_Entry *entries;
+    unsigned int *buckets;
     size_t capacity, size;
+    /* Number of entries in use, including holes. */
+    size_t used;
+    /* Tree bins which replace overly long chains. */
+    struct table_Bin *bins;
+    size_t bin_count, bin_capacity;
+    /* Mixed into every hash. */
+    unsigned int seed;
+    /* Optional filter of the hashes in the Table, or NULL. */
+    BloomFilter *filter;
 
     /* Synchronization. */
     ReadWriteSync *rw_sync;
@@ -51,36 +81,87 @@ struct HashTable
     bool(*equals)(const void*, const void*);
     unsigned int(*hash)(const void*);
     char*(*toString)(const void*, const void*);
+    /* Optional; orders keys which share a hash within tree bins. */
+    int(*compare)(const void*, const void*);
 };
 
-/* Bucket structure. */
-typedef struct table_Bucket
+/* Entry structure. A hole has a NULL key. */
+typedef struct table_Entry
 {
     const void *key, *value;
-    struct table_Bucket *next;
     unsigned int hash;
-} table_Bucket;
+    /* Index of the next entry in the same bucket. */
+    unsigned int next;
+} table_Entry;
+
+/*
+ * Tree bin structure.
+ * An AVL tree of entries ordered by hash, then by key if the Table can compare keys, then by entry index,
+ * for a bucket whose chain grew too long.
+ * Nodes are pooled in an array and freed nodes are kept in a list threaded through `left`.
+ */
+typedef struct table_Bin
+{
+    struct table_Node *nodes;
+    unsigned int root, free;
+    unsigned int count, used, capacity;
+    /* Index of the bucket which refers to this bin. */
+    unsigned int bucket;
+} table_Bin;
+
+/* Tree bin node structure. A freed node has an entry of TABLE_END. */
+typedef struct table_Node
+{
+    unsigned int entry;
+    unsigned int left, right;
+    unsigned int height;
+} table_Node;
 
 /* Structure to assist in looping through Table. */
 struct table_Iterator
 {
-    /* Keep track of where we are inside the Table. */
-    unsigned int index;
-    const table_Bucket *current;
-    size_t visited;
+    /* Index of the next entry to be iterated. */
+    size_t index;
     /* Reference to the Table that it is iterating through. */
     const HashTable *ref;
+    /* Key whose mappings are iterated, or NULL to iterate every mapping. */
+    const void *key;
+    unsigned int hash;
 };
 
 /* Local functions. */
-static table_Bucket* table_Bucket_new(const void* const key, void* const value, const unsigned int hash);
-static table_Bucket* table_iter_next_bucket(table_Iterator* const iter);
-static table_Bucket* table_search(const HashTable* const table, const void* const key,
-                                  const unsigned int hash, bool* const found);
-static void table_Bucket_destroy(table_Bucket* const bucket);
-static bool table_design_load(const HashTable* const table);
-static bool table_Bucket_match(const table_Bucket* const bucket, const void* const key, const unsigned int hash,
-                               bool(*equals)(const void*, const void*));
+static unsigned int table_search(const HashTable* const table, const void* const key, const unsigned int hash);
+static unsigned int table_search_from(const HashTable* const table, const void* const key,
+                                      const unsigned int hash, const size_t from);
+static unsigned int table_hash(const HashTable* const table, const void* const key);
+static void table_add(HashTable* const table, const void* const key, const void* const value,
+                      const unsigned int hash);
+static void table_delete(HashTable* const table, const unsigned int index);
+static void table_link(HashTable* const table, const unsigned int index);
+static void table_unlink_all(HashTable* const table);
+static void table_compact(HashTable* const table);
+static void table_rebuild(HashTable* const table, const size_t capacity);
+static void table_filter_fill(HashTable* const table);
+static void table_iter_skip(table_Iterator* const iter);
+static bool table_Entry_match(const table_Entry* const entry, const void* const key, const unsigned int hash,
+                              bool(*equals)(const void*, const void*));
+static bool table_chain_long(const HashTable* const table, unsigned int index);
+static void table_treeify(HashTable* const table, const size_t bucket);
+static void table_treeify_all(HashTable* const table);
+static void table_untreeify(HashTable* const table, const unsigned int bin_index);
+static unsigned int table_bin_search(const HashTable* const table, const table_Bin* const bin, unsigned int node,
+                                     const void* const key, const unsigned int hash);
+static unsigned int table_bin_ceiling(const HashTable* const table, const table_Bin* const bin,
+                                      const void* const key, const unsigned int hash, const size_t from);
+static void table_bin_add(const HashTable* const table, table_Bin* const bin, const unsigned int entry);
+static unsigned int table_bin_insert(const HashTable* const table, table_Bin* const bin,
+                                     const unsigned int node, const unsigned int inserted);
+static unsigned int table_bin_delete(const HashTable* const table, table_Bin* const bin,
+                                     const unsigned int node, const unsigned int entry);
+static unsigned int table_bin_balance(table_Bin* const bin, const unsigned int node);
+static unsigned int table_bin_rotate(table_Bin* const bin, const unsigned int node, const bool left);
+static void table_bin_height(table_Bin* const bin, const unsigned int node);
+static bool table_bin_before(const HashTable* const table, const unsigned int a, const unsigned int b);
 
 /*
  * Constructor function.
@@ -96,8 +177,10 @@ HashTable* HashTable_new(unsigned int(*hash)(const void*),
     io_assert(equals != NULL, IO_MSG_NOT_SUPPORTED);
 
     HashTable* const table = mem_calloc(1, sizeof(HashTable));
-    /* Note: Capacity must always be a power of 2. */
-    table->buckets = mem_calloc(DEFAULT_INITIAL_CAPACITY, sizeof(table_Bucket*));
+    /* Note: Capacity is never below the default, and need not be a power of 2, as buckets use fast range reduction. */
+    table->buckets = mem_malloc(DEFAULT_INITIAL_CAPACITY * sizeof(unsigned int));
+    memset(table->buckets, 0xFF, DEFAULT_INITIAL_CAPACITY * sizeof(unsigned int));
+    table->entries = mem_calloc(DESIGN_LOAD(DEFAULT_INITIAL_CAPACITY), sizeof(table_Entry));
     table->capacity = DEFAULT_INITIAL_CAPACITY;
     table->hash = hash;
     table->equals = equals;
@@ -121,9 +204,8 @@ void* table_get(const HashTable* const table, const void* const key)
     /* Lock the data structure to future writers. */
     sync_read_start(table->rw_sync);
 
-    bool exists;
-    const table_Bucket *bucket = table_search(table, key, table->hash(key), &exists);
-    if (exists) value = bucket->value;
+    const unsigned int index = table_search(table, key, table_hash(table, key));
+    if (index != TABLE_END) value = table->entries[index].value;
 
     /* Unlock the data structure. */
     sync_read_end(table->rw_sync);
@@ -181,8 +263,7 @@ bool table_contains(const HashTable* const table, const void* const key)
     /* Lock the data structure to future writers. */
     sync_read_start(table->rw_sync);
 
-    bool exists;
-    table_search(table, key, table->hash(key), &exists);
+    const bool exists = table_search(table, key, table_hash(table, key)) != TABLE_END;
 
     /* Unlock the data structure. */
     sync_read_end(table->rw_sync);
@@ -190,8 +271,35 @@ bool table_contains(const HashTable* const table, const void* const key)
     return exists;
 }
 
+/*
+ * Returns the number of mappings in the Table whose key matches the specified key.
+ * Ω(1), O(k*log(n)), where k is the number of mappings with the key
+ */
+size_t table_count(const HashTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    size_t count = 0;
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    const unsigned int hash = table_hash(table, key);
+
+    for (unsigned int index = table_search_from(table, key, hash, 0); index != TABLE_END;
+         index = table_search_from(table, key, hash, (size_t)index + 1))
+        count++;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return count;
+}
+
 /*
  * Prints out the contents of the Table to the console window.
+ * Mappings are printed in the order they were inserted.
  * Θ(n)
  */
 void table_print(const HashTable* const table)
@@ -218,6 +326,7 @@ void table_print(const HashTable* const table)
 
 /*
  * Returns a shallow copy of the Table.
+ * The copy has the same capacity, and its entries are copied without re-hashing their keys.
  * Θ(n)
  */
 HashTable* table_clone(const HashTable* const table)
@@ -229,15 +338,23 @@ HashTable* table_clone(const HashTable* const table)
     /* Lock the data structure to future writers. */
     sync_read_start(table->rw_sync);
 
-    /* The new table needs to have the same capacity as the old one. */
-    table_resize(copy, table->capacity);
-    table_Iterator* const iter = table_iter(table);
-    while (table_iter_has_next(iter))
+    /* The copy is private to this thread, so it can be built without locking it. */
+    copy->seed = table->seed;
+    copy->compare = table->compare;
+    table_rebuild(copy, table->capacity);
+    for (size_t i = 0; i < table->used; i++)
+        if (table->entries[i].key != NULL)
+        {
+            copy->entries[copy->used] = table->entries[i];
+            table_link(copy, (unsigned int)copy->used++);
+        }
+    copy->size = table->size;
+    table_treeify_all(copy);
+    if (table->filter != NULL)
     {
-        void *value, *key = table_iter_next(iter, &value);
-        table_put(copy, key, value);
+        copy->filter = BloomFilter_new(DESIGN_LOAD(copy->capacity), NULL);
+        table_filter_fill(copy);
     }
-    table_iter_destroy(iter);
 
     /* Unlock the data structure. */
     sync_read_end(table->rw_sync);
@@ -245,6 +362,86 @@ HashTable* table_clone(const HashTable* const table)
     return copy;
 }
 
+/*
+ * Returns the key of a mapping chosen uniformly at random, storing its value into `value` if non-NULL.
+ * Entries are dense, so random entries are drawn until one is not a hole.
+ * Compaction keeps holes from outnumbering the mappings, so at most two draws are expected.
+ * Θ(1) expected
+ */
+void* table_random(const HashTable* const table, void** const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    io_assert(table->size > 0, IO_MSG_EMPTY);
+
+    const table_Entry* entry;
+    do entry = &table->entries[rand_limit((unsigned int)table->used)];
+    while (entry->key == NULL);
+
+    if (value != NULL)
+        *value = (void*)entry->value;
+    const void* const key = entry->key;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return (void*)key;
+}
+
+/*
+ * Visits the mappings of up to `count` buckets, starting at the bucket which the cursor points to.
+ * Returns the cursor to resume the scan from, or 0 once the scan is complete.
+ *
+ * The cursor is the lowest hash which has not been visited yet.
+ * Buckets hold ordered intervals of hashes at any capacity, so every mapping below the cursor was already
+ * visited, and the mappings of the cursor's bucket which lie below the cursor can be skipped.
+ * Ω(count), O(count + n)
+ */
+size_t table_scan(const HashTable* const table, size_t cursor, size_t count,
+                  void(*visit)(const void*, const void*, void*), void* const data)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(visit != NULL, IO_MSG_NOT_SUPPORTED);
+    io_assert(count > 0, IO_MSG_INVALID_SIZE);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    const size_t capacity = table->capacity;
+    do
+    {
+        const size_t index = BUCKET(cursor, capacity);
+        const unsigned int bucket = table->buckets[index];
+        if (IS_BIN(bucket))
+        {
+            const table_Bin* const bin = &table->bins[bucket & ~TABLE_BIN];
+            for (unsigned int i = 0; i < bin->used; i++)
+                if (bin->nodes[i].entry != TABLE_END)
+                {
+                    const table_Entry* const entry = &table->entries[bin->nodes[i].entry];
+                    if (entry->hash >= cursor)
+                        visit(entry->key, entry->value, data);
+                }
+        }
+        else for (unsigned int i = bucket; i != TABLE_END; i = table->entries[i].next)
+            if (table->entries[i].hash >= cursor)
+                visit(table->entries[i].key, table->entries[i].value, data);
+
+        /* Advance to the lowest hash of the next bucket, or finish after the last bucket. */
+        if (index + 1 == capacity)
+            cursor = 0;
+        else cursor = (size_t)((((unsigned long long)(index + 1) << 32) + capacity - 1) / capacity);
+    } while (cursor != 0 && --count > 0);
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return cursor;
+}
+
 /*
  * Inserts a mapping into the Table.
  * If the Table already contained a mapping for the key, the old value is replaced.
@@ -258,33 +455,19 @@ void* table_put(HashTable* const table, const void* const key, const void* const
     io_assert(value != NULL, IO_MSG_NULL_PTR);
 
     const void *replaced = NULL;
-    const unsigned int hash = table->hash(key);
 
     /* Lock the data structure to future readers/writers. */
     sync_write_start(table->rw_sync);
 
-    /* Expand the Table automatically if we are at design load. */
-    if (table_design_load(table))
-        table_resize(table, table->capacity * GROW_FACTOR);
-
-    bool already_exists;
-    table_Bucket* const located = table_search(table, key, hash, &already_exists);
-    if (!already_exists)
-    {
-        table_Bucket* const inserted = table_Bucket_new(key, (void*)value, hash);
-        /* Check if a collision occurred. */
-        if (located != NULL)
-            located->next = inserted;
-        /* This is a new bucket, place it directly into the array. */
-        else table->buckets[MODULUS(hash, table->capacity)] = inserted;
-
-        table->size++;
-    }
+    const unsigned int hash = table_hash(table, key);
+    const unsigned int located = table_search(table, key, hash);
+    if (located == TABLE_END)
+        table_add(table, key, value, hash);
     /* Duplicate key entered; update the value. */
     else
     {
-        replaced = located->value;
-        located->value = value;
+        replaced = table->entries[located].value;
+        table->entries[located].value = value;
     }
 
     /* Unlock the data structure. */
@@ -293,8 +476,29 @@ void* table_put(HashTable* const table, const void* const key, const void* const
     return (void*)replaced;
 }
 
+/*
+ * Inserts a mapping into the Table, even if the Table already contains mappings with the same key.
+ * Mappings of the same key are chained in place alongside one another, needing no container of their own.
+ * Θ(1) amortized
+ */
+void table_insert(HashTable* const table, const void* const key, const void* const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    table_add(table, key, value, table_hash(table, key));
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+}
+
 /*
  * Removes a key/value pair from the Table and returns true if the removal was successful.
+ * The removed entry leaves a hole, which is reclaimed once holes outnumber the mappings.
  * Ω(1), O(n)
  */
 bool table_remove(HashTable* const table, const void* const key)
@@ -302,32 +506,50 @@ bool table_remove(HashTable* const table, const void* const key)
     io_assert(table != NULL, IO_MSG_NULL_PTR);
     io_assert(key != NULL, IO_MSG_NULL_PTR);
 
-    const unsigned int hash = table->hash(key);
-    bool removed = false;
-
     /* Lock the data structure to future readers/writers. */
     sync_write_start(table->rw_sync);
 
-    /* Iterate over the bucket chain at the hashed index. */
-    const unsigned int index = MODULUS(hash, table->capacity);
-    table_Bucket *prev = NULL, *current = table->buckets[index];
-    while (current != NULL)
+    const unsigned int index = table_search(table, key, table_hash(table, key));
+    const bool removed = index != TABLE_END;
+    if (removed)
     {
-        removed = table_Bucket_match(current, key, hash, table->equals);
-        if (removed)
-        {
-            /* Determine if this bucket is root of the chain. */
-            if (prev != NULL)
-                prev->next = current->next;
-            else table->buckets[index] = NULL;
-            table_Bucket_destroy(current);
-            table->size--;
-            break;
-        }
+        table_delete(table, index);
+        if (table->used - table->size > table->size)
+            table_compact(table);
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return removed;
+}
+
+/*
+ * Removes every mapping whose key matches the specified key and returns the number removed.
+ * Holes are reclaimed once, after every mapping has been removed.
+ * Ω(k), O(k*log(n)), where k is the number of mappings with the key
+ */
+size_t table_remove_all(HashTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    size_t removed = 0;
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
 
-        prev = current;
-        current = current->next;
+    const unsigned int hash = table_hash(table, key);
+
+    /* Removals leave holes rather than moving entries, so the search resumes past each removed entry. */
+    for (unsigned int index = table_search_from(table, key, hash, 0); index != TABLE_END;
+         index = table_search_from(table, key, hash, (size_t)index + 1))
+    {
+        table_delete(table, index);
+        removed++;
     }
+    if (table->used - table->size > table->size)
+        table_compact(table);
 
     /* Unlock the data structure. */
     sync_write_end(table->rw_sync);
@@ -339,8 +561,8 @@ bool table_remove(HashTable* const table, const void* const key)
  * Changes the Table's capacity to accommodate at least the specified number of mappings.
  * This function can be used both to grow and shrink the Table.
  * Specified sizes which are less than the amount of mappings are ignored.
- * The final capacity will always be of the form x * y^n,
- * where x is the default initial capacity, y is the grow factor.
+ * The final capacity is the smallest which holds the specified number of mappings under the load factor,
+ * and is never less than the default initial capacity.
  * Ω(1), O(n)
  */
 void table_resize(HashTable *const table, const size_t min_size)
@@ -350,39 +572,81 @@ void table_resize(HashTable *const table, const size_t min_size)
     /* Lock the data structure to future readers/writers. */
     sync_write_start(table->rw_sync);
 
-    /* Capacities must adhere to the load factor, grow factor, and default initial capacity. */
-    size_t desired_capacity = (size_t)(min_size / (double)LOAD_FACTOR);
-    if (desired_capacity > DEFAULT_INITIAL_CAPACITY)
-        /* Capacity becomes the nth power of the grow factor times the default initial capacity. */
-        desired_capacity = DEFAULT_INITIAL_CAPACITY * math_min_power_gt(
-                GROW_FACTOR, MATH_DIV_CEIL(desired_capacity, DEFAULT_INITIAL_CAPACITY));
-    else desired_capacity = DEFAULT_INITIAL_CAPACITY;
+    /* Capacities must adhere to the load factor and default initial capacity. */
+    size_t desired_capacity = (size_t)ceil(min_size / (double)LOAD_FACTOR);
+    if (desired_capacity < DEFAULT_INITIAL_CAPACITY)
+        desired_capacity = DEFAULT_INITIAL_CAPACITY;
+    /* Rounding may leave the design load one short. */
+    while (DESIGN_LOAD(desired_capacity) < min_size)
+        desired_capacity++;
 
-    /* No need to expand if the table if there is no size improvement. */
-    if (desired_capacity > table->size)
-    {
-        /* Create a temporary Table on the Stack. */
-        HashTable expanded =
-        {
-            mem_calloc(desired_capacity, sizeof(table_Bucket*)), desired_capacity, 0,
-            table->rw_sync, table->equals, table->hash, table->toString
-        };
+    /* The new capacity must still be able to hold every mapping. */
+    if (DESIGN_LOAD(desired_capacity) >= table->size)
+        table_rebuild(table, desired_capacity);
 
-        /* Re-hash all key/value pairs into the new Table's array. */
-        table_Iterator* const iter = table_iter(table);
-        while (table_iter_has_next(iter))
-        {
-            table_Bucket* const bucket = table_iter_next_bucket(iter);
-            table_put(&expanded, bucket->key, bucket->value);
-            table_Bucket_destroy(bucket);
-        }
-        table_iter_destroy(iter);
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+}
+
+/*
+ * Mixes a seed into the hashes of the Table's keys, then re-hashes every mapping.
+ * Θ(n + c), where c is the capacity
+ */
+void table_seed(HashTable* const table, const unsigned int seed)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
 
-        /* Destroy the old array and replace it with the expanded one. */
-        mem_free(table->buckets, table->capacity * sizeof(table_Bucket*));
-        table->buckets = expanded.buckets;
-        table->capacity = desired_capacity;
-        /* The expanded table was made on the stack, so no need to destroy it. */
+    table->seed = seed;
+    for (size_t i = 0; i < table->used; i++)
+        if (table->entries[i].key != NULL)
+            table->entries[i].hash = table_hash(table, table->entries[i].key);
+    table_rebuild(table, table->capacity);
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+}
+
+/*
+ * Sets the function which orders keys sharing a hash, then re-builds the Table's tree bins in that order.
+ * Θ(n + c), where c is the capacity
+ */
+void table_compare(HashTable* const table, int(*compare)(const void*, const void*))
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    table->compare = compare;
+    table_rebuild(table, table->capacity);
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+}
+
+/*
+ * Attaches or detaches a BloomFilter of the Table's keys.
+ * Θ(n + c), where c is the capacity
+ */
+void table_filter(HashTable* const table, const bool enabled)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    if (enabled && table->filter == NULL)
+    {
+        table->filter = BloomFilter_new(DESIGN_LOAD(table->capacity), NULL);
+        table_filter_fill(table);
+    }
+    else if (!enabled && table->filter != NULL)
+    {
+        bloom_destroy(table->filter);
+        table->filter = NULL;
     }
 
     /* Unlock the data structure. */
@@ -400,29 +664,30 @@ void table_clear(HashTable* const table)
     /* Lock the data structure to future readers/writers. */
     sync_write_start(table->rw_sync);
 
-    table_Iterator* const iter = table_iter(table);
-    while (table_iter_has_next(iter))
-        table_Bucket_destroy(table_iter_next_bucket(iter));
-    /* NULL out the memory inside the Table for future use. */
-    memset(table->buckets, 0, sizeof(table_Bucket*) * table->capacity);
-    table->size = 0;
+    table_unlink_all(table);
+    table->used = table->size = 0;
+    if (table->filter != NULL)
+        bloom_clear(table->filter);
 
     /* Unlock the data structure. */
     sync_write_end(table->rw_sync);
-
-    table_iter_destroy(iter);
 }
 
 /*
  * De-constructor function.
- * Θ(n)
+ * Θ(1)
  */
 void table_destroy(HashTable* const table)
 {
     io_assert(table != NULL, IO_MSG_NULL_PTR);
 
-    table_clear(table);
-    mem_free(table->buckets, table->capacity * sizeof(table_Bucket*));
+    table_unlink_all(table);
+    if (table->filter != NULL)
+        bloom_destroy(table->filter);
+    if (table->bins != NULL)
+        mem_free(table->bins, table->bin_capacity * sizeof(table_Bin));
+    mem_free(table->entries, DESIGN_LOAD(table->capacity) * sizeof(table_Entry));
+    mem_free(table->buckets, table->capacity * sizeof(unsigned int));
     sync_destroy(table->rw_sync);
     mem_free(table, sizeof(HashTable));
 }
@@ -438,6 +703,25 @@ table_Iterator* table_iter(const HashTable* const table)
     table_Iterator* const iter = mem_calloc(1, sizeof(table_Iterator));
 
     iter->ref = table;
+    table_iter_skip(iter);
+    return iter;
+}
+
+/*
+ * Constructs a new Iterator over only the mappings whose key matches the specified key.
+ * Ω(1), O(log(n))
+ */
+table_Iterator* table_iter_key(const HashTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    table_Iterator* const iter = mem_calloc(1, sizeof(table_Iterator));
+
+    iter->ref = table;
+    iter->key = key;
+    iter->hash = table_hash(table, key);
+    table_iter_skip(iter);
     return iter;
 }
 
@@ -451,25 +735,22 @@ void* table_iter_next(table_Iterator* const iter, void **value)
     io_assert(iter != NULL, IO_MSG_NULL_PTR);
     io_assert(table_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
 
-    const table_Bucket* const current = table_iter_next_bucket(iter);
+    const table_Entry* const current = &iter->ref->entries[iter->index++];
     *value = (void*)current->value;
+    table_iter_skip(iter);
 
     return (void*)current->key;
 }
 
 /*
  * Returns true if the iterator has a next key/value pair.
- * Ω(1), O(n)
+ * Θ(1)
  */
 bool table_iter_has_next(const table_Iterator* const iter)
 {
     io_assert(iter != NULL, IO_MSG_NULL_PTR);
-    /* If we've visited all the pairs, there are no more to iterate over. */
-    if (iter->visited >= iter->ref->size) return false;
-    const table_Bucket *current = iter->current;
-    for (unsigned int i = iter->index; current == NULL && i < iter->ref->capacity; i++)
-        current = iter->ref->buckets[i];
-    return current != NULL;
+    /* The iterator never rests on a hole, so any remaining entry is a mapping. */
+    return iter->index < iter->ref->used;
 }
 
 /*
@@ -483,96 +764,594 @@ void table_iter_destroy(table_Iterator* const iter)
 }
 
 /*
- * Constructor function.
- * Θ(1)
+ * Returns the index of an entry whose key matches the specified key.
+ * If no such entry exists, TABLE_END is returned.
+ * Ω(1), O(log(n) + m), where m is the number of keys sharing the hash, or O(log(n)) if keys can be compared
  */
-table_Bucket* table_Bucket_new(const void* const key, void* const value, const unsigned int hash)
+static unsigned int table_search(const HashTable* const table, const void* const key, const unsigned int hash)
 {
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
     io_assert(key != NULL, IO_MSG_NULL_PTR);
-    io_assert(value != NULL, IO_MSG_NULL_PTR);
 
-    table_Bucket* const bucket = mem_calloc(1, sizeof(table_Bucket));
-    bucket->key = key;
-    bucket->value = value;
-    bucket->hash = hash;
-    return bucket;
+    /* The filter rules out most missing keys without touching the buckets. */
+    if (table->filter != NULL && !bloom_contains_hash(table->filter, hash))
+        return TABLE_END;
+
+    unsigned int current = table->buckets[BUCKET(hash, table->capacity)];
+    if (IS_BIN(current))
+    {
+        const table_Bin* const bin = &table->bins[current & ~TABLE_BIN];
+        current = table_bin_search(table, bin, bin->root, key, hash);
+    }
+    else while (current != TABLE_END && !table_Entry_match(&table->entries[current], key, hash, table->equals))
+        current = table->entries[current].next;
+
+    return current;
 }
 
 /*
- * Returns the iterator's current bucket and advances it forward.
- * Ω(1), O(n)
+ * Returns the lowest index, no less than `from`, of an entry whose key matches the specified key.
+ * Entry indices follow insertion order, so repeated searches visit a key's mappings in that order.
+ * If no such entry exists, TABLE_END is returned.
+ * Ω(1), O(log(n) + m), where m is the number of keys sharing the hash, or O(log(n) + k) if keys can be compared,
+ * where k is the number of mappings with the key
  */
-table_Bucket* table_iter_next_bucket(table_Iterator* const iter)
+static unsigned int table_search_from(const HashTable* const table, const void* const key,
+                                      const unsigned int hash, const size_t from)
 {
-    io_assert(iter != NULL, IO_MSG_NULL_PTR);
-    io_assert(table_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+    if (table->filter != NULL && !bloom_contains_hash(table->filter, hash))
+        return TABLE_END;
 
-    while (iter->current == NULL && iter->index < iter->ref->capacity)
-        iter->current = iter->ref->buckets[iter->index++];
+    unsigned int current = table->buckets[BUCKET(hash, table->capacity)];
+    if (IS_BIN(current))
+    {
+        /* Bins are ordered by hash, then key if possible, then index, so searches resume at the first candidate. */
+        const table_Bin* const bin = &table->bins[current & ~TABLE_BIN];
+        current = table_bin_ceiling(table, bin, key, hash, from);
+        while (current != TABLE_END && table->entries[current].hash == hash &&
+               (table->compare == NULL || table->compare(key, table->entries[current].key) == 0))
+        {
+            if (table_Entry_match(&table->entries[current], key, hash, table->equals))
+                return current;
+            current = table_bin_ceiling(table, bin, key, hash, (size_t)current + 1);
+        }
+        return TABLE_END;
+    }
+
+    /* Chains are short, so the whole chain is checked for the lowest match. */
+    unsigned int lowest = TABLE_END;
+    for (; current != TABLE_END; current = table->entries[current].next)
+        if (current >= from && current < lowest &&
+            table_Entry_match(&table->entries[current], key, hash, table->equals))
+            lowest = current;
+    return lowest;
+}
+
+/*
+ * Links the entry at the specified index into the front of its bucket's chain.
+ * Θ(1)
+ */
+static void table_link(HashTable* const table, const unsigned int index)
+{
+    table_Entry* const entry = &table->entries[index];
+    unsigned int* const bucket = &table->buckets[BUCKET(entry->hash, table->capacity)];
+    if (IS_BIN(*bucket))
+        table_bin_add(table, &table->bins[*bucket & ~TABLE_BIN], index);
+    else
+    {
+        entry->next = *bucket;
+        *bucket = index;
+    }
+}
+
+/*
+ * Appends a new entry for a mapping, then links it into its bucket.
+ * Note: The Table must already be locked.
+ * Θ(1) amortized
+ */
+static void table_add(HashTable* const table, const void* const key, const void* const value,
+                      const unsigned int hash)
+{
+    /* Out of entries; reclaim the holes, or expand the Table if they are too few. */
+    if (table->used >= DESIGN_LOAD(table->capacity))
+    {
+        if (table->size >= DESIGN_LOAD(table->capacity) / 2)
+            table_rebuild(table, GROWN_CAPACITY(table->capacity));
+        else table_compact(table);
+    }
+
+    table_Entry* const inserted = &table->entries[table->used];
+    inserted->key = key;
+    inserted->value = value;
+    inserted->hash = hash;
+    table_link(table, (unsigned int)table->used++);
+    table->size++;
+    if (table->filter != NULL)
+        bloom_add_hash(table->filter, hash);
+
+    /* Convert the chain into a tree bin once it becomes too long. */
+    const size_t bucket = BUCKET(hash, table->capacity);
+    if (!IS_BIN(table->buckets[bucket]) && table_chain_long(table, table->buckets[bucket]))
+        table_treeify(table, bucket);
+}
+
+/*
+ * Unlinks the entry at the specified index from its bucket, leaving a hole in its place.
+ * Note: The Table must already be locked. Holes are reclaimed by the caller.
+ * Ω(1), O(log(m)), where m is the number of entries in the bucket
+ */
+static void table_delete(HashTable* const table, const unsigned int index)
+{
+    table_Entry* const entry = &table->entries[index];
+    unsigned int* const bucket = &table->buckets[BUCKET(entry->hash, table->capacity)];
+    if (IS_BIN(*bucket))
+    {
+        const unsigned int bin_index = *bucket & ~TABLE_BIN;
+        table_Bin* const bin = &table->bins[bin_index];
+        bin->root = table_bin_delete(table, bin, bin->root, index);
+        if (--bin->count < UNTREEIFY_THRESHOLD)
+            table_untreeify(table, bin_index);
+    }
+    /* Determine if this entry is root of the chain. */
+    else if (*bucket == index)
+        *bucket = entry->next;
+    else
+    {
+        unsigned int prev = *bucket;
+        while (table->entries[prev].next != index)
+            prev = table->entries[prev].next;
+        table->entries[prev].next = entry->next;
+    }
+    entry->key = entry->value = NULL;
+    table->size--;
+}
 
-    const table_Bucket* const current = iter->current;
-    iter->visited++;
+/*
+ * Empties every bucket which is in use and frees all tree bins.
+ * Θ(n)
+ */
+static void table_unlink_all(HashTable* const table)
+{
+    /* Every non-empty bucket leads to a mapping, so emptying those buckets empties all of them. */
+    for (size_t i = 0; i < table->used; i++)
+        if (table->entries[i].key != NULL)
+            table->buckets[BUCKET(table->entries[i].hash, table->capacity)] = TABLE_END;
+
+    for (size_t i = 0; i < table->bin_count; i++)
+        mem_free(table->bins[i].nodes, table->bins[i].capacity * sizeof(table_Node));
+    table->bin_count = 0;
+}
 
-    iter->current = iter->current->next;
+/*
+ * Slides every mapping down over the holes left by removals, preserving insertion order.
+ * Θ(n)
+ */
+static void table_compact(HashTable* const table)
+{
+    /* Tree bins refer to entries by index, so they are re-built once the entries have moved. */
+    table_unlink_all(table);
 
-    return (table_Bucket*)current;
+    size_t live = 0;
+    for (size_t i = 0; i < table->used; i++)
+        if (table->entries[i].key != NULL)
+        {
+            table->entries[live] = table->entries[i];
+            table_link(table, (unsigned int)live++);
+        }
+    table->used = live;
+    table_treeify_all(table);
+    /* Compaction only follows many removals, whose stale bits are cleared out of the filter. */
+    table_filter_fill(table);
 }
 
 /*
- * Returns a bucket in the Table whose hash matches the specified hash.
- * If no such bucket exists, either the closest bucket will be returned or NULL.
- * The parameter `found` will be set to true if an exact match is located.
+ * Moves every mapping into newly allocated arrays of the specified capacity.
+ * Mappings keep their insertion order and their stored hashes are re-used.
+ * Note: The Table must already be locked, and the capacity must hold every mapping.
+ * Θ(n + c), where c is the new capacity
+ */
+static void table_rebuild(HashTable* const table, const size_t capacity)
+{
+    table_Entry* const entries = table->entries;
+    unsigned int* const buckets = table->buckets;
+    const size_t used = table->used, old_capacity = table->capacity;
+
+    /* Tree bins refer to entries by index, so they are re-built once the entries have moved. */
+    for (size_t i = 0; i < table->bin_count; i++)
+        mem_free(table->bins[i].nodes, table->bins[i].capacity * sizeof(table_Node));
+    table->bin_count = 0;
+    table->buckets = mem_malloc(capacity * sizeof(unsigned int));
+    memset(table->buckets, 0xFF, capacity * sizeof(unsigned int));
+    table->entries = mem_calloc(DESIGN_LOAD(capacity), sizeof(table_Entry));
+    table->capacity = capacity;
+    table->used = 0;
+
+    for (size_t i = 0; i < used; i++)
+        if (entries[i].key != NULL)
+        {
+            table->entries[table->used] = entries[i];
+            table_link(table, (unsigned int)table->used++);
+        }
+
+    table_treeify_all(table);
+    table_filter_fill(table);
+
+    mem_free(entries, DESIGN_LOAD(old_capacity) * sizeof(table_Entry));
+    mem_free(buckets, old_capacity * sizeof(unsigned int));
+}
+
+/*
+ * Re-builds the Table's filter, if it has one, from only the mappings in the Table.
+ * The filter is re-sized to match the Table's capacity.
+ * Θ(n + c), where c is the capacity
+ */
+static void table_filter_fill(HashTable* const table)
+{
+    if (table->filter == NULL) return;
+
+    if (bloom_capacity(table->filter) != DESIGN_LOAD(table->capacity))
+    {
+        bloom_destroy(table->filter);
+        table->filter = BloomFilter_new(DESIGN_LOAD(table->capacity), NULL);
+    }
+    else bloom_clear(table->filter);
+
+    for (size_t i = 0; i < table->used; i++)
+        if (table->entries[i].key != NULL)
+            bloom_add_hash(table->filter, table->entries[i].hash);
+}
+
+/*
+ * Advances the iterator past any holes left by removals.
+ * Iterators over a single key instead advance to that key's next mapping.
  * Ω(1), O(n)
  */
-table_Bucket* table_search(const HashTable* const table, const void* const key,
-                           const unsigned int hash, bool* const found)
+static void table_iter_skip(table_Iterator* const iter)
 {
-    io_assert(table != NULL, IO_MSG_NULL_PTR);
-    io_assert(key != NULL, IO_MSG_NULL_PTR);
-    io_assert(found != NULL, IO_MSG_NULL_PTR);
+    if (iter->key != NULL)
+    {
+        const unsigned int next = table_search_from(iter->ref, iter->key, iter->hash, iter->index);
+        iter->index = next == TABLE_END ? iter->ref->used : next;
+    }
+    else while (iter->index < iter->ref->used && iter->ref->entries[iter->index].key == NULL)
+        iter->index++;
+}
 
-    *found = false;
-    const table_Bucket *current = table->buckets[MODULUS(hash, table->capacity)];
+/*
+ * Returns the hash of a key, mixed with the Table's seed.
+ * Buckets are chosen by the upper bits of the hash, so the hash is always avalanched.
+ * Otherwise, small sequential hashes would all fall into the first bucket.
+ * Θ(1)
+ */
+static unsigned int table_hash(const HashTable* const table, const void* const key)
+{
+    return math_fmix32(table->hash(key) ^ table->seed);
+}
 
-    while (current != NULL)
+/*
+ * Returns true if the chain starting at the specified entry is longer than the treeify threshold.
+ * Θ(1)
+ */
+static bool table_chain_long(const HashTable* const table, unsigned int index)
+{
+    unsigned int length = 0;
+    while (index != TABLE_END && length <= TREEIFY_THRESHOLD)
+    {
+        index = table->entries[index].next;
+        length++;
+    }
+    return length > TREEIFY_THRESHOLD;
+}
+
+/*
+ * Converts the chain of the specified bucket into a tree bin.
+ * Θ(m*log(m)), where m is the length of the chain
+ */
+static void table_treeify(HashTable* const table, const size_t bucket)
+{
+    if (table->bin_count == table->bin_capacity)
     {
-        // TODO: It may be possible to refactor this code.
-        *found = table_Bucket_match(current, key, hash, table->equals);
-        if (*found || current->next == NULL) break;
-        current = current->next;
+        const size_t capacity = table->bin_capacity == 0 ? 4 : table->bin_capacity * GROW_FACTOR;
+        table->bins = table->bins == NULL ? mem_malloc(capacity * sizeof(table_Bin)) :
+                      mem_realloc(table->bins, table->bin_capacity * sizeof(table_Bin), capacity * sizeof(table_Bin));
+        table->bin_capacity = capacity;
     }
 
-    return (table_Bucket*)current;
+    table_Bin* const bin = &table->bins[table->bin_count];
+    bin->capacity = TREEIFY_THRESHOLD * GROW_FACTOR;
+    bin->nodes = mem_malloc(bin->capacity * sizeof(table_Node));
+    bin->root = bin->free = TABLE_END;
+    bin->count = bin->used = 0;
+    bin->bucket = (unsigned int)bucket;
+
+    unsigned int index = table->buckets[bucket];
+    table->buckets[bucket] = TABLE_BIN | (unsigned int)table->bin_count++;
+    while (index != TABLE_END)
+    {
+        const unsigned int next = table->entries[index].next;
+        table_bin_add(table, bin, index);
+        index = next;
+    }
 }
 
 /*
- * De-constructor function.
+ * Converts every chain which is longer than the treeify threshold into a tree bin.
+ * Ω(n), O(n*log(n))
+ */
+static void table_treeify_all(HashTable* const table)
+{
+    for (size_t i = 0; i < table->used; i++)
+        if (table->entries[i].key != NULL)
+        {
+            const size_t bucket = BUCKET(table->entries[i].hash, table->capacity);
+            /* Each chain is only measured from its first entry. */
+            if (table->buckets[bucket] == i && table_chain_long(table, (unsigned int)i))
+                table_treeify(table, bucket);
+        }
+}
+
+/*
+ * Converts the specified tree bin back into a chain and frees it.
+ * Θ(m), where m is the number of nodes in the bin
+ */
+static void table_untreeify(HashTable* const table, const unsigned int bin_index)
+{
+    table_Bin* const bin = &table->bins[bin_index];
+    unsigned int* const bucket = &table->buckets[bin->bucket];
+
+    *bucket = TABLE_END;
+    for (unsigned int i = 0; i < bin->used; i++)
+        if (bin->nodes[i].entry != TABLE_END)
+        {
+            table->entries[bin->nodes[i].entry].next = *bucket;
+            *bucket = bin->nodes[i].entry;
+        }
+    mem_free(bin->nodes, bin->capacity * sizeof(table_Node));
+
+    /* Fill the gap with the last bin, and point that bin's bucket to its new index. */
+    if (bin_index != --table->bin_count)
+    {
+        *bin = table->bins[table->bin_count];
+        table->buckets[bin->bucket] = TABLE_BIN | bin_index;
+    }
+}
+
+/*
+ * Returns the index of the entry in the subtree whose key matches the specified key.
+ * If no such entry exists, TABLE_END is returned.
+ * Without a Compare function, keys sharing the hash are unordered, so both sides of each must be searched.
+ * Ω(log(m)), O(log(m) + k), where m is the number of nodes and k is the number of keys sharing the hash,
+ * or Θ(log(m)) if keys can be compared
+ */
+static unsigned int table_bin_search(const HashTable* const table, const table_Bin* const bin, unsigned int node,
+                                     const void* const key, const unsigned int hash)
+{
+    while (node != TABLE_END)
+    {
+        const table_Node* const current = &bin->nodes[node];
+        const table_Entry* const entry = &table->entries[current->entry];
+        if (hash < entry->hash) node = current->left;
+        else if (hash > entry->hash) node = current->right;
+        else if (table->compare != NULL)
+        {
+            const int order = table->compare(key, entry->key);
+            if (order == 0) return table_Entry_match(entry, key, hash, table->equals) ? current->entry : TABLE_END;
+            node = order < 0 ? current->left : current->right;
+        }
+        else
+        {
+            /* Keys sharing the hash may be found on either side of this node. */
+            const unsigned int found = table_bin_search(table, bin, current->left, key, hash);
+            if (found != TABLE_END) return found;
+            if (table_Entry_match(entry, key, hash, table->equals)) return current->entry;
+            node = current->right;
+        }
+    }
+    return TABLE_END;
+}
+
+/*
+ * Returns the first entry of the tree bin ordered at or after the specified hash, key, and index.
+ * The key is only part of the order if the Table can compare keys.
+ * If no such entry exists, TABLE_END is returned.
+ * Θ(log(m)), where m is the number of nodes in the bin
+ */
+static unsigned int table_bin_ceiling(const HashTable* const table, const table_Bin* const bin,
+                                      const void* const key, const unsigned int hash, const size_t from)
+{
+    unsigned int node = bin->root, ceiling = TABLE_END;
+    while (node != TABLE_END)
+    {
+        const table_Node* const current = &bin->nodes[node];
+        const table_Entry* const entry = &table->entries[current->entry];
+        int order = entry->hash < hash ? -1 : entry->hash > hash;
+        if (order == 0 && table->compare != NULL)
+            order = table->compare(entry->key, key);
+        if (order > 0 || (order == 0 && current->entry >= from))
+        {
+            ceiling = current->entry;
+            node = current->left;
+        }
+        else node = current->right;
+    }
+    return ceiling;
+}
+
+/*
+ * Adds the entry at the specified index into the tree bin.
+ * Θ(log(m)), where m is the number of nodes in the bin
+ */
+static void table_bin_add(const HashTable* const table, table_Bin* const bin, const unsigned int entry)
+{
+    unsigned int node = bin->free;
+    /* Re-use a freed node if one exists. */
+    if (node != TABLE_END)
+        bin->free = bin->nodes[node].left;
+    else
+    {
+        if (bin->used == bin->capacity)
+        {
+            bin->nodes = mem_realloc(bin->nodes, bin->capacity * sizeof(table_Node),
+                                     bin->capacity * GROW_FACTOR * sizeof(table_Node));
+            bin->capacity *= GROW_FACTOR;
+        }
+        node = bin->used++;
+    }
+
+    table_Node* const added = &bin->nodes[node];
+    added->entry = entry;
+    added->left = added->right = TABLE_END;
+    added->height = 1;
+    bin->root = table_bin_insert(table, bin, bin->root, node);
+    bin->count++;
+}
+
+/*
+ * Inserts a node into the subtree and returns the subtree's new root.
+ * Θ(log(m)), where m is the number of nodes in the subtree
+ */
+static unsigned int table_bin_insert(const HashTable* const table, table_Bin* const bin,
+                                     const unsigned int node, const unsigned int inserted)
+{
+    if (node == TABLE_END) return inserted;
+
+    table_Node* const current = &bin->nodes[node];
+    if (table_bin_before(table, bin->nodes[inserted].entry, current->entry))
+        current->left = table_bin_insert(table, bin, current->left, inserted);
+    else current->right = table_bin_insert(table, bin, current->right, inserted);
+
+    return table_bin_balance(bin, node);
+}
+
+/*
+ * Deletes the node holding the specified entry from the subtree and returns the subtree's new root.
+ * Θ(log(m)), where m is the number of nodes in the subtree
+ */
+static unsigned int table_bin_delete(const HashTable* const table, table_Bin* const bin,
+                                     const unsigned int node, const unsigned int entry)
+{
+    io_assert(node != TABLE_END, IO_MSG_OUT_OF_BOUNDS);
+
+    table_Node* const current = &bin->nodes[node];
+    if (current->entry != entry)
+    {
+        if (table_bin_before(table, entry, current->entry))
+            current->left = table_bin_delete(table, bin, current->left, entry);
+        else current->right = table_bin_delete(table, bin, current->right, entry);
+        return table_bin_balance(bin, node);
+    }
+
+    if (current->left == TABLE_END || current->right == TABLE_END)
+    {
+        const unsigned int child = current->left == TABLE_END ? current->right : current->left;
+        /* Return the node to the free list. */
+        current->entry = TABLE_END;
+        current->left = bin->free;
+        bin->free = node;
+        return child;
+    }
+
+    /* Take the successor's entry, then delete the successor from the right subtree instead. */
+    unsigned int successor = current->right;
+    while (bin->nodes[successor].left != TABLE_END)
+        successor = bin->nodes[successor].left;
+    current->entry = bin->nodes[successor].entry;
+    current->right = table_bin_delete(table, bin, current->right, current->entry);
+    return table_bin_balance(bin, node);
+}
+
+/*
+ * Restores the balance of a subtree whose children differ in height by at most two.
+ * Returns the subtree's new root.
  * Θ(1)
  */
-void table_Bucket_destroy(table_Bucket* const bucket)
+static unsigned int table_bin_balance(table_Bin* const bin, const unsigned int node)
 {
-   mem_free(bucket, sizeof(table_Bucket));
+    table_Node* const current = &bin->nodes[node];
+    const int difference = (int)HEIGHT(bin, current->left) - (int)HEIGHT(bin, current->right);
+
+    if (difference > 1)
+    {
+        const table_Node* const left = &bin->nodes[current->left];
+        if (HEIGHT(bin, left->left) < HEIGHT(bin, left->right))
+            current->left = table_bin_rotate(bin, current->left, true);
+        return table_bin_rotate(bin, node, false);
+    }
+    if (difference < -1)
+    {
+        const table_Node* const right = &bin->nodes[current->right];
+        if (HEIGHT(bin, right->right) < HEIGHT(bin, right->left))
+            current->right = table_bin_rotate(bin, current->right, false);
+        return table_bin_rotate(bin, node, true);
+    }
+
+    table_bin_height(bin, node);
+    return node;
 }
 
 /*
- * Returns true if the Table is or is exceeding maximum design load.
- * Design load is when the ratio of elements to capacity exceeds the load factor.
+ * Rotates the subtree to the left if `left` is true, otherwise to the right.
+ * Returns the subtree's new root.
  * Θ(1)
  */
-static bool table_design_load(const HashTable* const table)
+static unsigned int table_bin_rotate(table_Bin* const bin, const unsigned int node, const bool left)
 {
-    return (double)table->size / table->capacity >= LOAD_FACTOR;
+    table_Node* const top = &bin->nodes[node];
+    const unsigned int pivot = left ? top->right : top->left;
+    table_Node* const rotated = &bin->nodes[pivot];
+
+    if (left)
+    {
+        top->right = rotated->left;
+        rotated->left = node;
+    }
+    else
+    {
+        top->left = rotated->right;
+        rotated->right = node;
+    }
+
+    table_bin_height(bin, node);
+    table_bin_height(bin, pivot);
+    return pivot;
+}
+
+/*
+ * Re-calculates the height of a node from the heights of its children.
+ * Θ(1)
+ */
+static void table_bin_height(table_Bin* const bin, const unsigned int node)
+{
+    table_Node* const current = &bin->nodes[node];
+    current->height = 1 + math_max(HEIGHT(bin, current->left), HEIGHT(bin, current->right));
 }
 
 /*
- * Returns true if a Bucket matches a specified hash and key.
+ * Returns true if entry `a` is ordered before entry `b` within a tree bin.
+ * Entries are ordered by their hash, then by their key if the Table can compare keys, then by their index.
  * Θ(1)
  */
-static bool table_Bucket_match(const table_Bucket* const bucket, const void* const key, const unsigned int hash,
-                               bool(*equals)(const void*, const void*))
+static bool table_bin_before(const HashTable* const table, const unsigned int a, const unsigned int b)
 {
-    io_assert(bucket != NULL, IO_MSG_NULL_PTR);
+    const unsigned int hash_a = table->entries[a].hash, hash_b = table->entries[b].hash;
+    if (hash_a != hash_b) return hash_a < hash_b;
+    if (table->compare != NULL)
+    {
+        const int order = table->compare(table->entries[a].key, table->entries[b].key);
+        if (order != 0) return order < 0;
+    }
+    return a < b;
+}
+
+/*
+ * Returns true if an Entry matches a specified hash and key.
+ * Θ(1)
+ */
+static bool table_Entry_match(const table_Entry* const entry, const void* const key, const unsigned int hash,
+                              bool(*equals)(const void*, const void*))
+{
+    io_assert(entry != NULL, IO_MSG_NULL_PTR);
     io_assert(key != NULL, IO_MSG_NULL_PTR);
     io_assert(equals != NULL, IO_MSG_NOT_SUPPORTED);
-    return bucket->hash == hash && (bucket->key == key || equals(key, bucket->key));
-}
+    return entry->hash == hash && (entry->key == key || equals(key, entry->key));
+}
\ No newline at end of file
@@ -0,0 +1,255 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       HyperLogLog.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/HyperLogLog.h"
+#include <math.h>
+#include <string.h>
+
+/* Range of supported precisions. */
+#define MIN_PRECISION 4
+#define MAX_PRECISION 16
+
+/*
+ * Estimation:
+ * Each key's hash picks a register by its top bits, and the register keeps the longest run of
+ * leading zeros seen in the rest of the hash. Long runs are exponentially rare, so the harmonic mean
+ * of the registers estimates the number of distinct hashes. Small counts, which leave registers
+ * empty, are instead estimated by linear counting. Registers only ever grow, so two sketches are
+ * merged by the element-wise maximum of their registers, a loop which compilers vectorize.
+ * For details, see: Flajolet, Fusy, Gandouet, Meunier, "HyperLogLog: the analysis of a near-optimal
+ * cardinality estimation algorithm".
+ */
+
+/* HyperLogLog structure. */
+struct HyperLogLog
+{
+    unsigned char *registers;
+    unsigned int precision;
+    size_t register_count;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+
+    /* Function pointers. */
+    unsigned int(*hash)(const void*);
+};
+
+/* Local functions. */
+static unsigned long long hll_spread(const unsigned int hash);
+
+/*
+ * Constructor function.
+ * Θ(m), where m is the number of registers
+ */
+HyperLogLog* HyperLogLog_new(const unsigned int precision, unsigned int(*hash)(const void*))
+{
+    io_assert(precision >= MIN_PRECISION && precision <= MAX_PRECISION, IO_MSG_INVALID_SIZE);
+
+    HyperLogLog* const hll = mem_calloc(1, sizeof(HyperLogLog));
+    hll->precision = precision;
+    hll->register_count = (size_t)1 << precision;
+    hll->registers = mem_calloc(hll->register_count, sizeof(unsigned char));
+    hll->hash = hash;
+    hll->rw_sync = ReadWriteSync_new();
+    return hll;
+}
+
+/*
+ * Returns the estimated number of distinct keys which have been added.
+ * Θ(m), where m is the number of registers
+ */
+unsigned long long hll_count(const HyperLogLog* const hll)
+{
+    io_assert(hll != NULL, IO_MSG_NULL_PTR);
+
+    const double m = (double)hll->register_count;
+    double sum = 0;
+    size_t empty = 0;
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(hll->rw_sync);
+
+    for (size_t i = 0; i < hll->register_count; i++)
+    {
+        sum += ldexp(1.0, -(int)hll->registers[i]);
+        empty += hll->registers[i] == 0;
+    }
+
+    /* Unlock the data structure. */
+    sync_read_end(hll->rw_sync);
+
+    /* Bias correction constant, which depends on the number of registers. */
+    double alpha;
+    switch (hll->register_count)
+    {
+    case 16: alpha = 0.673; break;
+    case 32: alpha = 0.697; break;
+    case 64: alpha = 0.709; break;
+    default: alpha = 0.7213 / (1.0 + 1.079 / m); break;
+    }
+
+    double estimate = alpha * m * m / sum;
+    /* Small counts are more accurately estimated from the number of empty registers. */
+    if (estimate <= 2.5 * m && empty > 0)
+        estimate = m * log(m / (double)empty);
+    return (unsigned long long)(estimate + 0.5);
+}
+
+/*
+ * Returns the precision of the sketch.
+ * Θ(1)
+ */
+unsigned int hll_precision(const HyperLogLog* const hll)
+{
+    io_assert(hll != NULL, IO_MSG_NULL_PTR);
+    return hll->precision;
+}
+
+/*
+ * Adds a key to the sketch.
+ * The `hash` function must be defined to call this function.
+ * Θ(1)
+ */
+void hll_add(HyperLogLog* const hll, const void* const key)
+{
+    io_assert(hll != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(hll->hash != NULL, IO_MSG_NOT_SUPPORTED);
+    hll_add_hash(hll, hll->hash(key));
+}
+
+/*
+ * Adds a key of the specified hash to the sketch.
+ * Θ(1)
+ */
+void hll_add_hash(HyperLogLog* const hll, const unsigned int hash)
+{
+    io_assert(hll != NULL, IO_MSG_NULL_PTR);
+
+    const unsigned long long spread = hll_spread(hash);
+    const size_t index = (size_t)(spread >> (64 - hll->precision));
+    /* Leading zeros among the remaining bits, plus one. A zero remainder has the longest run possible. */
+    const unsigned long long rest = spread << hll->precision;
+    const unsigned char rank = (unsigned char)(rest == 0 ? 64 - hll->precision + 1 : 64 - math_ilog2(rest));
+
+    /* Most keys cannot raise their register, so check before taking the write lock. */
+    /* Lock the data structure to future writers. */
+    sync_read_start(hll->rw_sync);
+
+    const bool raises = rank > hll->registers[index];
+
+    /* Unlock the data structure. */
+    sync_read_end(hll->rw_sync);
+
+    if (raises)
+    {
+        /* Lock the data structure to future readers/writers. */
+        sync_write_start(hll->rw_sync);
+
+        if (rank > hll->registers[index])
+            hll->registers[index] = rank;
+
+        /* Unlock the data structure. */
+        sync_write_end(hll->rw_sync);
+    }
+}
+
+/*
+ * Adds every key which was added to another sketch, as if it had been added to this one.
+ * Both sketches must have the same precision and hash function.
+ * Θ(m), where m is the number of registers
+ */
+void hll_merge(HyperLogLog* const hll, const HyperLogLog* const other)
+{
+    io_assert(hll != NULL, IO_MSG_NULL_PTR);
+    io_assert(other != NULL, IO_MSG_NULL_PTR);
+    io_assert(hll != other, IO_MSG_NOT_SUPPORTED);
+    io_assert(hll->precision == other->precision, IO_MSG_NOT_SUPPORTED);
+
+    /* Copy the other sketch's registers first, so that the two sketches are never locked at once. */
+    unsigned char* const merged = mem_malloc(other->register_count);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(other->rw_sync);
+
+    memcpy(merged, other->registers, other->register_count);
+
+    /* Unlock the data structure. */
+    sync_read_end(other->rw_sync);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(hll->rw_sync);
+
+    unsigned char* const registers = hll->registers;
+    for (size_t i = 0; i < hll->register_count; i++)
+        registers[i] = merged[i] > registers[i] ? merged[i] : registers[i];
+
+    /* Unlock the data structure. */
+    sync_write_end(hll->rw_sync);
+
+    mem_free(merged, other->register_count);
+}
+
+/*
+ * Removes every key from the sketch.
+ * Θ(m), where m is the number of registers
+ */
+void hll_clear(HyperLogLog* const hll)
+{
+    io_assert(hll != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(hll->rw_sync);
+
+    memset(hll->registers, 0, hll->register_count);
+
+    /* Unlock the data structure. */
+    sync_write_end(hll->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void hll_destroy(HyperLogLog* const hll)
+{
+    io_assert(hll != NULL, IO_MSG_NULL_PTR);
+    mem_free(hll->registers, hll->register_count);
+    sync_destroy(hll->rw_sync);
+    mem_free(hll, sizeof(HyperLogLog));
+}
+
+/*
+ * Spreads a 32-bit hash over 64 bits, so that both the register and the run of zeros are well mixed.
+ * Θ(1)
+ */
+static unsigned long long hll_spread(const unsigned int hash)
+{
+    return math_fmix64(hash);
+}
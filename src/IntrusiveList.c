@@ -0,0 +1,645 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       IntrusiveList.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/IntrusiveList.h"
+
+/* Converts between an element and its embedded link. */
+#define LINK(list, data) ((ilist_Link*)((char*)(data) + (list)->offset))
+#define ELEMENT(list, link) ((void*)((char*)(link) - (list)->offset))
+
+/*
+ * Layout:
+ * The List is circular around a sentinel link which lives inside of the List structure.
+ * The sentinel removes every head/tail special case, and since each element carries its
+ * own link, an element can be unlinked in Θ(1) from nothing more than a pointer to it.
+ * Unlinked links are kept zeroed so that double insertion can be detected.
+ */
+
+/* IntrusiveList structure. */
+struct IntrusiveList
+{
+    ilist_Link sentinel;
+    size_t offset, size;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+
+    /* Function pointers. */
+    int(*compare)(const void*, const void*);
+    char*(*toString)(const void*);
+};
+
+/* Structure to assist in looping through List. */
+struct ilist_Iterator
+{
+    /* Keep track of where we are inside the List. */
+    ilist_Link *right, *last;
+    /* Reference to the List that it is iterating through. */
+    IntrusiveList *list;
+};
+
+/* Local functions. */
+static void ilist_link(IntrusiveList* const list, ilist_Link* const left, ilist_Link* const link);
+static void ilist_unlink(IntrusiveList* const list, ilist_Link* const link);
+static void ilist_detach(IntrusiveList* const list);
+static ilist_Link* ilist_merge(const IntrusiveList* const list, ilist_Link* left, ilist_Link* right);
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+IntrusiveList* IntrusiveList_new(const size_t offset,
+                                 int(*compare)(const void*, const void*),
+                                 char*(*toString)(const void*))
+{
+    IntrusiveList* const list = mem_calloc(1, sizeof(IntrusiveList));
+    list->sentinel.next = list->sentinel.prev = &list->sentinel;
+    list->offset = offset;
+    list->compare = compare;
+    list->toString = toString;
+    list->rw_sync = ReadWriteSync_new();
+    return list;
+}
+
+/*
+ * Returns the element at the front of the List.
+ * Θ(1)
+ */
+void* ilist_front(const IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(list->rw_sync);
+
+    io_assert(list->size > 0, IO_MSG_EMPTY);
+
+    void* const val = ELEMENT(list, list->sentinel.next);
+
+    /* Unlock the data structure. */
+    sync_read_end(list->rw_sync);
+
+    return val;
+}
+
+/*
+ * Returns the element at the back of the List.
+ * Θ(1)
+ */
+void* ilist_back(const IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(list->rw_sync);
+
+    io_assert(list->size > 0, IO_MSG_EMPTY);
+
+    void* const val = ELEMENT(list, list->sentinel.prev);
+
+    /* Unlock the data structure. */
+    sync_read_end(list->rw_sync);
+
+    return val;
+}
+
+/*
+ * Returns the element after the specified element, or NULL if it is the back of the List.
+ * Θ(1)
+ */
+void* ilist_next(const IntrusiveList* const list, const void* const data)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+    io_assert(data != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(list->rw_sync);
+
+    const ilist_Link* const link = LINK(list, data);
+    io_assert(link->next != NULL, IO_MSG_NOT_SUPPORTED);
+    void* const val = link->next == &list->sentinel ? NULL : ELEMENT(list, link->next);
+
+    /* Unlock the data structure. */
+    sync_read_end(list->rw_sync);
+
+    return val;
+}
+
+/*
+ * Returns the element before the specified element, or NULL if it is the front of the List.
+ * Θ(1)
+ */
+void* ilist_prev(const IntrusiveList* const list, const void* const data)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+    io_assert(data != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(list->rw_sync);
+
+    const ilist_Link* const link = LINK(list, data);
+    io_assert(link->prev != NULL, IO_MSG_NOT_SUPPORTED);
+    void* const val = link->prev == &list->sentinel ? NULL : ELEMENT(list, link->prev);
+
+    /* Unlock the data structure. */
+    sync_read_end(list->rw_sync);
+
+    return val;
+}
+
+/*
+ * Returns the number of elements in the List.
+ * Θ(1)
+ */
+size_t ilist_size(const IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(list->rw_sync);
+
+    const size_t size = list->size;
+
+    /* Unlock the data structure. */
+    sync_read_end(list->rw_sync);
+
+    return size;
+}
+
+/*
+ * Returns true if the List is empty.
+ * Θ(1)
+ */
+bool ilist_empty(const IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(list->rw_sync);
+
+    const bool val = list->size == 0;
+
+    /* Unlock the data structure. */
+    sync_read_end(list->rw_sync);
+
+    return val;
+}
+
+/*
+ * Returns true if the specified link is currently inside of a List.
+ * Θ(1)
+ */
+bool ilist_linked(const ilist_Link* const link)
+{
+    io_assert(link != NULL, IO_MSG_NULL_PTR);
+    return link->next != NULL;
+}
+
+/*
+ * Prints out the contents of the List to the console window.
+ * Θ(n)
+ */
+void ilist_print(const IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+    io_assert(list->toString != NULL, IO_MSG_NOT_SUPPORTED);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(list->rw_sync);
+
+    printf("%c", '[');
+    for (const ilist_Link* link = list->sentinel.next; link != &list->sentinel; link = link->next)
+    {
+        char* value = list->toString(ELEMENT(list, link));
+        printf("%s%s", value, link->next != &list->sentinel ? ", " : "");
+    }
+    printf("]\n");
+
+    /* Unlock the data structure. */
+    sync_read_end(list->rw_sync);
+}
+
+/*
+ * Appends an element at the end of the List.
+ * Θ(1)
+ */
+void ilist_push_back(IntrusiveList* const list, void* const data)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+    io_assert(data != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(list->rw_sync);
+
+    ilist_link(list, list->sentinel.prev, LINK(list, data));
+
+    /* Unlock the data structure. */
+    sync_write_end(list->rw_sync);
+}
+
+/*
+ * Inserts an element at the front of the List.
+ * Θ(1)
+ */
+void ilist_push_front(IntrusiveList* const list, void* const data)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+    io_assert(data != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(list->rw_sync);
+
+    ilist_link(list, &list->sentinel, LINK(list, data));
+
+    /* Unlock the data structure. */
+    sync_write_end(list->rw_sync);
+}
+
+/*
+ * Inserts an element directly before an element which is already inside the List.
+ * Θ(1)
+ */
+void ilist_insert_before(IntrusiveList* const list, void* const position, void* const data)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+    io_assert(position != NULL, IO_MSG_NULL_PTR);
+    io_assert(data != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(list->rw_sync);
+
+    const ilist_Link* const right = LINK(list, position);
+    io_assert(right->prev != NULL, IO_MSG_NOT_SUPPORTED);
+    ilist_link(list, right->prev, LINK(list, data));
+
+    /* Unlock the data structure. */
+    sync_write_end(list->rw_sync);
+}
+
+/*
+ * Removes the specified element from the List.
+ * Θ(1)
+ */
+void ilist_remove(IntrusiveList* const list, void* const data)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+    io_assert(data != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(list->rw_sync);
+
+    ilist_unlink(list, LINK(list, data));
+
+    /* Unlock the data structure. */
+    sync_write_end(list->rw_sync);
+}
+
+/*
+ * Removes and returns the element at the end of the List.
+ * Θ(1)
+ */
+void* ilist_pop_back(IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(list->rw_sync);
+
+    io_assert(list->size > 0, IO_MSG_EMPTY);
+
+    ilist_Link* const link = list->sentinel.prev;
+    ilist_unlink(list, link);
+
+    /* Unlock the data structure. */
+    sync_write_end(list->rw_sync);
+
+    return ELEMENT(list, link);
+}
+
+/*
+ * Removes and returns the element at the front of the List.
+ * Θ(1)
+ */
+void* ilist_pop_front(IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(list->rw_sync);
+
+    io_assert(list->size > 0, IO_MSG_EMPTY);
+
+    ilist_Link* const link = list->sentinel.next;
+    ilist_unlink(list, link);
+
+    /* Unlock the data structure. */
+    sync_write_end(list->rw_sync);
+
+    return ELEMENT(list, link);
+}
+
+/*
+ * Moves every element of another List onto the end of the List.
+ * Both Lists must embed their links at the same offset.
+ * Θ(1)
+ */
+void ilist_splice(IntrusiveList* const list, IntrusiveList* const other)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+    io_assert(other != NULL, IO_MSG_NULL_PTR);
+    io_assert(list != other, IO_MSG_NOT_SUPPORTED);
+    io_assert(list->offset == other->offset, IO_MSG_NOT_SUPPORTED);
+
+    /*
+     * Lock the data structures to future readers/writers.
+     * The lower address is always locked first, so that opposing splices cannot deadlock.
+     */
+    IntrusiveList* const first_locked = list < other ? list : other;
+    IntrusiveList* const second_locked = list < other ? other : list;
+    sync_write_start(first_locked->rw_sync);
+    sync_write_start(second_locked->rw_sync);
+
+    if (other->size > 0)
+    {
+        ilist_Link* const first = other->sentinel.next, * const last = other->sentinel.prev;
+        first->prev = list->sentinel.prev;
+        list->sentinel.prev->next = first;
+        last->next = &list->sentinel;
+        list->sentinel.prev = last;
+        list->size += other->size;
+
+        other->sentinel.next = other->sentinel.prev = &other->sentinel;
+        other->size = 0;
+    }
+
+    /* Unlock the data structures. */
+    sync_write_end(second_locked->rw_sync);
+    sync_write_end(first_locked->rw_sync);
+}
+
+/*
+ * Removes all elements from the List.
+ * Θ(n)
+ */
+void ilist_clear(IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(list->rw_sync);
+
+    ilist_detach(list);
+
+    /* Unlock the data structure. */
+    sync_write_end(list->rw_sync);
+}
+
+/*
+ * Sorts the elements inside the List in ascending order.
+ * The sort is stable, and re-uses the existing links rather than allocating.
+ * see: ilist_merge
+ * Θ(n * log(n))
+ */
+void ilist_sort(IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+    io_assert(list->compare != NULL, IO_MSG_NOT_SUPPORTED);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(list->rw_sync);
+
+    if (list->size > 1)
+    {
+        /* Break the circle into a NULL-terminated chain of `next` pointers. */
+        list->sentinel.prev->next = NULL;
+        ilist_Link* chain = list->sentinel.next;
+
+        /* Bottom-up merge sort, doubling the run width each pass. */
+        for (size_t width = 1; width < list->size; width *= 2)
+        {
+            ilist_Link *merged = NULL, **tail = &merged;
+            while (chain != NULL)
+            {
+                ilist_Link* const left = chain;
+                ilist_Link* cut = left;
+                for (size_t i = 1; i < width && cut->next != NULL; i++)
+                    cut = cut->next;
+                ilist_Link* right = cut->next;
+                cut->next = NULL;
+
+                cut = right;
+                for (size_t i = 1; i < width && cut != NULL && cut->next != NULL; i++)
+                    cut = cut->next;
+                if (cut != NULL)
+                {
+                    chain = cut->next;
+                    cut->next = NULL;
+                }
+                else chain = NULL;
+
+                *tail = ilist_merge(list, left, right);
+                while (*tail != NULL)
+                    tail = &(*tail)->next;
+            }
+            chain = merged;
+        }
+
+        /* Restore the `prev` pointers and close the circle. */
+        ilist_Link* left = &list->sentinel;
+        for (ilist_Link* link = chain; link != NULL; link = link->next)
+        {
+            left->next = link;
+            link->prev = left;
+            left = link;
+        }
+        left->next = &list->sentinel;
+        list->sentinel.prev = left;
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(list->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(n)
+ */
+void ilist_destroy(IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(list->rw_sync);
+
+    /* Leave the caller's links zeroed so the elements can be re-used. */
+    ilist_detach(list);
+
+    /* Unlock the data structure. */
+    sync_write_end(list->rw_sync);
+
+    sync_destroy(list->rw_sync);
+    mem_free(list, sizeof(IntrusiveList));
+}
+
+/*
+ * Constructs a new Iterator for the List.
+ * Θ(1)
+ */
+ilist_Iterator* ilist_iter(IntrusiveList* const list)
+{
+    io_assert(list != NULL, IO_MSG_NULL_PTR);
+
+    ilist_Iterator* const iter = mem_calloc(1, sizeof(ilist_Iterator));
+    iter->list = list;
+    iter->right = list->sentinel.next;
+    return iter;
+}
+
+/*
+ * Returns the iterator's current element and advances it forward.
+ * Θ(1)
+ */
+void* ilist_iter_next(ilist_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    io_assert(ilist_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+
+    iter->last = iter->right;
+    iter->right = iter->right->next;
+    return ELEMENT(iter->list, iter->last);
+}
+
+/*
+ * Returns true if the iterator has a next element.
+ * Θ(1)
+ */
+bool ilist_iter_has_next(const ilist_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return iter->right != &iter->list->sentinel;
+}
+
+/*
+ * Removes the last iterated element from the List.
+ * Θ(1)
+ */
+void ilist_iter_remove(ilist_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    /* Ensure the iterator has iterated, and has not already removed. */
+    io_assert(iter->last != NULL, IO_MSG_NOT_SUPPORTED);
+
+    ilist_remove(iter->list, ELEMENT(iter->list, iter->last));
+    iter->last = NULL;
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void ilist_iter_destroy(ilist_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    mem_free(iter, sizeof(ilist_Iterator));
+}
+
+/*
+ * Links a detached link into the List, directly after another link.
+ * Θ(1)
+ */
+static void ilist_link(IntrusiveList* const list, ilist_Link* const left, ilist_Link* const link)
+{
+    /* Inserting a link which already belongs to a List would corrupt both Lists. */
+    io_assert(link->next == NULL && link->prev == NULL, IO_MSG_NOT_SUPPORTED);
+
+    link->prev = left;
+    link->next = left->next;
+    left->next->prev = link;
+    left->next = link;
+    list->size++;
+}
+
+/*
+ * Unlinks a link from the List, leaving it zeroed.
+ * Θ(1)
+ */
+static void ilist_unlink(IntrusiveList* const list, ilist_Link* const link)
+{
+    io_assert(link->next != NULL && link->prev != NULL, IO_MSG_NOT_SUPPORTED);
+
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = link->prev = NULL;
+    list->size--;
+}
+
+/*
+ * Unlinks every link from the List, leaving each zeroed.
+ * Θ(n)
+ */
+static void ilist_detach(IntrusiveList* const list)
+{
+    ilist_Link* link = list->sentinel.next;
+    while (link != &list->sentinel)
+    {
+        ilist_Link* const next = link->next;
+        link->next = link->prev = NULL;
+        link = next;
+    }
+
+    list->sentinel.next = list->sentinel.prev = &list->sentinel;
+    list->size = 0;
+}
+
+/*
+ * Merges two sorted, NULL-terminated chains of links into one sorted chain.
+ * Ties are taken from the left chain first, keeping the sort stable.
+ * Θ(n)
+ */
+static ilist_Link* ilist_merge(const IntrusiveList* const list, ilist_Link* left, ilist_Link* right)
+{
+    ilist_Link *merged = NULL, **tail = &merged;
+    while (left != NULL && right != NULL)
+    {
+        if (list->compare(ELEMENT(list, right), ELEMENT(list, left)) < 0)
+        {
+            *tail = right;
+            right = right->next;
+        }
+        else
+        {
+            *tail = left;
+            left = left->next;
+        }
+        tail = &(*tail)->next;
+    }
+
+    *tail = left != NULL ? left : right;
+    return merged;
+}
@@ -570,7 +570,7 @@ void list_sort(LinkedList* const list)
 /*
  * Shuffles the elements inside the List pseudo-randomly.
  * Implementation uses Merge-sort algorithm.
- * For the Random implementation, see: C-Random
+ * For the Random implementation, see: Random.h
  * see: list_merge_sort
  * Θ(n * log(n))
  */
@@ -978,7 +978,7 @@ void list_merge_sort(LinkedList* const list)
 /*
  * Recursively shuffles the elements inside the List pseudo-randomly.
  * The algorithm mirrors merge sort, except that merging is performed randomly.
- * For the Random implementation, see: C-Random
+ * For the Random implementation, see: Random.h
  * Θ(n * log(n))
  */
 static void list_anti_merge_sort(LinkedList* const list)
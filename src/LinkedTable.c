@@ -0,0 +1,783 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       LinkedTable.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/LinkedTable.h"
+#include <math.h>
+#include <limits.h>
+
+/* Array capacity components. */
+#define DEFAULT_INITIAL_CAPACITY 16
+#define LOAD_FACTOR 0.75f
+#define GROW_FACTOR 2
+
+/* Bucket of a hash. Buckets split the range of hashes into equal, ordered intervals. */
+#define BUCKET(hash, capacity) MATH_FASTRANGE(hash, capacity)
+/* Number of entries which a Table of the specified capacity can hold. */
+#define DESIGN_LOAD(capacity) ((size_t)((capacity) * LOAD_FACTOR))
+/* Marks an empty bucket, the end of a chain, or the end of the order. */
+#define LTABLE_END UINT_MAX
+
+/*
+ * Layout:
+ * Each entry carries two sets of links: `next` chains it into its bucket, while `before` and `after`
+ * thread it into the Table-wide order. Links are indices into one entry array, so a mapping costs
+ * no allocation of its own, and removing or re-ordering a mapping never searches the order.
+ * Removed entries are kept in a free list threaded through `next`, and re-used by later insertions.
+ */
+
+/* LinkedTable structure. */
+struct LinkedTable
+{
+    struct ltable_Entry *entries;
+    unsigned int *buckets;
+    size_t capacity, size;
+    /* Number of entries which have ever been handed out, including freed entries. */
+    size_t used;
+    /* Head of the free list. */
+    unsigned int free;
+    /* Ends of the order. */
+    unsigned int head, tail;
+    bool access_order;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+
+    /* Function pointers. */
+    bool(*equals)(const void*, const void*);
+    unsigned int(*hash)(const void*);
+    char*(*toString)(const void*, const void*);
+};
+
+/* Entry structure. */
+typedef struct ltable_Entry
+{
+    const void *key, *value;
+    unsigned int hash;
+    /* Index of the next entry in the same bucket. */
+    unsigned int next;
+    /* Indices of the neighboring entries in order. */
+    unsigned int before, after;
+} ltable_Entry;
+
+/* Structure to assist in looping through Table. */
+struct ltable_Iterator
+{
+    /* Index of the next entry to be iterated. */
+    unsigned int index;
+    bool reverse;
+    /* Reference to the Table that it is iterating through. */
+    const LinkedTable *ref;
+};
+
+/* Local functions. */
+static unsigned int ltable_search(const LinkedTable* const table, const void* const key,
+                                  const unsigned int hash, unsigned int* const prev);
+static unsigned int ltable_hash(const LinkedTable* const table, const void* const key);
+static unsigned int ltable_allocate(LinkedTable* const table);
+static void ltable_delete(LinkedTable* const table, const unsigned int index, const unsigned int prev);
+static void ltable_detach(LinkedTable* const table, const unsigned int index);
+static void ltable_attach(LinkedTable* const table, const unsigned int index, const bool front);
+static void* ltable_pop(LinkedTable* const table, const unsigned int index, void** const value);
+static void ltable_rebuild(LinkedTable* const table, const size_t capacity);
+
+/*
+ * Constructor function.
+ * The `hash` function must be defined to call this function.
+ * The `equals` function must be defined to call this function.
+ * Θ(1)
+ */
+LinkedTable* LinkedTable_new(unsigned int(*hash)(const void*),
+                             bool(*equals)(const void*, const void*),
+                             char*(*toString)(const void*, const void*),
+                             const bool access_order)
+{
+    io_assert(hash != NULL, IO_MSG_NOT_SUPPORTED);
+    io_assert(equals != NULL, IO_MSG_NOT_SUPPORTED);
+
+    LinkedTable* const table = mem_calloc(1, sizeof(LinkedTable));
+    table->buckets = mem_malloc(DEFAULT_INITIAL_CAPACITY * sizeof(unsigned int));
+    memset(table->buckets, 0xFF, DEFAULT_INITIAL_CAPACITY * sizeof(unsigned int));
+    table->entries = mem_calloc(DESIGN_LOAD(DEFAULT_INITIAL_CAPACITY), sizeof(ltable_Entry));
+    table->capacity = DEFAULT_INITIAL_CAPACITY;
+    table->free = table->head = table->tail = LTABLE_END;
+    table->access_order = access_order;
+    table->hash = hash;
+    table->equals = equals;
+    table->toString = toString;
+    table->rw_sync = ReadWriteSync_new();
+    return table;
+}
+
+/*
+ * Returns the value of a mapping whose key matches the specified key.
+ * In access order, the mapping is moved to the back of the order.
+ * Returns NULL if no such mapping exists.
+ * Ω(1), O(n)
+ */
+void* ltable_get(LinkedTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    /* Reads only re-order the Table in access order. */
+    if (!table->access_order)
+        return ltable_peek(table, key);
+
+    const void *value = NULL;
+    const unsigned int hash = ltable_hash(table, key);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    const unsigned int index = ltable_search(table, key, hash, NULL);
+    if (index != LTABLE_END)
+    {
+        value = table->entries[index].value;
+        ltable_detach(table, index);
+        ltable_attach(table, index, false);
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return (void*)value;
+}
+
+/*
+ * Returns the value of a mapping whose key matches the specified key, without re-ordering it.
+ * Returns NULL if no such mapping exists.
+ * Ω(1), O(n)
+ */
+void* ltable_peek(const LinkedTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const void *value = NULL;
+    const unsigned int hash = ltable_hash(table, key);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    const unsigned int index = ltable_search(table, key, hash, NULL);
+    if (index != LTABLE_END) value = table->entries[index].value;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return (void*)value;
+}
+
+/*
+ * Returns the key of the first mapping in order, storing its value into `value` if non-NULL.
+ * Θ(1)
+ */
+void* ltable_front(const LinkedTable* const table, void** const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    io_assert(table->size > 0, IO_MSG_EMPTY);
+
+    const ltable_Entry* const entry = &table->entries[table->head];
+    if (value != NULL) *value = (void*)entry->value;
+    const void* const key = entry->key;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return (void*)key;
+}
+
+/*
+ * Returns the key of the last mapping in order, storing its value into `value` if non-NULL.
+ * Θ(1)
+ */
+void* ltable_back(const LinkedTable* const table, void** const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    io_assert(table->size > 0, IO_MSG_EMPTY);
+
+    const ltable_Entry* const entry = &table->entries[table->tail];
+    if (value != NULL) *value = (void*)entry->value;
+    const void* const key = entry->key;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return (void*)key;
+}
+
+/*
+ * Returns the number of mappings in the Table.
+ * Θ(1)
+ */
+size_t ltable_size(const LinkedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    const size_t size = table->size;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return size;
+}
+
+/*
+ * Returns true if the Table is empty.
+ * Θ(1)
+ */
+bool ltable_empty(const LinkedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    const bool empty = table->size == 0;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return empty;
+}
+
+/*
+ * Returns true if the Table contains a mapping with the specified key.
+ * The mapping is never re-ordered.
+ * Ω(1), O(n)
+ */
+bool ltable_contains(const LinkedTable* const table, const void* const key)
+{
+    return ltable_peek(table, key) != NULL;
+}
+
+/*
+ * Prints out the contents of the Table to the console window.
+ * Mappings are printed in order.
+ * Θ(n)
+ */
+void ltable_print(const LinkedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(table->toString != NULL, IO_MSG_NOT_SUPPORTED);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    printf("%c", '[');
+    for (unsigned int i = table->head; i != LTABLE_END; i = table->entries[i].after)
+    {
+        const ltable_Entry* const entry = &table->entries[i];
+        printf("%s", table->toString(entry->key, entry->value));
+        if (entry->after != LTABLE_END) printf(", ");
+    }
+    printf("]\n");
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+}
+
+/*
+ * Inserts a mapping into the Table.
+ * New mappings are placed at the back of the order.
+ * If the Table already contained a mapping for the key, the old value is replaced.
+ * In access order, replacing a value also moves the mapping to the back of the order.
+ * Returns the replaced value or NULL if this is a new mapping.
+ * Ω(1), O(n)
+ */
+void* ltable_put(LinkedTable* const table, const void* const key, const void* const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+
+    const void *replaced = NULL;
+    const unsigned int hash = ltable_hash(table, key);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    const unsigned int located = ltable_search(table, key, hash, NULL);
+    if (located == LTABLE_END)
+    {
+        const unsigned int index = ltable_allocate(table);
+        ltable_Entry* const inserted = &table->entries[index];
+        inserted->key = key;
+        inserted->value = value;
+        inserted->hash = hash;
+
+        unsigned int* const bucket = &table->buckets[BUCKET(hash, table->capacity)];
+        inserted->next = *bucket;
+        *bucket = index;
+        ltable_attach(table, index, false);
+        table->size++;
+    }
+    /* Duplicate key entered; update the value. */
+    else
+    {
+        replaced = table->entries[located].value;
+        table->entries[located].value = value;
+        if (table->access_order)
+        {
+            ltable_detach(table, located);
+            ltable_attach(table, located, false);
+        }
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return (void*)replaced;
+}
+
+/*
+ * Removes a key/value pair from the Table and returns true if the removal was successful.
+ * Ω(1), O(n)
+ */
+bool ltable_remove(LinkedTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const unsigned int hash = ltable_hash(table, key);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    unsigned int prev;
+    const unsigned int index = ltable_search(table, key, hash, &prev);
+    const bool removed = index != LTABLE_END;
+    if (removed)
+        ltable_delete(table, index, prev);
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return removed;
+}
+
+/*
+ * Removes the first mapping in order, returning its key and storing its value into `value` if non-NULL.
+ * In access order, this evicts the least-recently used mapping.
+ * see: ltable_pop
+ * Ω(1), O(n)
+ */
+void* ltable_pop_front(LinkedTable* const table, void** const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    io_assert(table->size > 0, IO_MSG_EMPTY);
+
+    void* const key = ltable_pop(table, table->head, value);
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return key;
+}
+
+/*
+ * Removes the last mapping in order, returning its key and storing its value into `value` if non-NULL.
+ * see: ltable_pop
+ * Ω(1), O(n)
+ */
+void* ltable_pop_back(LinkedTable* const table, void** const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    io_assert(table->size > 0, IO_MSG_EMPTY);
+
+    void* const key = ltable_pop(table, table->tail, value);
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return key;
+}
+
+/*
+ * Moves a mapping to the front of the order and returns true if the mapping exists.
+ * Ω(1), O(n)
+ */
+bool ltable_move_front(LinkedTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const unsigned int hash = ltable_hash(table, key);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    const unsigned int index = ltable_search(table, key, hash, NULL);
+    const bool found = index != LTABLE_END;
+    if (found)
+    {
+        ltable_detach(table, index);
+        ltable_attach(table, index, true);
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return found;
+}
+
+/*
+ * Moves a mapping to the back of the order and returns true if the mapping exists.
+ * Ω(1), O(n)
+ */
+bool ltable_move_back(LinkedTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const unsigned int hash = ltable_hash(table, key);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    const unsigned int index = ltable_search(table, key, hash, NULL);
+    const bool found = index != LTABLE_END;
+    if (found)
+    {
+        ltable_detach(table, index);
+        ltable_attach(table, index, false);
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return found;
+}
+
+/*
+ * Changes the Table's capacity to accommodate at least the specified number of mappings.
+ * This function can be used both to grow and shrink the Table.
+ * Specified sizes which are less than the amount of mappings are ignored.
+ * Ω(1), O(n)
+ */
+void ltable_resize(LinkedTable* const table, const size_t min_size)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    /* Capacities must adhere to the load factor and default initial capacity. */
+    size_t desired_capacity = (size_t)ceil(min_size / (double)LOAD_FACTOR);
+    if (desired_capacity < DEFAULT_INITIAL_CAPACITY)
+        desired_capacity = DEFAULT_INITIAL_CAPACITY;
+    /* Rounding may leave the design load one short. */
+    while (DESIGN_LOAD(desired_capacity) < min_size)
+        desired_capacity++;
+
+    /* The new capacity must still be able to hold every mapping. */
+    if (DESIGN_LOAD(desired_capacity) >= table->size)
+        ltable_rebuild(table, desired_capacity);
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+}
+
+/*
+ * Removes all key/value pairs from the Table while preserving the capacity.
+ * Θ(n)
+ */
+void ltable_clear(LinkedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    /* Every non-empty bucket leads to a mapping, so emptying those buckets empties all of them. */
+    for (unsigned int i = table->head; i != LTABLE_END; i = table->entries[i].after)
+        table->buckets[BUCKET(table->entries[i].hash, table->capacity)] = LTABLE_END;
+    table->free = table->head = table->tail = LTABLE_END;
+    table->used = table->size = 0;
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void ltable_destroy(LinkedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    mem_free(table->entries, DESIGN_LOAD(table->capacity) * sizeof(ltable_Entry));
+    mem_free(table->buckets, table->capacity * sizeof(unsigned int));
+    sync_destroy(table->rw_sync);
+    mem_free(table, sizeof(LinkedTable));
+}
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+ltable_Iterator* ltable_iter(const LinkedTable* const table, const bool reverse)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    ltable_Iterator* const iter = mem_calloc(1, sizeof(ltable_Iterator));
+    iter->ref = table;
+    iter->reverse = reverse;
+    iter->index = reverse ? table->tail : table->head;
+    return iter;
+}
+
+/*
+ * Returns the iterator's current key/value pair and advances it forward.
+ * The key will be returned and the value will be assigned to the data of the parameter.
+ * Θ(1)
+ */
+void* ltable_iter_next(ltable_Iterator* const iter, void** const value)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    io_assert(ltable_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+
+    const ltable_Entry* const current = &iter->ref->entries[iter->index];
+    iter->index = iter->reverse ? current->before : current->after;
+    if (value != NULL) *value = (void*)current->value;
+
+    return (void*)current->key;
+}
+
+/*
+ * Returns true if the iterator has a next key/value pair.
+ * Θ(1)
+ */
+bool ltable_iter_has_next(const ltable_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return iter->index != LTABLE_END;
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void ltable_iter_destroy(ltable_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    mem_free(iter, sizeof(ltable_Iterator));
+}
+
+/*
+ * Returns the index of the entry whose key matches the specified key.
+ * If no such entry exists, LTABLE_END is returned.
+ * The parameter `prev`, if provided, is set to the index of the preceding entry in the chain.
+ * Ω(1), O(n)
+ */
+static unsigned int ltable_search(const LinkedTable* const table, const void* const key,
+                                  const unsigned int hash, unsigned int* const prev)
+{
+    unsigned int before = LTABLE_END, current = table->buckets[BUCKET(hash, table->capacity)];
+    while (current != LTABLE_END)
+    {
+        const ltable_Entry* const entry = &table->entries[current];
+        if (entry->hash == hash && table->equals(entry->key, key))
+            break;
+        before = current;
+        current = entry->next;
+    }
+
+    if (prev != NULL) *prev = before;
+    return current;
+}
+
+/*
+ * Returns the hash of a key.
+ * Buckets are chosen by the upper bits of the hash, so the hash is always avalanched.
+ * Θ(1)
+ */
+static unsigned int ltable_hash(const LinkedTable* const table, const void* const key)
+{
+    return math_fmix32(table->hash(key));
+}
+
+/*
+ * Returns the index of an unused entry, re-using freed entries first.
+ * The Table is expanded once every entry is in use.
+ * Note: The Table must already be locked.
+ * Θ(1) amortized
+ */
+static unsigned int ltable_allocate(LinkedTable* const table)
+{
+    if (table->free != LTABLE_END)
+    {
+        const unsigned int index = table->free;
+        table->free = table->entries[index].next;
+        return index;
+    }
+
+    if (table->used >= DESIGN_LOAD(table->capacity))
+        ltable_rebuild(table, table->capacity * GROW_FACTOR);
+    return (unsigned int)table->used++;
+}
+
+/*
+ * Removes the entry at the specified index from its chain and the order, then frees it.
+ * The parameter `prev` is the index of the preceding entry in the chain.
+ * Θ(1)
+ */
+static void ltable_delete(LinkedTable* const table, const unsigned int index, const unsigned int prev)
+{
+    ltable_Entry* const entry = &table->entries[index];
+    /* Determine if this entry is root of the chain. */
+    if (prev != LTABLE_END)
+        table->entries[prev].next = entry->next;
+    else table->buckets[BUCKET(entry->hash, table->capacity)] = entry->next;
+    ltable_detach(table, index);
+
+    entry->key = entry->value = NULL;
+    entry->next = table->free;
+    table->free = index;
+    table->size--;
+}
+
+/*
+ * Unlinks the entry at the specified index from the order.
+ * Θ(1)
+ */
+static void ltable_detach(LinkedTable* const table, const unsigned int index)
+{
+    const ltable_Entry* const entry = &table->entries[index];
+    if (entry->before != LTABLE_END)
+        table->entries[entry->before].after = entry->after;
+    else table->head = entry->after;
+    if (entry->after != LTABLE_END)
+        table->entries[entry->after].before = entry->before;
+    else table->tail = entry->before;
+}
+
+/*
+ * Links the entry at the specified index into the front or back of the order.
+ * Θ(1)
+ */
+static void ltable_attach(LinkedTable* const table, const unsigned int index, const bool front)
+{
+    ltable_Entry* const entry = &table->entries[index];
+    if (front)
+    {
+        entry->before = LTABLE_END;
+        entry->after = table->head;
+        if (table->head != LTABLE_END)
+            table->entries[table->head].before = index;
+        else table->tail = index;
+        table->head = index;
+    }
+    else
+    {
+        entry->after = LTABLE_END;
+        entry->before = table->tail;
+        if (table->tail != LTABLE_END)
+            table->entries[table->tail].after = index;
+        else table->head = index;
+        table->tail = index;
+    }
+}
+
+/*
+ * Removes the entry at the specified index, returning its key and storing its value into `value` if non-NULL.
+ * The entry's chain is searched only to find its predecessor.
+ * Ω(1), O(n)
+ */
+static void* ltable_pop(LinkedTable* const table, const unsigned int index, void** const value)
+{
+    const ltable_Entry* const entry = &table->entries[index];
+    const void* const key = entry->key;
+    if (value != NULL) *value = (void*)entry->value;
+
+    unsigned int prev = LTABLE_END, current = table->buckets[BUCKET(entry->hash, table->capacity)];
+    while (current != index)
+    {
+        prev = current;
+        current = table->entries[current].next;
+    }
+
+    ltable_delete(table, index, prev);
+    return (void*)key;
+}
+
+/*
+ * Moves every mapping into newly allocated arrays of the specified capacity.
+ * Entries are packed in order, which also discards the free list.
+ * Note: The Table must already be locked, and the capacity must hold every mapping.
+ * Θ(n + c), where c is the new capacity
+ */
+static void ltable_rebuild(LinkedTable* const table, const size_t capacity)
+{
+    ltable_Entry* const entries = table->entries;
+    unsigned int* const buckets = table->buckets;
+    const size_t old_capacity = table->capacity;
+    unsigned int current = table->head;
+
+    table->buckets = mem_malloc(capacity * sizeof(unsigned int));
+    memset(table->buckets, 0xFF, capacity * sizeof(unsigned int));
+    table->entries = mem_calloc(DESIGN_LOAD(capacity), sizeof(ltable_Entry));
+    table->capacity = capacity;
+    table->free = table->head = table->tail = LTABLE_END;
+
+    for (table->used = 0; current != LTABLE_END; current = entries[current].after)
+    {
+        const unsigned int index = (unsigned int)table->used++;
+        ltable_Entry* const entry = &table->entries[index];
+        *entry = entries[current];
+
+        unsigned int* const bucket = &table->buckets[BUCKET(entry->hash, capacity)];
+        entry->next = *bucket;
+        *bucket = index;
+        ltable_attach(table, index, false);
+    }
+
+    mem_free(entries, DESIGN_LOAD(old_capacity) * sizeof(ltable_Entry));
+    mem_free(buckets, old_capacity * sizeof(unsigned int));
+}
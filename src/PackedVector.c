@@ -0,0 +1,601 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       PackedVector.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/PackedVector.h"
+#include <limits.h>
+
+/* Blocks are decoded four lanes at a time with SSE2 where it is available. */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PVECT_SSE2
+#endif
+
+/* Number of integers in a block. */
+#define BLOCK 128
+/* Number of interleaved lanes within a block. */
+#define LANES 4
+/* Array capacity components. */
+#define DEFAULT_INITIAL_CAPACITY 16
+#define GROW_FACTOR 2
+
+/* Number of bits required to store the specified value. */
+#define BITS(value) ((value) != 0 ? math_ilog2(value) + 1 : 0)
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+/* Mask of the lowest `bits` bits. */
+#define MASK(bits) ((bits) < 32 ? (1u << (bits)) - 1 : UINT_MAX)
+
+/*
+ * Layout:
+ * Integers are compressed in blocks of 128. Each block is stored relative to a base, its minimum, either
+ * as frame-of-reference offsets from the base, or as gaps from the integer four positions before it.
+ * Gaps are chosen when every integer is at least the one four positions before it and the gaps need fewer
+ * bits, which is the case for sorted lists. Every offset or gap of a block is bit-packed into the same number
+ * of bits, the fewest which fit the largest of them.
+ * Packed integers are interleaved across four lanes of 32-bit words, integer i being stored in lane i % 4.
+ * A single SSE2 shift and mask therefore decodes four consecutive integers, and gaps taken four positions
+ * apart are summed back into integers by one vector addition per four integers.
+ * Integers after the last full block are kept uncompressed until the block fills up.
+ * For details, see: https://arxiv.org/abs/1209.2137
+ */
+
+/* PackedVector structure. */
+struct PackedVector
+{
+    struct pvect_Block *blocks;
+    size_t block_count, block_capacity;
+    /* Packed words of every block. */
+    unsigned int *words;
+    size_t word_count, word_capacity;
+    /* Integers after the last full block, which are not yet compressed. */
+    unsigned int tail[BLOCK];
+    size_t tail_size;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+};
+
+/* Block structure. */
+typedef struct pvect_Block
+{
+    /* Index of the block's first packed word. */
+    size_t offset;
+    /* Minimum integer of the block. */
+    unsigned int base;
+    /* Bits per packed integer. The block occupies 4 * bits words. */
+    unsigned char bits;
+    /* True if the block packs gaps rather than offsets. */
+    bool delta;
+} pvect_Block;
+
+/* Structure to assist in looping through Vector. */
+struct pvect_Iterator
+{
+    /* Index of the next integer to be iterated. */
+    size_t index;
+    /* Decoded integers of the current block. */
+    unsigned int buffer[BLOCK];
+    /* Reference to the Vector that it is iterating through. */
+    const PackedVector *ref;
+};
+
+/* Local functions. */
+static size_t pvect_length(const PackedVector* const vect);
+static void pvect_seal(PackedVector* const vect);
+static void pvect_pack(const unsigned int* const values, const unsigned int bits, unsigned int* const words);
+static unsigned int pvect_extract(const unsigned int* const words, const unsigned int bits, const size_t index);
+static void pvect_unpack(const unsigned int* const words, const unsigned int bits, unsigned int* const out);
+static void pvect_decode(const PackedVector* const vect, const size_t block, unsigned int* const out);
+static unsigned int pvect_get(const PackedVector* const vect, const size_t index);
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+PackedVector* PackedVector_new()
+{
+    PackedVector* const vect = mem_calloc(1, sizeof(PackedVector));
+    vect->blocks = mem_malloc(DEFAULT_INITIAL_CAPACITY * sizeof(pvect_Block));
+    vect->block_capacity = DEFAULT_INITIAL_CAPACITY;
+    vect->words = mem_malloc(DEFAULT_INITIAL_CAPACITY * sizeof(unsigned int));
+    vect->word_capacity = DEFAULT_INITIAL_CAPACITY;
+    vect->rw_sync = ReadWriteSync_new();
+    return vect;
+}
+
+/*
+ * Returns the integer at the specified index.
+ * Frame-of-reference blocks are read in place, while gap blocks are summed up to the index.
+ * Ω(1), O(b), where b is the number of integers in a block.
+ */
+unsigned int pvect_at(const PackedVector* const vect, const size_t index)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(vect->rw_sync);
+
+    io_assert(index < pvect_length(vect), IO_MSG_OUT_OF_BOUNDS);
+    const unsigned int value = pvect_get(vect, index);
+
+    /* Unlock the data structure. */
+    sync_read_end(vect->rw_sync);
+
+    return value;
+}
+
+/*
+ * Copies `count` integers starting from the specified index into `out`.
+ * Whole blocks are decoded directly into `out`.
+ * Θ(c), where c is the number of integers copied.
+ */
+void pvect_copy(const PackedVector* const vect, const size_t index, const size_t count, unsigned int* const out)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+    io_assert(out != NULL || count == 0, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(vect->rw_sync);
+
+    io_assert(index <= pvect_length(vect) && count <= pvect_length(vect) - index, IO_MSG_OUT_OF_BOUNDS);
+
+    unsigned int buffer[BLOCK];
+    size_t copied = 0;
+    while (copied < count)
+    {
+        const size_t position = index + copied;
+        const size_t block = position / BLOCK, start = position % BLOCK;
+        const size_t length = MIN(BLOCK - start, count - copied);
+
+        if (block == vect->block_count)
+            memcpy(out + copied, vect->tail + start, length * sizeof(unsigned int));
+        else if (length == BLOCK)
+            pvect_decode(vect, block, out + copied);
+        else
+        {
+            pvect_decode(vect, block, buffer);
+            memcpy(out + copied, buffer + start, length * sizeof(unsigned int));
+        }
+        copied += length;
+    }
+
+    /* Unlock the data structure. */
+    sync_read_end(vect->rw_sync);
+}
+
+/*
+ * Returns the number of integers in the Vector.
+ * Θ(1)
+ */
+size_t pvect_size(const PackedVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(vect->rw_sync);
+
+    const size_t size = pvect_length(vect);
+
+    /* Unlock the data structure. */
+    sync_read_end(vect->rw_sync);
+
+    return size;
+}
+
+/*
+ * Returns true if the Vector is empty.
+ * Θ(1)
+ */
+bool pvect_empty(const PackedVector* const vect)
+{
+    return pvect_size(vect) == 0;
+}
+
+/*
+ * Returns the number of bytes which the Vector's integers occupy, compressed or not.
+ * Θ(1)
+ */
+size_t pvect_bytes(const PackedVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(vect->rw_sync);
+
+    const size_t bytes = vect->word_count * sizeof(unsigned int) + vect->block_count * sizeof(pvect_Block)
+                         + vect->tail_size * sizeof(unsigned int);
+
+    /* Unlock the data structure. */
+    sync_read_end(vect->rw_sync);
+
+    return bytes;
+}
+
+/*
+ * Prints out the contents of the Vector to the console window.
+ * Θ(n)
+ */
+void pvect_print(const PackedVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(vect->rw_sync);
+
+    unsigned int buffer[BLOCK];
+    printf("%c", '[');
+    for (size_t block = 0; block <= vect->block_count; block++)
+    {
+        const unsigned int* const values = block < vect->block_count ? buffer : vect->tail;
+        const size_t length = block < vect->block_count ? BLOCK : vect->tail_size;
+        if (block < vect->block_count) pvect_decode(vect, block, buffer);
+        for (size_t i = 0; i < length; i++)
+            printf(block == 0 && i == 0 ? "%u" : ", %u", values[i]);
+    }
+    printf("]\n");
+
+    /* Unlock the data structure. */
+    sync_read_end(vect->rw_sync);
+}
+
+/*
+ * Inserts an integer at the back of the Vector.
+ * Θ(1) amortized.
+ */
+void pvect_push_back(PackedVector* const vect, const unsigned int value)
+{
+    pvect_append(vect, &value, 1);
+}
+
+/*
+ * Inserts `count` integers at the back of the Vector.
+ * Each block is compressed as soon as it fills up.
+ * Θ(c), where c is the number of integers inserted.
+ */
+void pvect_append(PackedVector* const vect, const unsigned int* const values, const size_t count)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+    io_assert(values != NULL || count == 0, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(vect->rw_sync);
+
+    size_t appended = 0;
+    while (appended < count)
+    {
+        const size_t length = MIN(BLOCK - vect->tail_size, count - appended);
+        memcpy(vect->tail + vect->tail_size, values + appended, length * sizeof(unsigned int));
+        vect->tail_size += length;
+        appended += length;
+        if (vect->tail_size == BLOCK) pvect_seal(vect);
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(vect->rw_sync);
+}
+
+/*
+ * Removes the integer at the back of the Vector and returns it.
+ * Removing from a compressed block first decompresses it back into the tail.
+ * Θ(1) amortized.
+ */
+unsigned int pvect_pop_back(PackedVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(vect->rw_sync);
+
+    io_assert(pvect_length(vect) > 0, IO_MSG_EMPTY);
+    if (vect->tail_size == 0)
+    {
+        const pvect_Block* const last = &vect->blocks[vect->block_count - 1];
+        pvect_decode(vect, vect->block_count - 1, vect->tail);
+        vect->word_count = last->offset;
+        vect->block_count--;
+        vect->tail_size = BLOCK;
+    }
+    const unsigned int value = vect->tail[--vect->tail_size];
+
+    /* Unlock the data structure. */
+    sync_write_end(vect->rw_sync);
+
+    return value;
+}
+
+/*
+ * Removes all integers from the Vector.
+ * Θ(1)
+ */
+void pvect_clear(PackedVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(vect->rw_sync);
+
+    vect->block_count = vect->word_count = vect->tail_size = 0;
+
+    /* Unlock the data structure. */
+    sync_write_end(vect->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void pvect_destroy(PackedVector* const vect)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    mem_free(vect->blocks, vect->block_capacity * sizeof(pvect_Block));
+    mem_free(vect->words, vect->word_capacity * sizeof(unsigned int));
+    sync_destroy(vect->rw_sync);
+    mem_free(vect, sizeof(PackedVector));
+}
+
+/*
+ * Constructor function.
+ * Θ(b), where b is the number of integers in a block.
+ */
+pvect_Iterator* pvect_iter(const PackedVector* const vect, const size_t index)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+    io_assert(index <= pvect_length(vect), IO_MSG_OUT_OF_BOUNDS);
+
+    pvect_Iterator* const iter = mem_malloc(sizeof(pvect_Iterator));
+    iter->ref = vect;
+    iter->index = index;
+    if (index % BLOCK != 0 && index / BLOCK < vect->block_count)
+        pvect_decode(vect, index / BLOCK, iter->buffer);
+    return iter;
+}
+
+/*
+ * Returns the iterator's current integer and advances it forward.
+ * Θ(1) amortized.
+ */
+unsigned int pvect_iter_next(pvect_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    io_assert(pvect_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+
+    const PackedVector* const vect = iter->ref;
+    const size_t block = iter->index / BLOCK, position = iter->index++ % BLOCK;
+    if (block == vect->block_count) return vect->tail[position];
+
+    /* Decode each block upon entering it. */
+    if (position == 0) pvect_decode(vect, block, iter->buffer);
+    return iter->buffer[position];
+}
+
+/*
+ * Returns true if the iterator has a next integer.
+ * Θ(1)
+ */
+bool pvect_iter_has_next(const pvect_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return iter->index < pvect_length(iter->ref);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void pvect_iter_destroy(pvect_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    mem_free(iter, sizeof(pvect_Iterator));
+}
+
+/*
+ * Returns the number of integers in the Vector.
+ * Θ(1)
+ */
+static size_t pvect_length(const PackedVector* const vect)
+{
+    return vect->block_count * BLOCK + vect->tail_size;
+}
+
+/*
+ * Compresses the full tail into a new block.
+ * Gaps are packed instead of offsets when they are valid and need fewer bits.
+ * Θ(b) amortized, where b is the number of integers in a block.
+ */
+static void pvect_seal(PackedVector* const vect)
+{
+    const unsigned int* const tail = vect->tail;
+    unsigned int min = tail[0], max = tail[0];
+    for (unsigned int i = 1; i < BLOCK; i++)
+    {
+        if (tail[i] < min) min = tail[i];
+        if (tail[i] > max) max = tail[i];
+    }
+
+    unsigned int offsets[BLOCK], gaps[BLOCK], max_gap = 0;
+    bool delta = true;
+    for (unsigned int i = 0; i < BLOCK; i++)
+    {
+        const unsigned int previous = i < LANES ? min : tail[i - LANES];
+        offsets[i] = tail[i] - min;
+        if (tail[i] < previous) delta = false;
+        gaps[i] = tail[i] - previous;
+        if (gaps[i] > max_gap) max_gap = gaps[i];
+    }
+
+    /* Ties favor offsets, which can be read in place. */
+    const unsigned int offset_bits = BITS(max - min), gap_bits = BITS(max_gap);
+    delta = delta && gap_bits < offset_bits;
+    const unsigned int bits = delta ? gap_bits : offset_bits;
+
+    if (vect->block_count == vect->block_capacity)
+    {
+        vect->blocks = mem_realloc(vect->blocks, vect->block_capacity * sizeof(pvect_Block),
+                                   vect->block_capacity * GROW_FACTOR * sizeof(pvect_Block));
+        vect->block_capacity *= GROW_FACTOR;
+    }
+    const size_t words = LANES * bits;
+    if (vect->word_count + words > vect->word_capacity)
+    {
+        size_t capacity = vect->word_capacity * GROW_FACTOR;
+        while (vect->word_count + words > capacity)
+            capacity *= GROW_FACTOR;
+        vect->words = mem_realloc(vect->words, vect->word_capacity * sizeof(unsigned int),
+                                  capacity * sizeof(unsigned int));
+        vect->word_capacity = capacity;
+    }
+
+    pvect_Block* const block = &vect->blocks[vect->block_count++];
+    block->offset = vect->word_count;
+    block->base = min;
+    block->bits = (unsigned char)bits;
+    block->delta = delta;
+    pvect_pack(delta ? gaps : offsets, bits, vect->words + block->offset);
+    vect->word_count += words;
+    vect->tail_size = 0;
+}
+
+/*
+ * Bit-packs a block of integers into `words`, interleaved across four lanes.
+ * Integer i is packed into lane i % 4 at bit (i / 4) * bits of that lane.
+ * Θ(b), where b is the number of integers in a block.
+ */
+static void pvect_pack(const unsigned int* const values, const unsigned int bits, unsigned int* const words)
+{
+    memset(words, 0, LANES * bits * sizeof(unsigned int));
+    if (bits == 0) return;
+
+    for (size_t i = 0; i < BLOCK; i++)
+    {
+        const size_t position = (i / LANES) * bits, lane = i % LANES;
+        const size_t word = position / 32, shift = position % 32;
+        words[word * LANES + lane] |= values[i] << shift;
+        if (shift + bits > 32)
+            words[(word + 1) * LANES + lane] |= values[i] >> (32 - shift);
+    }
+}
+
+/*
+ * Returns the packed integer at the specified index of a block.
+ * Θ(1)
+ */
+static unsigned int pvect_extract(const unsigned int* const words, const unsigned int bits, const size_t index)
+{
+    if (bits == 0) return 0;
+
+    const size_t position = (index / LANES) * bits, lane = index % LANES;
+    const size_t word = position / 32, shift = position % 32;
+    unsigned int value = words[word * LANES + lane] >> shift;
+    if (shift + bits > 32)
+        value |= words[(word + 1) * LANES + lane] << (32 - shift);
+    return value & MASK(bits);
+}
+
+/*
+ * Unpacks a block of integers from `words` into `out`.
+ * With SSE2, each step shifts and masks one word of every lane at once, yielding four integers.
+ * Θ(b), where b is the number of integers in a block.
+ */
+static void pvect_unpack(const unsigned int* const words, const unsigned int bits, unsigned int* const out)
+{
+    if (bits == 0)
+    {
+        memset(out, 0, BLOCK * sizeof(unsigned int));
+        return;
+    }
+
+#ifdef PVECT_SSE2
+    const __m128i mask = _mm_set1_epi32((int)MASK(bits));
+    const __m128i *next = (const __m128i*)words;
+    __m128i word = _mm_loadu_si128(next++);
+    unsigned int shift = 0;
+    for (unsigned int i = 0; i < BLOCK / LANES; i++)
+    {
+        __m128i value = _mm_srl_epi32(word, _mm_cvtsi32_si128((int)shift));
+        shift += bits;
+
+        /* Continue into the next word of each lane, unless the block is exhausted. */
+        if (shift >= 32 && i + 1 < BLOCK / LANES)
+        {
+            shift -= 32;
+            word = _mm_loadu_si128(next++);
+            if (shift > 0)
+                value = _mm_or_si128(value, _mm_sll_epi32(word, _mm_cvtsi32_si128((int)(bits - shift))));
+        }
+        _mm_storeu_si128((__m128i*)(out + i * LANES), _mm_and_si128(value, mask));
+    }
+#else
+    for (size_t i = 0; i < BLOCK; i++)
+        out[i] = pvect_extract(words, bits, i);
+#endif
+}
+
+/*
+ * Decodes the integers of the specified block into `out`.
+ * Θ(b), where b is the number of integers in a block.
+ */
+static void pvect_decode(const PackedVector* const vect, const size_t block, unsigned int* const out)
+{
+    const pvect_Block* const b = &vect->blocks[block];
+    pvect_unpack(vect->words + b->offset, b->bits, out);
+
+#ifdef PVECT_SSE2
+    /* Offsets add the base, while gaps are summed four positions apart, starting from the base. */
+    __m128i running = _mm_set1_epi32((int)b->base);
+    for (size_t i = 0; i < BLOCK; i += LANES)
+    {
+        const __m128i value = _mm_add_epi32(_mm_loadu_si128((const __m128i*)(out + i)), running);
+        if (b->delta) running = value;
+        _mm_storeu_si128((__m128i*)(out + i), value);
+    }
+#else
+    for (size_t i = 0; i < BLOCK; i++)
+        out[i] += b->delta && i >= LANES ? out[i - LANES] : b->base;
+#endif
+}
+
+/*
+ * Returns the integer at the specified index.
+ * Ω(1), O(b), where b is the number of integers in a block.
+ */
+static unsigned int pvect_get(const PackedVector* const vect, const size_t index)
+{
+    const size_t block = index / BLOCK, position = index % BLOCK;
+    if (block == vect->block_count) return vect->tail[position];
+
+    const pvect_Block* const b = &vect->blocks[block];
+    const unsigned int* const words = vect->words + b->offset;
+    if (!b->delta) return b->base + pvect_extract(words, b->bits, position);
+
+    /* Sum the gaps of the integer's lane up to its position. */
+    unsigned int value = b->base;
+    for (size_t i = position % LANES; i <= position; i += LANES)
+        value += pvect_extract(words, b->bits, i);
+    return value;
+}
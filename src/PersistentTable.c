@@ -0,0 +1,703 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       PersistentTable.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/PersistentTable.h"
+#include <limits.h>
+
+/* Number of hash bits consumed by each level of the trie. */
+#define LEVEL_BITS 5
+#define LEVEL_MASK ((1U << LEVEL_BITS) - 1)
+/* Total number of hash bits. Nodes below this shift hold keys whose entire hash collides. */
+#define HASH_BITS (sizeof(unsigned int) * CHAR_BIT)
+/* Maximum number of levels, including the collision level. */
+#define MAX_DEPTH (MATH_DIV_CEIL(HASH_BITS, LEVEL_BITS) + 1)
+
+/* Bit of a Node's maps which a hash occupies at the specified shift. */
+#define BIT(hash, shift) (1U << (((hash) >> (shift)) & LEVEL_MASK))
+/* Index into a Node's entries or children of a bit within its map. */
+#define INDEX(map, bit) math_popcount((map) & ((bit) - 1))
+/* Nodes at or below this shift are collision Nodes. */
+#define COLLISION(shift) ((shift) >= HASH_BITS)
+
+/*
+ * Hash array mapped trie (compressed, CHAMP layout):
+ * Each Node has a bitmap of the hash fragments which lead directly to an entry,
+ * and a bitmap of those which lead to a child Node. Entries and children are packed into
+ * arrays, indexed by the number of set bits below a fragment's bit.
+ * A child always holds at least two entries, so a removal which leaves a child with
+ * a single entry moves that entry up into the parent.
+ *
+ * Nodes are reference counted and shared between clones. A Node with a single reference
+ * belongs to one Table, and is updated in place. Any other Node is copied before being updated.
+ */
+
+/* Entry structure. */
+typedef struct ptable_Entry
+{
+    const void *key, *value;
+    unsigned int hash;
+} ptable_Entry;
+
+/* Node structure. Entries and children are allocated along with the Node, and their counts never change. */
+typedef struct ptable_Node
+{
+    sync_Word refs;
+    unsigned int datamap, nodemap;
+    /* Number of entries. Collision Nodes have no maps, so it cannot be calculated from the data map. */
+    unsigned int count;
+    ptable_Entry *entries;
+    struct ptable_Node **children;
+} ptable_Node;
+
+/* PersistentTable structure. */
+struct PersistentTable
+{
+    ptable_Node *root;
+    size_t size;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+
+    /* Function pointers. */
+    bool(*equals)(const void*, const void*);
+    unsigned int(*hash)(const void*);
+    char*(*toString)(const void*, const void*);
+};
+
+/* Structure to assist in looping through Table. */
+struct ptable_Iterator
+{
+    /* Path from the root to the Node being iterated, along with the progress made at each Node. */
+    struct
+    {
+        const ptable_Node *node;
+        unsigned int entry, child;
+    } stack[MAX_DEPTH];
+    unsigned int depth;
+    /* Entry to be returned next, or NULL if there are no more. */
+    const ptable_Entry *next;
+    /* Reference to the snapshot's root, which keeps the snapshot from being modified. */
+    ptable_Node *root;
+};
+
+/* Local functions. */
+static ptable_Node* ptable_Node_new(const unsigned int datamap, const unsigned int nodemap, const unsigned int count);
+static void ptable_retain(ptable_Node* const node);
+static void ptable_release(ptable_Node* const node);
+static void ptable_Node_free(ptable_Node* const node);
+static ptable_Node* ptable_reshape(ptable_Node* const node, const unsigned int datamap, const unsigned int nodemap);
+static ptable_Node* ptable_insert(const PersistentTable* const table, ptable_Node* node,
+                                  const ptable_Entry* const entry, const unsigned int shift, const void** const replaced);
+static ptable_Node* ptable_merge(const ptable_Entry* const a, const ptable_Entry* const b, const unsigned int shift);
+static ptable_Node* ptable_delete(const PersistentTable* const table, ptable_Node* node, const void* const key,
+                                  const unsigned int hash, const unsigned int shift, const void** const removed);
+static const ptable_Entry* ptable_search(const PersistentTable* const table, const void* const key);
+static bool ptable_Entry_match(const ptable_Entry* const entry, const void* const key, const unsigned int hash,
+                               bool(*equals)(const void*, const void*));
+static void ptable_iter_push(ptable_Iterator* const iter, const ptable_Node* const node);
+static void ptable_iter_advance(ptable_Iterator* const iter);
+
+/*
+ * Constructor function.
+ * The `hash` function must be defined to call this function.
+ * The `equals` function must be defined to call this function.
+ * Θ(1)
+ */
+PersistentTable* PersistentTable_new(unsigned int(*hash)(const void*),
+                                     bool(*equals)(const void*, const void*),
+                                     char*(*toString)(const void*, const void*))
+{
+    io_assert(hash != NULL, IO_MSG_NOT_SUPPORTED);
+    io_assert(equals != NULL, IO_MSG_NOT_SUPPORTED);
+
+    PersistentTable* const table = mem_calloc(1, sizeof(PersistentTable));
+    table->root = ptable_Node_new(0, 0, 0);
+    table->hash = hash;
+    table->equals = equals;
+    table->toString = toString;
+    table->rw_sync = ReadWriteSync_new();
+    return table;
+}
+
+/*
+ * Returns the value of a mapping whose key matches the specified key.
+ * Returns NULL if no such mapping exists.
+ * Θ(log32(n))
+ */
+void* ptable_get(const PersistentTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    const ptable_Entry* const entry = ptable_search(table, key);
+    const void* const value = entry != NULL ? entry->value : NULL;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return (void*)value;
+}
+
+/*
+ * Returns the number of mappings in the Table.
+ * Θ(1)
+ */
+size_t ptable_size(const PersistentTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    const size_t size = table->size;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return size;
+}
+
+/*
+ * Returns true if the Table is empty.
+ * Θ(1)
+ */
+bool ptable_empty(const PersistentTable* const table)
+{
+    return ptable_size(table) == 0;
+}
+
+/*
+ * Returns true if the Table contains a mapping with the specified key.
+ * Θ(log32(n))
+ */
+bool ptable_contains(const PersistentTable* const table, const void* const key)
+{
+    return ptable_get(table, key) != NULL;
+}
+
+/*
+ * Prints out the contents of the Table to the console window.
+ * Θ(n)
+ */
+void ptable_print(const PersistentTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    ptable_Iterator* const iter = ptable_iter(table);
+    printf("%c", '[');
+    while (ptable_iter_has_next(iter))
+    {
+        void *value;
+        const void* const key = ptable_iter_next(iter, &value);
+        printf("%s", table->toString(key, value));
+        if (ptable_iter_has_next(iter)) printf(", ");
+    }
+    printf("]\n");
+    ptable_iter_destroy(iter);
+}
+
+/*
+ * Returns a shallow copy of the Table.
+ * The copy shares every Node with the Table until either of them is modified.
+ * Θ(1)
+ */
+PersistentTable* ptable_clone(const PersistentTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    PersistentTable* const copy = PersistentTable_new(table->hash, table->equals, table->toString);
+    ptable_release(copy->root);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    ptable_retain(table->root);
+    copy->root = table->root;
+    copy->size = table->size;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    return copy;
+}
+
+/*
+ * Inserts a mapping into the Table.
+ * If the Table already contained a mapping for the key, the old value is replaced.
+ * Returns the replaced value or NULL if this is a new mapping.
+ * Θ(log32(n))
+ */
+void* ptable_put(PersistentTable* const table, const void* const key, const void* const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+
+    const ptable_Entry entry = { key, value, table->hash(key) };
+    const void *replaced = NULL;
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    table->root = ptable_insert(table, table->root, &entry, 0, &replaced);
+    if (replaced == NULL) table->size++;
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return (void*)replaced;
+}
+
+/*
+ * Removes a mapping from the Table whose key matches the specified key.
+ * Returns the value of the removed mapping or NULL if no such mapping exists.
+ * Θ(log32(n))
+ */
+void* ptable_remove(PersistentTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const void *removed = NULL;
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    /* Look before deleting, so that no Nodes are copied when there is nothing to remove. */
+    if (ptable_search(table, key) != NULL)
+    {
+        table->root = ptable_delete(table, table->root, key, table->hash(key), 0, &removed);
+        table->size--;
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+
+    return (void*)removed;
+}
+
+/*
+ * Removes all mappings from the Table.
+ * Nodes which are shared with clones are left to the clones.
+ * O(n)
+ */
+void ptable_clear(PersistentTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(table->rw_sync);
+
+    ptable_release(table->root);
+    table->root = ptable_Node_new(0, 0, 0);
+    table->size = 0;
+
+    /* Unlock the data structure. */
+    sync_write_end(table->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * O(n)
+ */
+void ptable_destroy(PersistentTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    ptable_release(table->root);
+    sync_destroy(table->rw_sync);
+    mem_free(table, sizeof(PersistentTable));
+}
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+ptable_Iterator* ptable_iter(const PersistentTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    ptable_Iterator* const iter = mem_calloc(1, sizeof(ptable_Iterator));
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(table->rw_sync);
+
+    /* Holding a reference to the root forces the Table to copy Nodes rather than modify them. */
+    ptable_retain(table->root);
+    iter->root = table->root;
+
+    /* Unlock the data structure. */
+    sync_read_end(table->rw_sync);
+
+    ptable_iter_push(iter, iter->root);
+    ptable_iter_advance(iter);
+    return iter;
+}
+
+/*
+ * Returns the iterator's current key/value pair and advances it forward.
+ * The key will be returned and the value will be assigned to the data of the parameter.
+ * Θ(1) amortized
+ */
+void* ptable_iter_next(ptable_Iterator* const iter, void **value)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+    io_assert(ptable_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+
+    const ptable_Entry* const current = iter->next;
+    *value = (void*)current->value;
+    ptable_iter_advance(iter);
+
+    return (void*)current->key;
+}
+
+/*
+ * Returns true if the iterator has a next key/value pair.
+ * Θ(1)
+ */
+bool ptable_iter_has_next(const ptable_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return iter->next != NULL;
+}
+
+/*
+ * De-constructor function.
+ * O(n)
+ */
+void ptable_iter_destroy(ptable_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+
+    ptable_release(iter->root);
+    mem_free(iter, sizeof(ptable_Iterator));
+}
+
+/*
+ * Constructor function.
+ * The Node starts with a single reference, and with room for the entries and children of its maps.
+ * Θ(1)
+ */
+static ptable_Node* ptable_Node_new(const unsigned int datamap, const unsigned int nodemap, const unsigned int count)
+{
+    const unsigned int children = math_popcount(nodemap);
+    ptable_Node* const node = mem_calloc(1, sizeof(ptable_Node)
+                                            + count * sizeof(ptable_Entry) + children * sizeof(ptable_Node*));
+    node->refs = 1;
+    node->datamap = datamap;
+    node->nodemap = nodemap;
+    node->count = count;
+    node->entries = (ptable_Entry*)(node + 1);
+    node->children = (ptable_Node**)(node->entries + count);
+    return node;
+}
+
+/*
+ * Adds a reference to a Node.
+ * Θ(1)
+ */
+static void ptable_retain(ptable_Node* const node)
+{
+    sync_fetch_add(&node->refs, 1);
+}
+
+/*
+ * Removes a reference to a Node. The Node and its children are released once nothing references it.
+ * O(n)
+ */
+static void ptable_release(ptable_Node* const node)
+{
+    if (sync_fetch_add(&node->refs, -1) != 1) return;
+
+    const unsigned int children = math_popcount(node->nodemap);
+    for (unsigned int i = 0; i < children; i++)
+        ptable_release(node->children[i]);
+    ptable_Node_free(node);
+}
+
+/*
+ * De-allocates a Node without releasing its children.
+ * Θ(1)
+ */
+static void ptable_Node_free(ptable_Node* const node)
+{
+    mem_free(node, sizeof(ptable_Node) + node->count * sizeof(ptable_Entry)
+                   + math_popcount(node->nodemap) * sizeof(ptable_Node*));
+}
+
+/*
+ * Returns a Node with the specified maps, holding the entries and children of the Node whose bits are in both.
+ * Slots for newly set bits are left for the caller to fill in.
+ * The caller's reference to the Node is transferred to the returned Node, which has a single reference.
+ * If the Node was not shared and its maps are unchanged, it is returned as is.
+ * Θ(1)
+ */
+static ptable_Node* ptable_reshape(ptable_Node* const node, const unsigned int datamap, const unsigned int nodemap)
+{
+    const bool shared = sync_load(&node->refs) != 1;
+    if (!shared && datamap == node->datamap && nodemap == node->nodemap)
+        return node;
+
+    ptable_Node* const copy = ptable_Node_new(datamap, nodemap, math_popcount(datamap));
+    for (unsigned int map = node->datamap & datamap; map != 0; map &= map - 1)
+    {
+        const unsigned int bit = map & (~map + 1);
+        copy->entries[INDEX(datamap, bit)] = node->entries[INDEX(node->datamap, bit)];
+    }
+    for (unsigned int map = node->nodemap; map != 0; map &= map - 1)
+    {
+        const unsigned int bit = map & (~map + 1);
+        ptable_Node* const child = node->children[INDEX(node->nodemap, bit)];
+        if (nodemap & bit)
+        {
+            copy->children[INDEX(nodemap, bit)] = child;
+            /* The child is now referenced by both the copy and the shared Node. */
+            if (shared) ptable_retain(child);
+        }
+        /* A child dropped from an unshared Node is referenced by nothing else. */
+        else if (!shared) ptable_release(child);
+    }
+
+    if (shared) ptable_release(node);
+    else ptable_Node_free(node);
+
+    return copy;
+}
+
+/*
+ * Inserts an entry into the subtree, replacing the value of any entry with a matching key.
+ * The caller's reference to the Node is transferred to the returned Node.
+ * Θ(log32(n))
+ */
+static ptable_Node* ptable_insert(const PersistentTable* const table, ptable_Node* node,
+                                  const ptable_Entry* const entry, const unsigned int shift, const void** const replaced)
+{
+    if (COLLISION(shift))
+    {
+        for (unsigned int i = 0; i < node->count; i++)
+            if (ptable_Entry_match(&node->entries[i], entry->key, entry->hash, table->equals))
+            {
+                *replaced = node->entries[i].value;
+                /* Collision Nodes have no data map to reshape by, so shared ones are copied here. */
+                if (sync_load(&node->refs) != 1)
+                {
+                    ptable_Node* const copy = ptable_Node_new(0, 0, node->count);
+                    memcpy(copy->entries, node->entries, node->count * sizeof(ptable_Entry));
+                    ptable_release(node);
+                    node = copy;
+                }
+                node->entries[i].value = entry->value;
+                return node;
+            }
+
+        ptable_Node* const grown = ptable_Node_new(0, 0, node->count + 1);
+        memcpy(grown->entries, node->entries, node->count * sizeof(ptable_Entry));
+        grown->entries[node->count] = *entry;
+        ptable_release(node);
+        return grown;
+    }
+
+    const unsigned int bit = BIT(entry->hash, shift);
+    if (node->datamap & bit)
+    {
+        const ptable_Entry existing = node->entries[INDEX(node->datamap, bit)];
+        if (ptable_Entry_match(&existing, entry->key, entry->hash, table->equals))
+        {
+            /* Duplicate key entered; update the value. */
+            *replaced = existing.value;
+            node = ptable_reshape(node, node->datamap, node->nodemap);
+            node->entries[INDEX(node->datamap, bit)].value = entry->value;
+            return node;
+        }
+
+        /* Both entries share this hash fragment, so they are pushed down into a new child. */
+        node = ptable_reshape(node, node->datamap & ~bit, node->nodemap | bit);
+        node->children[INDEX(node->nodemap, bit)] = ptable_merge(&existing, entry, shift + LEVEL_BITS);
+        return node;
+    }
+
+    if (node->nodemap & bit)
+    {
+        node = ptable_reshape(node, node->datamap, node->nodemap);
+        ptable_Node** const child = &node->children[INDEX(node->nodemap, bit)];
+        *child = ptable_insert(table, *child, entry, shift + LEVEL_BITS, replaced);
+        return node;
+    }
+
+    node = ptable_reshape(node, node->datamap | bit, node->nodemap);
+    node->entries[INDEX(node->datamap, bit)] = *entry;
+    return node;
+}
+
+/*
+ * Returns a new Node holding two entries whose hashes match up to the specified shift.
+ * Θ(1)
+ */
+static ptable_Node* ptable_merge(const ptable_Entry* const a, const ptable_Entry* const b, const unsigned int shift)
+{
+    if (COLLISION(shift))
+    {
+        ptable_Node* const node = ptable_Node_new(0, 0, 2);
+        node->entries[0] = *a;
+        node->entries[1] = *b;
+        return node;
+    }
+
+    const unsigned int bit_a = BIT(a->hash, shift), bit_b = BIT(b->hash, shift);
+    if (bit_a == bit_b)
+    {
+        ptable_Node* const node = ptable_Node_new(0, bit_a, 0);
+        node->children[0] = ptable_merge(a, b, shift + LEVEL_BITS);
+        return node;
+    }
+
+    ptable_Node* const node = ptable_Node_new(bit_a | bit_b, 0, 2);
+    node->entries[INDEX(node->datamap, bit_a)] = *a;
+    node->entries[INDEX(node->datamap, bit_b)] = *b;
+    return node;
+}
+
+/*
+ * Deletes the entry with a matching key from the subtree. The entry must exist.
+ * The caller's reference to the Node is transferred to the returned Node.
+ * Θ(log32(n))
+ */
+static ptable_Node* ptable_delete(const PersistentTable* const table, ptable_Node* node, const void* const key,
+                                  const unsigned int hash, const unsigned int shift, const void** const removed)
+{
+    if (COLLISION(shift))
+    {
+        ptable_Node* const shrunk = ptable_Node_new(0, 0, node->count - 1);
+        for (unsigned int i = 0, kept = 0; i < node->count; i++)
+        {
+            if (ptable_Entry_match(&node->entries[i], key, hash, table->equals))
+                *removed = node->entries[i].value;
+            else shrunk->entries[kept++] = node->entries[i];
+        }
+        ptable_release(node);
+        return shrunk;
+    }
+
+    const unsigned int bit = BIT(hash, shift);
+    if (node->datamap & bit)
+    {
+        *removed = node->entries[INDEX(node->datamap, bit)].value;
+        return ptable_reshape(node, node->datamap & ~bit, node->nodemap);
+    }
+
+    node = ptable_reshape(node, node->datamap, node->nodemap);
+    ptable_Node** const child = &node->children[INDEX(node->nodemap, bit)];
+    *child = ptable_delete(table, *child, key, hash, shift + LEVEL_BITS, removed);
+
+    /* A child left with a single entry is replaced by that entry. */
+    if ((*child)->count == 1 && (*child)->nodemap == 0)
+    {
+        const ptable_Entry entry = (*child)->entries[0];
+        node = ptable_reshape(node, node->datamap | bit, node->nodemap & ~bit);
+        node->entries[INDEX(node->datamap, bit)] = entry;
+    }
+
+    return node;
+}
+
+/*
+ * Returns the entry whose key matches the specified key, or NULL if there is none.
+ * Θ(log32(n))
+ */
+static const ptable_Entry* ptable_search(const PersistentTable* const table, const void* const key)
+{
+    const unsigned int hash = table->hash(key);
+    const ptable_Node *node = table->root;
+
+    for (unsigned int shift = 0; !COLLISION(shift); shift += LEVEL_BITS)
+    {
+        const unsigned int bit = BIT(hash, shift);
+        if (node->datamap & bit)
+        {
+            const ptable_Entry* const entry = &node->entries[INDEX(node->datamap, bit)];
+            return ptable_Entry_match(entry, key, hash, table->equals) ? entry : NULL;
+        }
+        if ((node->nodemap & bit) == 0) return NULL;
+        node = node->children[INDEX(node->nodemap, bit)];
+    }
+
+    for (unsigned int i = 0; i < node->count; i++)
+        if (ptable_Entry_match(&node->entries[i], key, hash, table->equals))
+            return &node->entries[i];
+    return NULL;
+}
+
+/*
+ * Returns true if an Entry matches a specified hash and key.
+ * Θ(1)
+ */
+static bool ptable_Entry_match(const ptable_Entry* const entry, const void* const key, const unsigned int hash,
+                               bool(*equals)(const void*, const void*))
+{
+    return entry->hash == hash && (entry->key == key || equals(key, entry->key));
+}
+
+/*
+ * Pushes a Node onto the iterator's path.
+ * Θ(1)
+ */
+static void ptable_iter_push(ptable_Iterator* const iter, const ptable_Node* const node)
+{
+    iter->stack[iter->depth].node = node;
+    iter->stack[iter->depth].entry = iter->stack[iter->depth].child = 0;
+    iter->depth++;
+}
+
+/*
+ * Advances the iterator to the next entry: first the entries of a Node, then those of its children.
+ * Θ(1) amortized
+ */
+static void ptable_iter_advance(ptable_Iterator* const iter)
+{
+    while (iter->depth > 0)
+    {
+        const ptable_Node* const node = iter->stack[iter->depth - 1].node;
+        unsigned int* const entry = &iter->stack[iter->depth - 1].entry;
+        unsigned int* const child = &iter->stack[iter->depth - 1].child;
+
+        if (*entry < node->count)
+        {
+            iter->next = &node->entries[(*entry)++];
+            return;
+        }
+        if (*child < math_popcount(node->nodemap))
+            ptable_iter_push(iter, node->children[(*child)++]);
+        else iter->depth--;
+    }
+    iter->next = NULL;
+}
@@ -0,0 +1,1191 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       RadixTree.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/RadixTree.h"
+
+/* Node16 searches its keys with one vector comparison where SSE2 is available. */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RADIX_SSE2
+#endif
+
+/* Node layouts, from smallest to largest. */
+#define NODE4 0
+#define NODE16 1
+#define NODE48 2
+#define NODE256 3
+/* Number of prefix bytes stored within a node. */
+#define MAX_PREFIX 8
+/* Child counts at which a node shrinks into the next smaller layout. */
+#define SHRINK16 3
+#define SHRINK48 12
+#define SHRINK256 37
+/* Initial depth of an iterator's stack. */
+#define DEFAULT_STACK_CAPACITY 16
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+/* Children are tagged in their lowest bit to distinguish leaves from nodes. */
+#define IS_LEAF(child) (((size_t)(child) & 1) != 0)
+#define TO_LEAF(child) ((radix_Leaf*)((size_t)(child) & ~(size_t)1))
+#define MAKE_LEAF(leaf) ((void*)((size_t)(leaf) | 1))
+
+/*
+ * Adaptive Radix Tree:
+ * Each node branches on one byte of the key, in one of four layouts sized to its number of children.
+ * Node4 and Node16 keep sorted arrays of key bytes; Node16 compares all of them at once using SSE2.
+ * Node48 maps each byte to one of 48 child slots, while Node256 indexes its children directly.
+ * Nodes grow into the next layout when full and shrink back once sparse, keeping memory proportional to
+ * the number of keys rather than to the alphabet.
+ *
+ * Chains of nodes with a single child are compressed into a prefix stored within the node below them.
+ * Only the first MAX_PREFIX bytes are stored: searches skip over the rest optimistically and verify the
+ * whole key once they reach a leaf, while insertions recover the missing bytes from any leaf below.
+ * Children are ordered by key byte, so an in-order walk visits the keys in sorted order.
+ * A key which ends at a node, being a prefix of every other key below it, is held by the node itself.
+ * For details, see: https://db.in.tum.de/~leis/papers/ART.pdf
+ */
+
+/* RadixTree structure. */
+struct RadixTree
+{
+    /* Root node or leaf. */
+    void *root;
+    size_t size;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+
+    /* Function pointers. */
+    char*(*toString)(const void*, const void*);
+};
+
+/* Leaf structure. */
+typedef struct radix_Leaf
+{
+    const void *key, *value;
+    size_t length;
+} radix_Leaf;
+
+/* Header shared by each node layout. */
+typedef struct radix_Node
+{
+    unsigned char type;
+    unsigned short count;
+    /* Length of the compressed path, of which the first MAX_PREFIX bytes are stored. */
+    unsigned int prefix_length;
+    unsigned char prefix[MAX_PREFIX];
+    /* Mapping whose key ends at this node. */
+    radix_Leaf *leaf;
+} radix_Node;
+
+/* Node of up to 4 children, with sorted key bytes. */
+typedef struct radix_Node4
+{
+    radix_Node header;
+    unsigned char keys[4];
+    void *children[4];
+} radix_Node4;
+
+/* Node of up to 16 children, with sorted key bytes. */
+typedef struct radix_Node16
+{
+    radix_Node header;
+    unsigned char keys[16];
+    void *children[16];
+} radix_Node16;
+
+/* Node of up to 48 children, indexed through a byte-wise table. */
+typedef struct radix_Node48
+{
+    radix_Node header;
+    /* Slot of the child for each byte, offset by one. Zero marks an absent child. */
+    unsigned char index[256];
+    void *children[48];
+} radix_Node48;
+
+/* Node of up to 256 children, indexed directly. */
+typedef struct radix_Node256
+{
+    radix_Node header;
+    void *children[256];
+} radix_Node256;
+
+/* Size of each node layout. */
+static const size_t NODE_SIZE[] = {
+        sizeof(radix_Node4), sizeof(radix_Node16), sizeof(radix_Node48), sizeof(radix_Node256)
+};
+
+/* Node whose children are being visited by an iterator. */
+typedef struct radix_Frame
+{
+    const radix_Node *node;
+    /* Position of the next child to visit, whose meaning depends on the layout. */
+    unsigned int cursor;
+    /* True once the node's own leaf has been visited. */
+    bool visited;
+} radix_Frame;
+
+/* Structure to assist in looping through Tree. */
+struct radix_Iterator
+{
+    /* Stack of nodes between the root and the next leaf. */
+    radix_Frame *stack;
+    size_t depth, capacity;
+    /* Next leaf to be iterated. */
+    const radix_Leaf *next;
+    /* Upper bound of the iteration, or NULL if unbounded. */
+    const unsigned char *bound;
+    size_t bound_length;
+    /* True if the bound is a prefix of every iterated key, rather than an exclusive maximum. */
+    bool prefix;
+};
+
+/* Local functions. */
+static const radix_Leaf* radix_search(const RadixTree* const tree, const unsigned char* const key,
+                                      const size_t length);
+static void* radix_insert(RadixTree* const tree, void** const slot, const unsigned char* const key,
+                          const size_t length, size_t depth, const void* const value);
+static void* radix_delete(RadixTree* const tree, void** const slot, const unsigned char* const key,
+                          const size_t length, size_t depth);
+static bool radix_matches(const radix_Leaf* const leaf, const void* const key, const size_t length);
+static int radix_compare(const void* const a, const size_t a_length, const void* const b, const size_t b_length);
+static radix_Leaf* radix_leaf(const void* const key, const size_t length, const void* const value);
+static radix_Node* radix_node(const unsigned char type);
+static const radix_Leaf* radix_minimum(const radix_Node* node);
+static const unsigned char* radix_prefix(const radix_Node* const node, const size_t depth);
+static size_t radix_mismatch(const radix_Node* const node, const unsigned char* const key,
+                             const size_t length, const size_t depth);
+static void** radix_find(radix_Node* const node, const unsigned char byte);
+static void* radix_child(const radix_Node* const node, unsigned int* const cursor);
+static unsigned int radix_cursor(const radix_Node* const node, const unsigned char byte);
+static void radix_add(void** const slot, const unsigned char byte, void* const child);
+static void radix_erase(void** const slot, const unsigned char byte);
+static void radix_collapse(void** const slot);
+static void radix_free(void* const child);
+static radix_Iterator* radix_iter_seek(const RadixTree* const tree, const unsigned char* const low,
+                                       const size_t low_length);
+static void radix_iter_push(radix_Iterator* const iter, const radix_Node* const node,
+                            const unsigned int cursor, const bool visited);
+static const radix_Leaf* radix_iter_advance(radix_Iterator* const iter);
+static void radix_iter_bound(radix_Iterator* const iter);
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+RadixTree* RadixTree_new(char*(*toString)(const void*, const void*))
+{
+    RadixTree* const tree = mem_calloc(1, sizeof(RadixTree));
+    tree->toString = toString;
+    tree->rw_sync = ReadWriteSync_new();
+    return tree;
+}
+
+/*
+ * Returns the value of a mapping whose key matches the specified key.
+ * Returns NULL if no such mapping exists.
+ * Θ(k), where k is the length of the key.
+ */
+void* radix_get(const RadixTree* const tree, const void* const key, const size_t length)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL || length == 0, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(tree->rw_sync);
+
+    const radix_Leaf* const leaf = radix_search(tree, key, length);
+    const void* const value = leaf != NULL ? leaf->value : NULL;
+
+    /* Unlock the data structure. */
+    sync_read_end(tree->rw_sync);
+
+    return (void*)value;
+}
+
+/*
+ * Returns true if the Tree contains a mapping with the specified key.
+ * Θ(k), where k is the length of the key.
+ */
+bool radix_contains(const RadixTree* const tree, const void* const key, const size_t length)
+{
+    return radix_get(tree, key, length) != NULL;
+}
+
+/*
+ * Returns the number of mappings in the Tree.
+ * Θ(1)
+ */
+size_t radix_size(const RadixTree* const tree)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(tree->rw_sync);
+
+    const size_t size = tree->size;
+
+    /* Unlock the data structure. */
+    sync_read_end(tree->rw_sync);
+
+    return size;
+}
+
+/*
+ * Returns true if the Tree is empty.
+ * Θ(1)
+ */
+bool radix_empty(const RadixTree* const tree)
+{
+    return radix_size(tree) == 0;
+}
+
+/*
+ * Prints out the contents of the Tree to the console window.
+ * Mappings are printed in key order.
+ * Θ(n)
+ */
+void radix_print(const RadixTree* const tree)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+    io_assert(tree->toString != NULL, IO_MSG_NOT_SUPPORTED);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(tree->rw_sync);
+
+    radix_Iterator* const iter = radix_iter_seek(tree, NULL, 0);
+    printf("%c", '[');
+    while (radix_iter_has_next(iter))
+    {
+        void *value;
+        const void* const key = radix_iter_next(iter, NULL, &value);
+        printf("%s", tree->toString(key, value));
+        if (radix_iter_has_next(iter)) printf(", ");
+    }
+    printf("]\n");
+    radix_iter_destroy(iter);
+
+    /* Unlock the data structure. */
+    sync_read_end(tree->rw_sync);
+}
+
+/*
+ * Inserts a mapping into the Tree.
+ * If the Tree already contained a mapping for the key, the old value is replaced.
+ * Returns the replaced value or NULL if this is a new mapping.
+ * Θ(k), where k is the length of the key.
+ */
+void* radix_put(RadixTree* const tree, const void* const key, const size_t length, const void* const value)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL || length == 0, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(tree->rw_sync);
+
+    void* const replaced = radix_insert(tree, &tree->root, key, length, 0, value);
+
+    /* Unlock the data structure. */
+    sync_write_end(tree->rw_sync);
+
+    return replaced;
+}
+
+/*
+ * Removes a mapping from the Tree whose key matches the specified key.
+ * Returns the removed value or NULL if no such mapping exists.
+ * Θ(k), where k is the length of the key.
+ */
+void* radix_remove(RadixTree* const tree, const void* const key, const size_t length)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL || length == 0, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(tree->rw_sync);
+
+    void* const value = radix_delete(tree, &tree->root, key, length, 0);
+
+    /* Unlock the data structure. */
+    sync_write_end(tree->rw_sync);
+
+    return value;
+}
+
+/*
+ * Removes all mappings from the Tree.
+ * Θ(n)
+ */
+void radix_clear(RadixTree* const tree)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(tree->rw_sync);
+
+    if (tree->root != NULL) radix_free(tree->root);
+    tree->root = NULL;
+    tree->size = 0;
+
+    /* Unlock the data structure. */
+    sync_write_end(tree->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(n)
+ */
+void radix_destroy(RadixTree* const tree)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+
+    if (tree->root != NULL) radix_free(tree->root);
+    sync_destroy(tree->rw_sync);
+    mem_free(tree, sizeof(RadixTree));
+}
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+radix_Iterator* radix_iter(const RadixTree* const tree)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+    return radix_iter_seek(tree, NULL, 0);
+}
+
+/*
+ * Constructor function.
+ * Iterates over the keys which start with the specified prefix.
+ * Θ(k), where k is the length of the prefix.
+ */
+radix_Iterator* radix_iter_prefix(const RadixTree* const tree, const void* const prefix, const size_t length)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+    io_assert(prefix != NULL || length == 0, IO_MSG_NULL_PTR);
+
+    radix_Iterator* const iter = radix_iter_seek(tree, prefix, length);
+    iter->bound = prefix;
+    iter->bound_length = length;
+    iter->prefix = true;
+    radix_iter_bound(iter);
+    return iter;
+}
+
+/*
+ * Constructor function.
+ * Iterates over the keys in the range [low, high).
+ * Θ(k), where k is the length of `low`.
+ */
+radix_Iterator* radix_iter_range(const RadixTree* const tree, const void* const low, const size_t low_length,
+                                 const void* const high, const size_t high_length)
+{
+    io_assert(tree != NULL, IO_MSG_NULL_PTR);
+
+    radix_Iterator* const iter = radix_iter_seek(tree, low, low != NULL ? low_length : 0);
+    iter->bound = high;
+    iter->bound_length = high_length;
+    radix_iter_bound(iter);
+    return iter;
+}
+
+/*
+ * Returns the iterator's current key/value pair and advances it forward.
+ * The key will be returned, its length will be assigned to `length` and the value to `value`, if non-NULL.
+ * Ω(1), O(k), where k is the length of the longest key.
+ */
+void* radix_iter_next(radix_Iterator* const iter, size_t* const length, void** const value)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    io_assert(radix_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+
+    const radix_Leaf* const current = iter->next;
+    iter->next = radix_iter_advance(iter);
+    radix_iter_bound(iter);
+    if (length != NULL) *length = current->length;
+    if (value != NULL) *value = (void*)current->value;
+
+    return (void*)current->key;
+}
+
+/*
+ * Returns true if the iterator has a next key/value pair.
+ * Θ(1)
+ */
+bool radix_iter_has_next(const radix_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return iter->next != NULL;
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void radix_iter_destroy(radix_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    mem_free(iter->stack, iter->capacity * sizeof(radix_Frame));
+    mem_free(iter, sizeof(radix_Iterator));
+}
+
+/*
+ * Returns the leaf whose key matches the specified key, or NULL if no such leaf exists.
+ * Compressed paths are skipped optimistically past their stored bytes, then verified at the leaf.
+ * Θ(k), where k is the length of the key.
+ */
+static const radix_Leaf* radix_search(const RadixTree* const tree, const unsigned char* const key,
+                                      const size_t length)
+{
+    const void *child = tree->root;
+    size_t depth = 0;
+    while (child != NULL)
+    {
+        if (IS_LEAF(child))
+        {
+            const radix_Leaf* const leaf = TO_LEAF(child);
+            return radix_matches(leaf, key, length) ? leaf : NULL;
+        }
+
+        radix_Node* const node = (radix_Node*)child;
+        if (node->prefix_length > 0)
+        {
+            if (depth + node->prefix_length > length) return NULL;
+            const size_t stored = MIN(node->prefix_length, MAX_PREFIX);
+            if (memcmp(node->prefix, key + depth, stored) != 0) return NULL;
+            depth += node->prefix_length;
+        }
+
+        if (depth == length)
+            return node->leaf != NULL && radix_matches(node->leaf, key, length) ? node->leaf : NULL;
+
+        void** const slot = radix_find(node, key[depth++]);
+        child = slot != NULL ? *slot : NULL;
+    }
+
+    return NULL;
+}
+
+/*
+ * Inserts a mapping into the sub-tree held by `slot`, whose keys share their first `depth` bytes.
+ * Returns the replaced value or NULL if this is a new mapping.
+ * Θ(k), where k is the length of the key.
+ */
+static void* radix_insert(RadixTree* const tree, void** const slot, const unsigned char* const key,
+                          const size_t length, size_t depth, const void* const value)
+{
+    if (*slot == NULL)
+    {
+        *slot = MAKE_LEAF(radix_leaf(key, length, value));
+        tree->size++;
+        return NULL;
+    }
+
+    if (IS_LEAF(*slot))
+    {
+        radix_Leaf* const leaf = TO_LEAF(*slot);
+        if (radix_matches(leaf, key, length))
+        {
+            const void* const replaced = leaf->value;
+            leaf->value = value;
+            return (void*)replaced;
+        }
+
+        /* Split the leaf, branching where the two keys part. */
+        const unsigned char* const other = leaf->key;
+        const size_t limit = MIN(leaf->length, length);
+        size_t common = depth;
+        while (common < limit && other[common] == key[common])
+            common++;
+
+        radix_Node* const node = radix_node(NODE4);
+        node->prefix_length = (unsigned int)(common - depth);
+        memcpy(node->prefix, key + depth, MIN(node->prefix_length, MAX_PREFIX));
+        *slot = node;
+
+        if (leaf->length == common) node->leaf = leaf;
+        else radix_add(slot, other[common], MAKE_LEAF(leaf));
+        radix_Leaf* const created = radix_leaf(key, length, value);
+        if (length == common) node->leaf = created;
+        else radix_add(slot, key[common], MAKE_LEAF(created));
+        tree->size++;
+        return NULL;
+    }
+
+    radix_Node* const node = *slot;
+    if (node->prefix_length > 0)
+    {
+        const size_t mismatch = radix_mismatch(node, key, length, depth);
+        if (mismatch < node->prefix_length)
+        {
+            /* Split the compressed path, branching where the key leaves it. */
+            const unsigned char* const prefix = radix_prefix(node, depth);
+            radix_Node* const parent = radix_node(NODE4);
+            parent->prefix_length = (unsigned int)mismatch;
+            memcpy(parent->prefix, prefix, MIN(mismatch, MAX_PREFIX));
+
+            const unsigned char edge = prefix[mismatch];
+            node->prefix_length -= (unsigned int)(mismatch + 1);
+            memmove(node->prefix, prefix + mismatch + 1, MIN(node->prefix_length, MAX_PREFIX));
+            *slot = parent;
+            radix_add(slot, edge, node);
+
+            radix_Leaf* const created = radix_leaf(key, length, value);
+            if (length == depth + mismatch) parent->leaf = created;
+            else radix_add(slot, key[depth + mismatch], MAKE_LEAF(created));
+            tree->size++;
+            return NULL;
+        }
+
+        depth += node->prefix_length;
+    }
+
+    if (depth == length)
+    {
+        if (node->leaf != NULL)
+        {
+            const void* const replaced = node->leaf->value;
+            node->leaf->value = value;
+            return (void*)replaced;
+        }
+
+        node->leaf = radix_leaf(key, length, value);
+        tree->size++;
+        return NULL;
+    }
+
+    void** const child = radix_find(node, key[depth]);
+    if (child != NULL)
+        return radix_insert(tree, child, key, length, depth + 1, value);
+
+    radix_add(slot, key[depth], MAKE_LEAF(radix_leaf(key, length, value)));
+    tree->size++;
+    return NULL;
+}
+
+/*
+ * Removes the mapping of the specified key from the sub-tree held by `slot`.
+ * Nodes left sparse are shrunk, and nodes left with a single entry are merged into their parent's path.
+ * Returns the removed value or NULL if no such mapping exists.
+ * Θ(k), where k is the length of the key.
+ */
+static void* radix_delete(RadixTree* const tree, void** const slot, const unsigned char* const key,
+                          const size_t length, size_t depth)
+{
+    if (*slot == NULL) return NULL;
+
+    if (IS_LEAF(*slot))
+    {
+        /* Only reached for a leaf at the root; deeper leaves are removed by their parent. */
+        radix_Leaf* const leaf = TO_LEAF(*slot);
+        if (!radix_matches(leaf, key, length)) return NULL;
+
+        const void* const value = leaf->value;
+        mem_free(leaf, sizeof(radix_Leaf));
+        *slot = NULL;
+        tree->size--;
+        return (void*)value;
+    }
+
+    radix_Node* const node = *slot;
+    if (node->prefix_length > 0)
+    {
+        if (depth + node->prefix_length > length) return NULL;
+        const size_t stored = MIN(node->prefix_length, MAX_PREFIX);
+        if (memcmp(node->prefix, key + depth, stored) != 0) return NULL;
+        depth += node->prefix_length;
+    }
+
+    const void *value = NULL;
+    if (depth == length)
+    {
+        radix_Leaf* const leaf = node->leaf;
+        if (leaf == NULL || !radix_matches(leaf, key, length)) return NULL;
+
+        value = leaf->value;
+        mem_free(leaf, sizeof(radix_Leaf));
+        node->leaf = NULL;
+    }
+    else
+    {
+        void** const child = radix_find(node, key[depth]);
+        if (child == NULL) return NULL;
+        if (!IS_LEAF(*child))
+            return radix_delete(tree, child, key, length, depth + 1);
+
+        radix_Leaf* const leaf = TO_LEAF(*child);
+        if (!radix_matches(leaf, key, length)) return NULL;
+
+        value = leaf->value;
+        mem_free(leaf, sizeof(radix_Leaf));
+        radix_erase(slot, key[depth]);
+    }
+
+    radix_collapse(slot);
+    tree->size--;
+    return (void*)value;
+}
+
+/*
+ * Returns true if the leaf's key matches the specified key.
+ * Θ(k), where k is the length of the key.
+ */
+static bool radix_matches(const radix_Leaf* const leaf, const void* const key, const size_t length)
+{
+    return leaf->length == length && (length == 0 || memcmp(leaf->key, key, length) == 0);
+}
+
+/*
+ * Compares two keys byte-wise, ordering a key before every longer key which it is a prefix of.
+ * Returns a negative value, zero, or a positive value if `a` is less than, equal to, or greater than `b`.
+ * Θ(k), where k is the length of the shorter key.
+ */
+static int radix_compare(const void* const a, const size_t a_length, const void* const b, const size_t b_length)
+{
+    const size_t limit = MIN(a_length, b_length);
+    const int result = limit > 0 ? memcmp(a, b, limit) : 0;
+    if (result != 0) return result;
+    return a_length < b_length ? -1 : a_length > b_length;
+}
+
+/*
+ * Constructs a leaf holding the specified mapping.
+ * Θ(1)
+ */
+static radix_Leaf* radix_leaf(const void* const key, const size_t length, const void* const value)
+{
+    radix_Leaf* const leaf = mem_malloc(sizeof(radix_Leaf));
+    leaf->key = key;
+    leaf->length = length;
+    leaf->value = value;
+    return leaf;
+}
+
+/*
+ * Constructs an empty node of the specified layout.
+ * Θ(1)
+ */
+static radix_Node* radix_node(const unsigned char type)
+{
+    radix_Node* const node = mem_calloc(1, NODE_SIZE[type]);
+    node->type = type;
+    return node;
+}
+
+/*
+ * Returns the leaf with the smallest key below the specified node.
+ * Every node holds at least one leaf below it, so the result is never NULL.
+ * Θ(k), where k is the length of the key.
+ */
+static const radix_Leaf* radix_minimum(const radix_Node* node)
+{
+    while (true)
+    {
+        if (node->leaf != NULL) return node->leaf;
+
+        unsigned int cursor = 0;
+        const void* const child = radix_child(node, &cursor);
+        if (IS_LEAF(child)) return TO_LEAF(child);
+        node = child;
+    }
+}
+
+/*
+ * Returns the bytes of the node's whole compressed path, which begins at the specified depth of the key.
+ * Paths too long to be stored within the node are read from a leaf below it.
+ * Ω(1), O(k), where k is the length of the key.
+ */
+static const unsigned char* radix_prefix(const radix_Node* const node, const size_t depth)
+{
+    if (node->prefix_length <= MAX_PREFIX) return node->prefix;
+    return (const unsigned char*)radix_minimum(node)->key + depth;
+}
+
+/*
+ * Returns the number of bytes of the node's compressed path which match the key from the specified depth.
+ * Ω(1), O(k), where k is the length of the key.
+ */
+static size_t radix_mismatch(const radix_Node* const node, const unsigned char* const key,
+                             const size_t length, const size_t depth)
+{
+    const unsigned char* const prefix = radix_prefix(node, depth);
+    const size_t limit = MIN(node->prefix_length, length - depth);
+    size_t i = 0;
+    while (i < limit && prefix[i] == key[depth + i])
+        i++;
+    return i;
+}
+
+/*
+ * Returns the slot of the node's child for the specified byte, or NULL if there is no such child.
+ * Θ(1)
+ */
+static void** radix_find(radix_Node* const node, const unsigned char byte)
+{
+    switch (node->type)
+    {
+        case NODE4:
+        {
+            radix_Node4* const n = (radix_Node4*)node;
+            for (unsigned int i = 0; i < node->count; i++)
+                if (n->keys[i] == byte) return &n->children[i];
+            return NULL;
+        }
+        case NODE16:
+        {
+            radix_Node16* const n = (radix_Node16*)node;
+#ifdef RADIX_SSE2
+            /* Compare the byte against all 16 keys at once, masking off the unused keys. */
+            const __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8((char)byte),
+                                                   _mm_loadu_si128((const __m128i*)n->keys));
+            const unsigned int mask = (unsigned int)_mm_movemask_epi8(matches) & ((1u << node->count) - 1);
+            return mask != 0 ? &n->children[math_ilog2(mask & (0u - mask))] : NULL;
+#else
+            for (unsigned int i = 0; i < node->count; i++)
+                if (n->keys[i] == byte) return &n->children[i];
+            return NULL;
+#endif
+        }
+        case NODE48:
+        {
+            radix_Node48* const n = (radix_Node48*)node;
+            return n->index[byte] != 0 ? &n->children[n->index[byte] - 1] : NULL;
+        }
+        default:
+        {
+            radix_Node256* const n = (radix_Node256*)node;
+            return n->children[byte] != NULL ? &n->children[byte] : NULL;
+        }
+    }
+}
+
+/*
+ * Returns the node's first child in byte order at or after `cursor`, or NULL if there is no such child.
+ * The cursor is advanced past the returned child.
+ * Ω(1), O(256)
+ */
+static void* radix_child(const radix_Node* const node, unsigned int* const cursor)
+{
+    switch (node->type)
+    {
+        case NODE4:
+        {
+            const radix_Node4* const n = (const radix_Node4*)node;
+            return *cursor < node->count ? n->children[(*cursor)++] : NULL;
+        }
+        case NODE16:
+        {
+            const radix_Node16* const n = (const radix_Node16*)node;
+            return *cursor < node->count ? n->children[(*cursor)++] : NULL;
+        }
+        case NODE48:
+        {
+            const radix_Node48* const n = (const radix_Node48*)node;
+            for (; *cursor < 256; (*cursor)++)
+                if (n->index[*cursor] != 0) return n->children[n->index[(*cursor)++] - 1];
+            return NULL;
+        }
+        default:
+        {
+            const radix_Node256* const n = (const radix_Node256*)node;
+            for (; *cursor < 256; (*cursor)++)
+                if (n->children[*cursor] != NULL) return n->children[(*cursor)++];
+            return NULL;
+        }
+    }
+}
+
+/*
+ * Returns the cursor of the node's first child whose byte is greater than the specified byte.
+ * Θ(1)
+ */
+static unsigned int radix_cursor(const radix_Node* const node, const unsigned char byte)
+{
+    const unsigned char *keys;
+    switch (node->type)
+    {
+        case NODE4: keys = ((const radix_Node4*)node)->keys; break;
+        case NODE16: keys = ((const radix_Node16*)node)->keys; break;
+        default: return (unsigned int)byte + 1;
+    }
+
+    unsigned int i = 0;
+    while (i < node->count && keys[i] <= byte)
+        i++;
+    return i;
+}
+
+/*
+ * Adds a child to the node held by `slot`, under the specified byte.
+ * A full node is replaced by a node of the next larger layout.
+ * Θ(1)
+ */
+static void radix_add(void** const slot, const unsigned char byte, void* const child)
+{
+    radix_Node* const node = *slot;
+    switch (node->type)
+    {
+        case NODE4:
+        case NODE16:
+        {
+            const unsigned int capacity = node->type == NODE4 ? 4 : 16;
+            if (node->count == capacity)
+            {
+                /* Grow into the next layout. Both sorted layouts keep their keys in order. */
+                if (node->type == NODE4)
+                {
+                    radix_Node16* const grown = (radix_Node16*)radix_node(NODE16);
+                    memcpy(grown, node, sizeof(radix_Node));
+                    grown->header.type = NODE16;
+                    memcpy(grown->keys, ((radix_Node4*)node)->keys, 4);
+                    memcpy(grown->children, ((radix_Node4*)node)->children, 4 * sizeof(void*));
+                    *slot = grown;
+                }
+                else
+                {
+                    const radix_Node16* const n = (radix_Node16*)node;
+                    radix_Node48* const grown = (radix_Node48*)radix_node(NODE48);
+                    memcpy(grown, node, sizeof(radix_Node));
+                    grown->header.type = NODE48;
+                    for (unsigned int i = 0; i < 16; i++)
+                    {
+                        grown->children[i] = n->children[i];
+                        grown->index[n->keys[i]] = (unsigned char)(i + 1);
+                    }
+                    *slot = grown;
+                }
+                mem_free(node, NODE_SIZE[node->type]);
+                radix_add(slot, byte, child);
+                return;
+            }
+
+            unsigned char* const keys = node->type == NODE4 ?
+                    ((radix_Node4*)node)->keys : ((radix_Node16*)node)->keys;
+            void** const children = node->type == NODE4 ?
+                    ((radix_Node4*)node)->children : ((radix_Node16*)node)->children;
+            const unsigned int position = radix_cursor(node, byte);
+            memmove(keys + position + 1, keys + position, node->count - position);
+            memmove(children + position + 1, children + position, (node->count - position) * sizeof(void*));
+            keys[position] = byte;
+            children[position] = child;
+            node->count++;
+            return;
+        }
+        case NODE48:
+        {
+            radix_Node48* const n = (radix_Node48*)node;
+            if (node->count == 48)
+            {
+                radix_Node256* const grown = (radix_Node256*)radix_node(NODE256);
+                memcpy(grown, node, sizeof(radix_Node));
+                grown->header.type = NODE256;
+                for (unsigned int i = 0; i < 256; i++)
+                    if (n->index[i] != 0) grown->children[i] = n->children[n->index[i] - 1];
+                mem_free(node, sizeof(radix_Node48));
+                *slot = grown;
+                radix_add(slot, byte, child);
+                return;
+            }
+
+            unsigned int position = 0;
+            while (n->children[position] != NULL)
+                position++;
+            n->children[position] = child;
+            n->index[byte] = (unsigned char)(position + 1);
+            node->count++;
+            return;
+        }
+        default:
+        {
+            ((radix_Node256*)node)->children[byte] = child;
+            node->count++;
+            return;
+        }
+    }
+}
+
+/*
+ * Removes the child of the node held by `slot` under the specified byte.
+ * A sparse node is replaced by a node of the next smaller layout.
+ * Θ(1)
+ */
+static void radix_erase(void** const slot, const unsigned char byte)
+{
+    radix_Node* const node = *slot;
+    switch (node->type)
+    {
+        case NODE4:
+        case NODE16:
+        {
+            unsigned char* const keys = node->type == NODE4 ?
+                    ((radix_Node4*)node)->keys : ((radix_Node16*)node)->keys;
+            void** const children = node->type == NODE4 ?
+                    ((radix_Node4*)node)->children : ((radix_Node16*)node)->children;
+            unsigned int position = 0;
+            while (keys[position] != byte)
+                position++;
+            node->count--;
+            memmove(keys + position, keys + position + 1, node->count - position);
+            memmove(children + position, children + position + 1, (node->count - position) * sizeof(void*));
+
+            if (node->type == NODE16 && node->count <= SHRINK16)
+            {
+                radix_Node4* const shrunk = (radix_Node4*)radix_node(NODE4);
+                memcpy(shrunk, node, sizeof(radix_Node));
+                shrunk->header.type = NODE4;
+                memcpy(shrunk->keys, keys, node->count);
+                memcpy(shrunk->children, children, node->count * sizeof(void*));
+                mem_free(node, sizeof(radix_Node16));
+                *slot = shrunk;
+            }
+            return;
+        }
+        case NODE48:
+        {
+            radix_Node48* const n = (radix_Node48*)node;
+            n->children[n->index[byte] - 1] = NULL;
+            n->index[byte] = 0;
+            node->count--;
+
+            if (node->count <= SHRINK48)
+            {
+                radix_Node16* const shrunk = (radix_Node16*)radix_node(NODE16);
+                memcpy(shrunk, node, sizeof(radix_Node));
+                shrunk->header.type = NODE16;
+                unsigned int position = 0;
+                for (unsigned int i = 0; i < 256; i++)
+                    if (n->index[i] != 0)
+                    {
+                        shrunk->keys[position] = (unsigned char)i;
+                        shrunk->children[position++] = n->children[n->index[i] - 1];
+                    }
+                mem_free(node, sizeof(radix_Node48));
+                *slot = shrunk;
+            }
+            return;
+        }
+        default:
+        {
+            radix_Node256* const n = (radix_Node256*)node;
+            n->children[byte] = NULL;
+            node->count--;
+
+            if (node->count <= SHRINK256)
+            {
+                radix_Node48* const shrunk = (radix_Node48*)radix_node(NODE48);
+                memcpy(shrunk, node, sizeof(radix_Node));
+                shrunk->header.type = NODE48;
+                unsigned int position = 0;
+                for (unsigned int i = 0; i < 256; i++)
+                    if (n->children[i] != NULL)
+                    {
+                        shrunk->children[position] = n->children[i];
+                        shrunk->index[i] = (unsigned char)++position;
+                    }
+                mem_free(node, sizeof(radix_Node256));
+                *slot = shrunk;
+            }
+            return;
+        }
+    }
+}
+
+/*
+ * Replaces the node held by `slot` with its only remaining entry, if it has just one.
+ * A remaining child node absorbs the node's compressed path and the byte leading to it.
+ * Θ(1)
+ */
+static void radix_collapse(void** const slot)
+{
+    radix_Node* const node = *slot;
+    if (node->count == 0)
+    {
+        *slot = node->leaf != NULL ? MAKE_LEAF(node->leaf) : NULL;
+        mem_free(node, NODE_SIZE[node->type]);
+        return;
+    }
+    if (node->count > 1 || node->leaf != NULL) return;
+
+    /* Only a Node4 can be left with a single child. */
+    radix_Node4* const n = (radix_Node4*)node;
+    void* const child = n->children[0];
+    if (!IS_LEAF(child))
+    {
+        radix_Node* const below = child;
+        unsigned char prefix[MAX_PREFIX];
+        size_t stored = MIN(node->prefix_length, MAX_PREFIX);
+        memcpy(prefix, node->prefix, stored);
+        if (stored < MAX_PREFIX) prefix[stored++] = n->keys[0];
+        const size_t remaining = MIN(below->prefix_length, MAX_PREFIX - stored);
+        memcpy(prefix + stored, below->prefix, remaining);
+
+        below->prefix_length += node->prefix_length + 1;
+        memcpy(below->prefix, prefix, stored + remaining);
+    }
+
+    *slot = child;
+    mem_free(node, sizeof(radix_Node4));
+}
+
+/*
+ * Frees the specified child, along with everything below it.
+ * Θ(n)
+ */
+static void radix_free(void* const child)
+{
+    if (IS_LEAF(child))
+    {
+        mem_free(TO_LEAF(child), sizeof(radix_Leaf));
+        return;
+    }
+
+    radix_Node* const node = child;
+    if (node->leaf != NULL) mem_free(node->leaf, sizeof(radix_Leaf));
+    unsigned int cursor = 0;
+    for (void *c; (c = radix_child(node, &cursor)) != NULL;)
+        radix_free(c);
+    mem_free(node, NODE_SIZE[node->type]);
+}
+
+/*
+ * Constructs an unbounded iterator starting from the first key which is at least `low`.
+ * The stack is seeded with the nodes along the path of `low`, each set to resume past that path.
+ * If `low` is NULL, iteration starts from the first key of the Tree.
+ * Θ(k), where k is the length of `low`.
+ */
+static radix_Iterator* radix_iter_seek(const RadixTree* const tree, const unsigned char* const low,
+                                       const size_t low_length)
+{
+    radix_Iterator* const iter = mem_calloc(1, sizeof(radix_Iterator));
+    iter->stack = mem_malloc(DEFAULT_STACK_CAPACITY * sizeof(radix_Frame));
+    iter->capacity = DEFAULT_STACK_CAPACITY;
+
+    const void *child = tree->root;
+    size_t depth = 0;
+    while (child != NULL)
+    {
+        if (IS_LEAF(child))
+        {
+            const radix_Leaf* const leaf = TO_LEAF(child);
+            if (radix_compare(leaf->key, leaf->length, low, low_length) >= 0) iter->next = leaf;
+            break;
+        }
+
+        const radix_Node* const node = child;
+        const unsigned char* const prefix = radix_prefix(node, depth);
+        const size_t limit = MIN(node->prefix_length, low_length - depth);
+        const int order = limit > 0 ? memcmp(prefix, low + depth, limit) : 0;
+
+        /* Past the end of `low`, or beyond it in order: every key below is in range. */
+        if (order > 0 || (order == 0 && depth + node->prefix_length >= low_length))
+        {
+            radix_iter_push(iter, node, 0, false);
+            break;
+        }
+        /* Before `low` in order: every key below is out of range. */
+        if (order < 0) break;
+
+        /* Resume past this branch after it is exhausted. The node's own leaf is a proper prefix of `low`. */
+        depth += node->prefix_length;
+        const unsigned char byte = low[depth++];
+        radix_iter_push(iter, node, radix_cursor(node, byte), true);
+        void** const next = radix_find((radix_Node*)node, byte);
+        child = next != NULL ? *next : NULL;
+    }
+
+    if (iter->next == NULL) iter->next = radix_iter_advance(iter);
+    return iter;
+}
+
+/*
+ * Pushes a node onto the iterator's stack.
+ * Θ(1) amortized.
+ */
+static void radix_iter_push(radix_Iterator* const iter, const radix_Node* const node,
+                            const unsigned int cursor, const bool visited)
+{
+    if (iter->depth == iter->capacity)
+    {
+        iter->stack = mem_realloc(iter->stack, iter->capacity * sizeof(radix_Frame),
+                                  iter->capacity * 2 * sizeof(radix_Frame));
+        iter->capacity *= 2;
+    }
+
+    radix_Frame* const frame = &iter->stack[iter->depth++];
+    frame->node = node;
+    frame->cursor = cursor;
+    frame->visited = visited;
+}
+
+/*
+ * Returns the next leaf in order from the iterator's stack, or NULL if the stack is exhausted.
+ * A node's own leaf precedes its children, as its key is a prefix of theirs.
+ * Ω(1), O(k), where k is the length of the longest key.
+ */
+static const radix_Leaf* radix_iter_advance(radix_Iterator* const iter)
+{
+    while (iter->depth > 0)
+    {
+        radix_Frame* const frame = &iter->stack[iter->depth - 1];
+        if (!frame->visited)
+        {
+            frame->visited = true;
+            if (frame->node->leaf != NULL) return frame->node->leaf;
+        }
+
+        const void* const child = radix_child(frame->node, &frame->cursor);
+        if (child == NULL) iter->depth--;
+        else if (IS_LEAF(child)) return TO_LEAF(child);
+        else radix_iter_push(iter, child, 0, false);
+    }
+
+    return NULL;
+}
+
+/*
+ * Ends the iteration once the next leaf falls outside of the iterator's bound.
+ * Keys are iterated in order, so every key after it falls outside as well.
+ * Θ(k), where k is the length of the bound.
+ */
+static void radix_iter_bound(radix_Iterator* const iter)
+{
+    const radix_Leaf* const next = iter->next;
+    if (next == NULL || iter->bound == NULL) return;
+
+    if (iter->prefix)
+    {
+        if (next->length < iter->bound_length
+            || (iter->bound_length > 0 && memcmp(next->key, iter->bound, iter->bound_length) != 0))
+            iter->next = NULL;
+    }
+    else if (radix_compare(next->key, next->length, iter->bound, iter->bound_length) >= 0)
+        iter->next = NULL;
+}
@@ -0,0 +1,488 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       ReplicatedTable.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/ReplicatedTable.h"
+
+/* Number of operations which the log can hold before the oldest must be applied everywhere. Must be a power of 2. */
+#define LOG_CAPACITY 1024
+/* Size of a cache line, used to keep each replica's counters apart from its neighbors. */
+#define CACHE_LINE 64
+/* Set in a replica's lock while a writer holds or is waiting for it. The remaining bits count its readers. */
+#define WRITER ((LONG64)1 << 62)
+
+/*
+ * Node replication:
+ * Writers are serialized by a single lock. Each writer appends its operation to the log,
+ * then publishes it by advancing the log's tail, which is the point at which the operation takes effect.
+ * A reader first brings its node's replica up to the tail it observed, then reads the replica.
+ * Replicas are only ever modified by applying the log in order, so every replica passes through
+ * the same sequence of states.
+ *
+ * Replicas are updated by threads running on their own node, so memory which a replica allocates
+ * while applying the log is placed on that node by the system's first-touch policy.
+ */
+
+/* Kinds of logged operations. */
+enum rtable_op_type { RTABLE_PUT, RTABLE_REMOVE, RTABLE_CLEAR };
+
+/* Logged operation structure. */
+typedef struct rtable_Op
+{
+    enum rtable_op_type type;
+    const void *key, *value;
+} rtable_Op;
+
+/* Replica structure. */
+typedef struct rtable_Replica
+{
+    /* Reader/writer lock which prefers writers. */
+    sync_Word lock;
+    /* Number of logged operations which have been applied to the replica. */
+    sync_Word applied;
+    HashTable *table;
+    char padding[CACHE_LINE - 2 * sizeof(sync_Word) - sizeof(HashTable*)];
+} rtable_Replica;
+
+/* ReplicatedTable structure. */
+struct ReplicatedTable
+{
+    rtable_Op *log;
+    /* Number of operations which have been appended to the log. */
+    sync_Word tail;
+    /* Serializes writers. */
+    sync_Word write_lock;
+
+    rtable_Replica *replicas;
+    unsigned int replica_count;
+
+    /* Function pointers. */
+    bool(*equals)(const void*, const void*);
+    unsigned int(*hash)(const void*);
+    char*(*toString)(const void*, const void*);
+};
+
+/* Structure to assist in looping through Table. */
+struct rtable_Iterator
+{
+    /* Private copy of a replica, which the iterator owns. */
+    HashTable *snapshot;
+    table_Iterator *iter;
+};
+
+/* Local functions. */
+static rtable_Replica* rtable_local(const ReplicatedTable* const table);
+static rtable_Replica* rtable_read_start(const ReplicatedTable* const table);
+static void rtable_read_end(rtable_Replica* const replica);
+static const void* rtable_write(ReplicatedTable* const table, const enum rtable_op_type type,
+                                const void* const key, const void* const value);
+static void rtable_catch_up(const ReplicatedTable* const table, rtable_Replica* const replica, const LONG64 until);
+static const void* rtable_execute(HashTable* const replica, const rtable_Op* const op);
+static void rtable_lock_read(rtable_Replica* const replica);
+static void rtable_lock_write(rtable_Replica* const replica);
+static void rtable_spin_lock(sync_Word* const lock);
+
+/*
+ * Constructor function.
+ * The `hash` function must be defined to call this function.
+ * The `equals` function must be defined to call this function.
+ * Θ(r), where r is the number of NUMA nodes
+ */
+ReplicatedTable* ReplicatedTable_new(unsigned int(*hash)(const void*),
+                                     bool(*equals)(const void*, const void*),
+                                     char*(*toString)(const void*, const void*))
+{
+    io_assert(hash != NULL, IO_MSG_NOT_SUPPORTED);
+    io_assert(equals != NULL, IO_MSG_NOT_SUPPORTED);
+
+    ReplicatedTable* const table = mem_calloc(1, sizeof(ReplicatedTable));
+    table->log = mem_calloc(LOG_CAPACITY, sizeof(rtable_Op));
+    table->replica_count = sync_numa_nodes();
+    table->replicas = mem_calloc(table->replica_count, sizeof(rtable_Replica));
+    for (unsigned int i = 0; i < table->replica_count; i++)
+        table->replicas[i].table = HashTable_new(hash, equals, toString);
+    table->hash = hash;
+    table->equals = equals;
+    table->toString = toString;
+    return table;
+}
+
+/*
+ * Returns the value of a mapping whose key matches the specified key.
+ * Returns NULL if no such mapping exists.
+ * Ω(1), O(l * n), where l is the number of operations the local replica has yet to apply
+ */
+void* rtable_get(const ReplicatedTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    rtable_Replica* const replica = rtable_read_start(table);
+    void* const value = table_get(replica->table, key);
+    rtable_read_end(replica);
+
+    return value;
+}
+
+/*
+ * Returns the number of mappings in the Table.
+ * Ω(1), O(l * n), where l is the number of operations the local replica has yet to apply
+ */
+size_t rtable_size(const ReplicatedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    rtable_Replica* const replica = rtable_read_start(table);
+    const size_t size = table_size(replica->table);
+    rtable_read_end(replica);
+
+    return size;
+}
+
+/*
+ * Returns true if the Table is empty.
+ * Ω(1), O(l * n), where l is the number of operations the local replica has yet to apply
+ */
+bool rtable_empty(const ReplicatedTable* const table)
+{
+    return rtable_size(table) == 0;
+}
+
+/*
+ * Returns true if the Table contains a mapping with the specified key.
+ * Ω(1), O(l * n), where l is the number of operations the local replica has yet to apply
+ */
+bool rtable_contains(const ReplicatedTable* const table, const void* const key)
+{
+    return rtable_get(table, key) != NULL;
+}
+
+/*
+ * Prints out the contents of the Table to the console window.
+ * Θ(n)
+ */
+void rtable_print(const ReplicatedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    rtable_Replica* const replica = rtable_read_start(table);
+    table_print(replica->table);
+    rtable_read_end(replica);
+}
+
+/*
+ * Returns a shallow copy of the Table.
+ * Θ(n)
+ */
+ReplicatedTable* rtable_clone(const ReplicatedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    ReplicatedTable* const copy = ReplicatedTable_new(table->hash, table->equals, table->toString);
+
+    rtable_Iterator* const iter = rtable_iter(table);
+    while (rtable_iter_has_next(iter))
+    {
+        void *value;
+        const void* const key = rtable_iter_next(iter, &value);
+        rtable_put(copy, key, value);
+    }
+    rtable_iter_destroy(iter);
+
+    return copy;
+}
+
+/*
+ * Inserts a mapping into the Table.
+ * If the Table already contained a mapping for the key, the old value is replaced.
+ * Returns the replaced value or NULL if this is a new mapping.
+ * Ω(1), O(n)
+ */
+void* rtable_put(ReplicatedTable* const table, const void* const key, const void* const value)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    io_assert(value != NULL, IO_MSG_NULL_PTR);
+
+    return (void*)rtable_write(table, RTABLE_PUT, key, value);
+}
+
+/*
+ * Removes a mapping from the Table whose key matches the specified key.
+ * Returns the value of the removed mapping or NULL if no such mapping exists.
+ * Ω(1), O(n)
+ */
+void* rtable_remove(ReplicatedTable* const table, const void* const key)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    return (void*)rtable_write(table, RTABLE_REMOVE, key, NULL);
+}
+
+/*
+ * Removes all mappings from the Table.
+ * Θ(n)
+ */
+void rtable_clear(ReplicatedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    rtable_write(table, RTABLE_CLEAR, NULL, NULL);
+}
+
+/*
+ * De-constructor function.
+ * Θ(n * r), where r is the number of NUMA nodes
+ */
+void rtable_destroy(ReplicatedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    for (unsigned int i = 0; i < table->replica_count; i++)
+        table_destroy(table->replicas[i].table);
+    mem_free(table->replicas, table->replica_count * sizeof(rtable_Replica));
+    mem_free(table->log, LOG_CAPACITY * sizeof(rtable_Op));
+    mem_free(table, sizeof(ReplicatedTable));
+}
+
+/*
+ * Constructor function.
+ * Θ(n)
+ */
+rtable_Iterator* rtable_iter(const ReplicatedTable* const table)
+{
+    io_assert(table != NULL, IO_MSG_NULL_PTR);
+
+    rtable_Iterator* const iter = mem_calloc(1, sizeof(rtable_Iterator));
+
+    /* The replica must not be held while iterating, or this node could not apply the log until it is done. */
+    rtable_Replica* const replica = rtable_read_start(table);
+    iter->snapshot = table_clone(replica->table);
+    rtable_read_end(replica);
+
+    iter->iter = table_iter(iter->snapshot);
+    return iter;
+}
+
+/*
+ * Returns the iterator's current key/value pair and advances it forward.
+ * The key will be returned and the value will be assigned to the data of the parameter.
+ * Ω(1), O(n)
+ */
+void* rtable_iter_next(rtable_Iterator* const iter, void **value)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return table_iter_next(iter->iter, value);
+}
+
+/*
+ * Returns true if the iterator has a next key/value pair.
+ * Θ(1)
+ */
+bool rtable_iter_has_next(const rtable_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return table_iter_has_next(iter->iter);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void rtable_iter_destroy(rtable_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+
+    table_iter_destroy(iter->iter);
+    table_destroy(iter->snapshot);
+    mem_free(iter, sizeof(rtable_Iterator));
+}
+
+/*
+ * Returns the replica of the NUMA node which the calling thread is running on.
+ * Θ(1)
+ */
+static rtable_Replica* rtable_local(const ReplicatedTable* const table)
+{
+    return &table->replicas[sync_numa_node() % table->replica_count];
+}
+
+/*
+ * Brings the local replica up to date with every operation published so far, then locks it for reading.
+ * Function `rtable_read_end` must be called after reading is done.
+ * Ω(1), O(l * n), where l is the number of operations in the log
+ */
+static rtable_Replica* rtable_read_start(const ReplicatedTable* const table)
+{
+    rtable_Replica* const replica = rtable_local(table);
+
+    /* Any operation published after this point may be ordered after the read. */
+    const LONG64 tail = sync_load(&table->tail);
+    if (sync_load(&replica->applied) < tail)
+    {
+        rtable_lock_write(replica);
+        rtable_catch_up(table, replica, tail);
+        sync_store(&replica->lock, 0);
+    }
+
+    rtable_lock_read(replica);
+    return replica;
+}
+
+/*
+ * Unlocks a replica which was locked for reading.
+ * Θ(1)
+ */
+static void rtable_read_end(rtable_Replica* const replica)
+{
+    sync_fetch_add(&replica->lock, -1);
+}
+
+/*
+ * Publishes an operation to the log, and applies it to the local replica.
+ * Returns the value which the operation replaced or removed.
+ * Ω(1), O(l * n), where l is the number of operations in the log
+ */
+static const void* rtable_write(ReplicatedTable* const table, const enum rtable_op_type type,
+                                const void* const key, const void* const value)
+{
+    rtable_Replica* const local = rtable_local(table);
+    const rtable_Op op = { type, key, value };
+
+    rtable_spin_lock(&table->write_lock);
+
+    /* The oldest operation can only be overwritten once every replica has applied it. */
+    const LONG64 tail = table->tail;
+    for (unsigned int i = 0; i < table->replica_count; i++)
+    {
+        rtable_Replica* const replica = &table->replicas[i];
+        if (tail - sync_load(&replica->applied) >= LOG_CAPACITY)
+        {
+            rtable_lock_write(replica);
+            rtable_catch_up(table, replica, tail);
+            sync_store(&replica->lock, 0);
+        }
+    }
+
+    /*
+     * The operation's result is taken from the local replica, which has seen every earlier operation.
+     * It is locked before publishing, or a reader could apply the operation to it first.
+     */
+    rtable_lock_write(local);
+    rtable_catch_up(table, local, tail);
+
+    table->log[tail & (LOG_CAPACITY - 1)] = op;
+    sync_store(&table->tail, tail + 1);
+
+    const void* const result = rtable_execute(local->table, &op);
+    sync_store(&local->applied, tail + 1);
+    sync_store(&local->lock, 0);
+
+    sync_store(&table->write_lock, 0);
+    return result;
+}
+
+/*
+ * Applies the logged operations which a locked replica has not yet applied, up to the specified point.
+ * Θ(l * n), where l is the number of operations applied
+ */
+static void rtable_catch_up(const ReplicatedTable* const table, rtable_Replica* const replica, const LONG64 until)
+{
+    for (LONG64 i = replica->applied; i < until; i++)
+        rtable_execute(replica->table, &table->log[i & (LOG_CAPACITY - 1)]);
+    if (replica->applied < until)
+        sync_store(&replica->applied, until);
+}
+
+/*
+ * Applies an operation to a replica.
+ * Returns the value which the operation replaced or removed.
+ * Ω(1), O(n)
+ */
+static const void* rtable_execute(HashTable* const replica, const rtable_Op* const op)
+{
+    const void *result = NULL;
+    switch (op->type)
+    {
+        case RTABLE_PUT:
+            result = table_put(replica, op->key, op->value);
+            break;
+        case RTABLE_REMOVE:
+            result = table_get(replica, op->key);
+            if (result != NULL) table_remove(replica, op->key);
+            break;
+        case RTABLE_CLEAR:
+            table_clear(replica);
+            break;
+    }
+    return result;
+}
+
+/*
+ * Locks a replica for reading, waiting out any writer which holds or is waiting for it.
+ * Θ(1)
+ */
+static void rtable_lock_read(rtable_Replica* const replica)
+{
+    for (unsigned int attempt = 0; ; attempt++)
+    {
+        const LONG64 state = sync_load(&replica->lock);
+        if ((state & WRITER) == 0 && sync_cas(&replica->lock, state, state + 1))
+            return;
+        sync_backoff(attempt);
+    }
+}
+
+/*
+ * Locks a replica for writing. New readers are turned away while the current ones finish.
+ * The lock is released by storing 0 into it.
+ * Θ(1)
+ */
+static void rtable_lock_write(rtable_Replica* const replica)
+{
+    for (unsigned int attempt = 0; ; attempt++)
+    {
+        const LONG64 state = sync_load(&replica->lock);
+        if ((state & WRITER) == 0 && sync_cas(&replica->lock, state, state | WRITER))
+            break;
+        sync_backoff(attempt);
+    }
+    for (unsigned int attempt = 0; sync_load(&replica->lock) != WRITER; attempt++)
+        sync_backoff(attempt);
+}
+
+/*
+ * Locks a mutual exclusion lock. The lock is released by storing 0 into it.
+ * Θ(1)
+ */
+static void rtable_spin_lock(sync_Word* const lock)
+{
+    for (unsigned int attempt = 0; !sync_cas(lock, 0, 1); attempt++)
+        sync_backoff(attempt);
+}
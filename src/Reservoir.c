@@ -0,0 +1,260 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       Reservoir.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/Reservoir.h"
+#include <math.h>
+
+/* Skips too long to count are clamped to this, which no stream will reach. */
+#define SKIP_LIMIT 1.8e19
+
+/*
+ * Sampling:
+ * Utilizes Algorithm L. Once the sample is full, the Reservoir computes how many elements to skip
+ * before the next replacement, rather than drawing a random number for every element offered.
+ * For details, see: Li, "Reservoir-Sampling Algorithms of Time Complexity O(n(1 + log(N/n)))".
+ */
+
+/* Reservoir structure. */
+struct Reservoir
+{
+    const void** sample;
+    unsigned int capacity, size;
+    unsigned long long offered;
+    /* Elements left to skip before the next replacement. */
+    unsigned long long skip;
+    /* Largest of the random keys which a uniform sample would keep. */
+    double w;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+
+    /* Function pointers. */
+    char*(*toString)(const void*);
+};
+
+/* Local functions. */
+static void res_advance(Reservoir* const res);
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+Reservoir* Reservoir_new(const unsigned int capacity, char*(*toString)(const void*))
+{
+    io_assert(capacity > 0, IO_MSG_INVALID_SIZE);
+
+    Reservoir* const res = mem_calloc(1, sizeof(Reservoir));
+    res->sample = mem_calloc(capacity, sizeof(void*));
+    res->capacity = capacity;
+    res->toString = toString;
+    res->rw_sync = ReadWriteSync_new();
+    return res;
+}
+
+/*
+ * Returns the sampled element at the specified index.
+ * Θ(1)
+ */
+void* res_at(const Reservoir* const res, const unsigned int index)
+{
+    io_assert(res != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(res->rw_sync);
+
+    io_assert(index < res->size, IO_MSG_OUT_OF_BOUNDS);
+    const void* const val = res->sample[index];
+
+    /* Unlock the data structure. */
+    sync_read_end(res->rw_sync);
+
+    return (void*)val;
+}
+
+/*
+ * Returns the number of elements in the sample.
+ * Θ(1)
+ */
+size_t res_size(const Reservoir* const res)
+{
+    io_assert(res != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(res->rw_sync);
+
+    const size_t size = res->size;
+
+    /* Unlock the data structure. */
+    sync_read_end(res->rw_sync);
+
+    return size;
+}
+
+/*
+ * Returns the number of elements which have been offered to the Reservoir.
+ * Θ(1)
+ */
+unsigned long long res_offered(const Reservoir* const res)
+{
+    io_assert(res != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(res->rw_sync);
+
+    const unsigned long long offered = res->offered;
+
+    /* Unlock the data structure. */
+    sync_read_end(res->rw_sync);
+
+    return offered;
+}
+
+/*
+ * Prints out the contents of the sample to the console window.
+ * The `toString` function must be defined to call this function.
+ * Θ(k), where k is the capacity
+ */
+void res_print(const Reservoir* const res)
+{
+    io_assert(res != NULL, IO_MSG_NULL_PTR);
+    io_assert(res->toString != NULL, IO_MSG_NOT_SUPPORTED);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(res->rw_sync);
+
+    printf("%c", '[');
+    for (unsigned int i = 0; i < res->size; i++)
+        printf("%s%s", res->toString(res->sample[i]), i + 1 < res->size ? ", " : "");
+    printf("]\n");
+
+    /* Unlock the data structure. */
+    sync_read_end(res->rw_sync);
+}
+
+/*
+ * Returns a new Vector containing the sample.
+ * Θ(k), where k is the capacity
+ */
+Vector* res_vector(const Reservoir* const res)
+{
+    io_assert(res != NULL, IO_MSG_NULL_PTR);
+
+    Vector* const vect = Vector_new(NULL, res->toString);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(res->rw_sync);
+
+    vect_resize(vect, res->size);
+    for (unsigned int i = 0; i < res->size; i++)
+        vect_push_back(vect, res->sample[i]);
+
+    /* Unlock the data structure. */
+    sync_read_end(res->rw_sync);
+
+    return vect;
+}
+
+/*
+ * Offers an element of the stream to the Reservoir.
+ * Θ(1), and only O(k * (1 + log(n / k))) of n offers draw random numbers
+ */
+void res_offer(Reservoir* const res, const void* const data)
+{
+    io_assert(res != NULL, IO_MSG_NULL_PTR);
+    io_assert(data != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(res->rw_sync);
+
+    res->offered++;
+    if (res->size < res->capacity)
+    {
+        res->sample[res->size++] = data;
+        /* The first skip is computed once the sample fills up. */
+        if (res->size == res->capacity)
+        {
+            res->w = exp(log(rand_unit()) / res->capacity);
+            res_advance(res);
+        }
+    }
+    else if (res->skip > 0)
+        res->skip--;
+    else
+    {
+        res->sample[rand_limit(res->capacity)] = data;
+        res->w *= exp(log(rand_unit()) / res->capacity);
+        res_advance(res);
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(res->rw_sync);
+}
+
+/*
+ * Empties the sample and forgets every offered element.
+ * Θ(1)
+ */
+void res_clear(Reservoir* const res)
+{
+    io_assert(res != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(res->rw_sync);
+
+    res->size = 0;
+    res->offered = res->skip = 0;
+
+    /* Unlock the data structure. */
+    sync_write_end(res->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void res_destroy(Reservoir* const res)
+{
+    io_assert(res != NULL, IO_MSG_NULL_PTR);
+
+    mem_free(res->sample, res->capacity * sizeof(void*));
+    sync_destroy(res->rw_sync);
+    mem_free(res, sizeof(Reservoir));
+}
+
+/*
+ * Computes the number of elements to skip before the next replacement.
+ * The skip follows a geometric distribution whose success probability is `w`.
+ * Θ(1)
+ */
+static void res_advance(Reservoir* const res)
+{
+    /* Computing log(1 - w) as log1p(-w) keeps precision while w is tiny. */
+    const double skip = floor(log(rand_unit()) / log1p(-res->w));
+    res->skip = skip < SKIP_LIMIT ? (unsigned long long)skip : (unsigned long long)SKIP_LIMIT;
+}
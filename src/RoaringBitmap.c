@@ -0,0 +1,1319 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       RoaringBitmap.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/RoaringBitmap.h"
+
+/* Set operations proceed 128 bits at a time with SSE2 where it is available. */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROAR_SSE2
+#endif
+
+/* Container types. */
+#define ARRAY 0
+#define BITMAP 1
+#define RUN 2
+/* Set operations. */
+#define AND 0
+#define OR 1
+#define ANDNOT 2
+/* Largest cardinality stored as an array. Beyond it, a bitmap is smaller. */
+#define ARRAY_MAX 4096
+/* Number of 64-bit words in a bitmap container. */
+#define WORDS 1024
+/* Array capacity components. */
+#define DEFAULT_INITIAL_CAPACITY 4
+#define GROW_FACTOR 2
+/* Identifies the serialized format. */
+#define SERIAL_MAGIC 0x524F4152U
+/* Serialized bytes of the format header, and of each container header. */
+#define SERIAL_HEADER 8
+#define SERIAL_CONTAINER 8
+
+/* Upper 16 bits of an integer, which select its container, and the lower 16 bits stored in it. */
+#define HIGH(value) ((unsigned short)((value) >> 16))
+#define LOW(value) ((unsigned short)(value))
+/* Tests and sets the bit of a 16-bit value within a bitmap container's words. */
+#define TEST(words, low) (((words)[(low) >> 6] >> ((low) & 63)) & 1)
+#define SET(words, low) ((words)[(low) >> 6] |= 1ULL << ((low) & 63))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+/*
+ * Layout:
+ * Integers are split into chunks by their upper 16 bits, and each non-empty chunk is kept in a container,
+ * sorted by chunk. A container holding at most 4096 integers is a sorted array of their lower 16 bits,
+ * while a fuller container is a bitmap of 65536 bits, which is then the smaller of the two. Containers can
+ * also be converted into a list of runs of consecutive integers, which is smaller still for clustered sets.
+ * Set operations combine containers chunk by chunk: bitmaps word by word, 128 bits at a time with SSE2,
+ * and arrays by merging, comparing eight integers of one array against eight of the other at once.
+ * Cardinalities are maintained by each container, and bitmaps recount theirs using population counts.
+ * For details, see: https://arxiv.org/abs/1603.06549
+ */
+
+/* Run structure, covering the integers [start, start + length]. */
+typedef struct roar_Run
+{
+    unsigned short start, length;
+} roar_Run;
+
+/* Container structure. */
+typedef struct roar_Container
+{
+    /* Upper 16 bits shared by the container's integers. */
+    unsigned short key;
+    unsigned char type;
+    unsigned int cardinality;
+    /* Number of array values or runs stored, and the number which fit. */
+    unsigned int size, capacity;
+    union
+    {
+        unsigned short *values;
+        unsigned long long *words;
+        roar_Run *runs;
+    } data;
+} roar_Container;
+
+/* RoaringBitmap structure. */
+struct RoaringBitmap
+{
+    /* Containers, sorted by key. */
+    roar_Container *containers;
+    size_t count, capacity;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+};
+
+/* Structure to assist in looping through bitmap. */
+struct roar_Iterator
+{
+    /* Index of the current container. */
+    size_t container;
+    /* Index of the next array value, bitmap word or run within the container. */
+    unsigned int position;
+    /* Bits of the current bitmap word which are yet to be iterated. */
+    unsigned long long word;
+    /* Offset of the next integer within the current run. */
+    unsigned int offset;
+    /* Next integer to be iterated, if any. */
+    unsigned int next;
+    bool has_next;
+    /* Reference to the bitmap that it is iterating through. */
+    const RoaringBitmap *ref;
+};
+
+/* Local functions. */
+static size_t roar_search(const RoaringBitmap* const bitmap, const unsigned short key, bool* const found);
+static roar_Container* roar_insert(RoaringBitmap* const bitmap, const size_t index, const unsigned short key);
+static void roar_push(RoaringBitmap* const bitmap, const roar_Container* const container);
+static void roar_erase(RoaringBitmap* const bitmap, const size_t index);
+static RoaringBitmap* roar_combine(const RoaringBitmap* const bitmap, const RoaringBitmap* const other,
+                                   const unsigned int op);
+static size_t roar_bytes(const roar_Container* const container);
+static void roar_release(roar_Container* const container);
+static void roar_copy(const roar_Container* const container, roar_Container* const out);
+static unsigned int roar_lower_bound(const unsigned short* const values, const unsigned int size,
+                                     const unsigned short low);
+static bool roar_container_contains(const roar_Container* const container, const unsigned short low);
+static bool roar_container_add(roar_Container* const container, const unsigned short low);
+static bool roar_container_remove(roar_Container* const container, const unsigned short low);
+static unsigned int roar_runs(const roar_Container* const container);
+static void roar_to_array(roar_Container* const container);
+static void roar_to_bitmap(roar_Container* const container);
+static void roar_to_run(roar_Container* const container);
+static void roar_expand(roar_Container* const container);
+static void roar_apply(const roar_Container* const a, const roar_Container* const b,
+                       const unsigned int op, roar_Container* const out);
+static unsigned int roar_bitwise(const unsigned long long* const a, const unsigned long long* const b,
+                                 const unsigned int op, unsigned long long* const out);
+static unsigned int roar_intersect(const unsigned short* const a, const unsigned int a_size,
+                                   const unsigned short* const b, const unsigned int b_size,
+                                   unsigned short* const out);
+static unsigned int roar_merge(const unsigned short* const a, const unsigned int a_size,
+                               const unsigned short* const b, const unsigned int b_size,
+                               const unsigned int op, unsigned short* const out);
+static unsigned int roar_filter(const unsigned short* const values, const unsigned int size,
+                                const unsigned long long* const words, const bool keep,
+                                unsigned short* const out);
+static unsigned char* roar_write(unsigned char* const out, const unsigned long long value, const unsigned int bytes);
+static unsigned long long roar_read(const unsigned char* const in, const unsigned int bytes);
+static void roar_iter_advance(roar_Iterator* const iter);
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+RoaringBitmap* RoaringBitmap_new()
+{
+    RoaringBitmap* const bitmap = mem_calloc(1, sizeof(RoaringBitmap));
+    bitmap->containers = mem_malloc(DEFAULT_INITIAL_CAPACITY * sizeof(roar_Container));
+    bitmap->capacity = DEFAULT_INITIAL_CAPACITY;
+    bitmap->rw_sync = ReadWriteSync_new();
+    return bitmap;
+}
+
+/*
+ * Constructor function.
+ * Every container is validated, so a malformed or truncated buffer is rejected rather than trusted.
+ * Θ(b), where b is the length of the buffer.
+ */
+RoaringBitmap* RoaringBitmap_deserialize(const void* const buffer, const size_t length)
+{
+    io_assert(buffer != NULL || length == 0, IO_MSG_NULL_PTR);
+
+    const unsigned char* const in = buffer;
+    if (length < SERIAL_HEADER || roar_read(in, 4) != SERIAL_MAGIC) return NULL;
+    const size_t count = (size_t)roar_read(in + 4, 4);
+    if (count > 65536 || (length - SERIAL_HEADER) / SERIAL_CONTAINER < count) return NULL;
+
+    RoaringBitmap* const bitmap = RoaringBitmap_new();
+    size_t position = SERIAL_HEADER + count * SERIAL_CONTAINER;
+    for (size_t i = 0; i < count; i++)
+    {
+        const unsigned char* const header = in + SERIAL_HEADER + i * SERIAL_CONTAINER;
+        roar_Container container = { 0 };
+        container.key = (unsigned short)roar_read(header, 2);
+        const unsigned int type = (unsigned int)roar_read(header + 2, 2);
+        const unsigned int size = (unsigned int)roar_read(header + 4, 4);
+
+        /* The type is checked at full width, so that no unknown type can truncate into a known one. */
+        bool valid = (i == 0 || container.key > bitmap->containers[i - 1].key) && size > 0
+                     && (type == ARRAY || type == BITMAP || type == RUN);
+        if (valid) container.type = (unsigned char)type;
+        if (valid && container.type == ARRAY)
+        {
+            valid = size <= ARRAY_MAX && (length - position) / sizeof(unsigned short) >= size;
+            if (valid)
+            {
+                container.data.values = mem_malloc(size * sizeof(unsigned short));
+                container.size = container.capacity = container.cardinality = size;
+                for (unsigned int j = 0; j < size; j++, position += sizeof(unsigned short))
+                {
+                    container.data.values[j] = (unsigned short)roar_read(in + position, 2);
+                    if (j > 0 && container.data.values[j] <= container.data.values[j - 1]) valid = false;
+                }
+            }
+        }
+        else if (valid && container.type == BITMAP)
+        {
+            valid = length - position >= WORDS * sizeof(unsigned long long);
+            if (valid)
+            {
+                container.data.words = mem_malloc(WORDS * sizeof(unsigned long long));
+                for (unsigned int j = 0; j < WORDS; j++, position += sizeof(unsigned long long))
+                {
+                    container.data.words[j] = roar_read(in + position, 8);
+                    container.cardinality += math_popcount64(container.data.words[j]);
+                }
+                valid = container.cardinality == size;
+            }
+        }
+        else if (valid && container.type == RUN)
+        {
+            valid = size <= 32768 && (length - position) / sizeof(roar_Run) >= size;
+            if (valid)
+            {
+                container.data.runs = mem_malloc(size * sizeof(roar_Run));
+                container.size = container.capacity = size;
+                for (unsigned int j = 0; j < size; j++, position += sizeof(roar_Run))
+                {
+                    roar_Run* const run = &container.data.runs[j];
+                    run->start = (unsigned short)roar_read(in + position, 2);
+                    run->length = (unsigned short)roar_read(in + position + 2, 2);
+                    container.cardinality += run->length + 1U;
+                    if ((unsigned int)run->start + run->length > 0xFFFF
+                        || (j > 0 && run->start <= (unsigned int)run[-1].start + run[-1].length + 1))
+                        valid = false;
+                }
+            }
+        }
+        else valid = false;
+
+        if (!valid)
+        {
+            if (container.data.values != NULL) roar_release(&container);
+            roar_destroy(bitmap);
+            return NULL;
+        }
+        roar_push(bitmap, &container);
+    }
+
+    if (position != length)
+    {
+        roar_destroy(bitmap);
+        return NULL;
+    }
+    return bitmap;
+}
+
+/*
+ * Returns true if the bitmap contains the specified integer.
+ * Ω(1), O(log(n))
+ */
+bool roar_contains(const RoaringBitmap* const bitmap, const unsigned int value)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(bitmap->rw_sync);
+
+    bool found;
+    const size_t index = roar_search(bitmap, HIGH(value), &found);
+    const bool contains = found && roar_container_contains(&bitmap->containers[index], LOW(value));
+
+    /* Unlock the data structure. */
+    sync_read_end(bitmap->rw_sync);
+
+    return contains;
+}
+
+/*
+ * Returns the number of integers in the bitmap.
+ * Θ(c), where c is the number of containers.
+ */
+size_t roar_cardinality(const RoaringBitmap* const bitmap)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(bitmap->rw_sync);
+
+    size_t cardinality = 0;
+    for (size_t i = 0; i < bitmap->count; i++)
+        cardinality += bitmap->containers[i].cardinality;
+
+    /* Unlock the data structure. */
+    sync_read_end(bitmap->rw_sync);
+
+    return cardinality;
+}
+
+/*
+ * Returns true if the bitmap is empty.
+ * Θ(1)
+ */
+bool roar_empty(const RoaringBitmap* const bitmap)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(bitmap->rw_sync);
+
+    const bool empty = bitmap->count == 0;
+
+    /* Unlock the data structure. */
+    sync_read_end(bitmap->rw_sync);
+
+    return empty;
+}
+
+/*
+ * Prints out the contents of the bitmap to the console window.
+ * Integers are printed in ascending order.
+ * Θ(n)
+ */
+void roar_print(const RoaringBitmap* const bitmap)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(bitmap->rw_sync);
+
+    roar_Iterator* const iter = roar_iter(bitmap);
+    printf("%c", '[');
+    while (roar_iter_has_next(iter))
+    {
+        printf("%u", roar_iter_next(iter));
+        if (roar_iter_has_next(iter)) printf(", ");
+    }
+    printf("]\n");
+    roar_iter_destroy(iter);
+
+    /* Unlock the data structure. */
+    sync_read_end(bitmap->rw_sync);
+}
+
+/*
+ * Returns a new bitmap of the integers which are in either bitmap.
+ * Θ(n + m)
+ */
+RoaringBitmap* roar_union(const RoaringBitmap* const bitmap, const RoaringBitmap* const other)
+{
+    return roar_combine(bitmap, other, OR);
+}
+
+/*
+ * Returns a new bitmap of the integers which are in both bitmaps.
+ * Ω(min(n, m)), O(n + m)
+ */
+RoaringBitmap* roar_intersection(const RoaringBitmap* const bitmap, const RoaringBitmap* const other)
+{
+    return roar_combine(bitmap, other, AND);
+}
+
+/*
+ * Returns a new bitmap of the integers which are in the first bitmap but not the second.
+ * Θ(n + m)
+ */
+RoaringBitmap* roar_difference(const RoaringBitmap* const bitmap, const RoaringBitmap* const other)
+{
+    return roar_combine(bitmap, other, ANDNOT);
+}
+
+/*
+ * Returns the number of bytes which `roar_serialize` will write.
+ * Θ(c), where c is the number of containers.
+ */
+size_t roar_serialized_size(const RoaringBitmap* const bitmap)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(bitmap->rw_sync);
+
+    size_t size = SERIAL_HEADER + bitmap->count * SERIAL_CONTAINER;
+    for (size_t i = 0; i < bitmap->count; i++)
+    {
+        const roar_Container* const container = &bitmap->containers[i];
+        switch (container->type)
+        {
+            case ARRAY: size += container->size * sizeof(unsigned short); break;
+            case BITMAP: size += WORDS * sizeof(unsigned long long); break;
+            default: size += container->size * sizeof(roar_Run); break;
+        }
+    }
+
+    /* Unlock the data structure. */
+    sync_read_end(bitmap->rw_sync);
+
+    return size;
+}
+
+/*
+ * Writes the bitmap into the buffer, which must hold at least `roar_serialized_size` bytes.
+ * The format is little-endian regardless of the platform: a magic number and the container count, then
+ * each container's key, type and size, then each container's array values, bitmap words or runs.
+ * Returns the number of bytes written.
+ * Θ(b), where b is the number of bytes written.
+ */
+size_t roar_serialize(const RoaringBitmap* const bitmap, void* const buffer)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+    io_assert(buffer != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(bitmap->rw_sync);
+
+    unsigned char *out = roar_write(buffer, SERIAL_MAGIC, 4);
+    out = roar_write(out, bitmap->count, 4);
+    for (size_t i = 0; i < bitmap->count; i++)
+    {
+        const roar_Container* const container = &bitmap->containers[i];
+        out = roar_write(out, container->key, 2);
+        out = roar_write(out, container->type, 2);
+        out = roar_write(out, container->type == BITMAP ? container->cardinality : container->size, 4);
+    }
+    for (size_t i = 0; i < bitmap->count; i++)
+    {
+        const roar_Container* const container = &bitmap->containers[i];
+        switch (container->type)
+        {
+            case ARRAY:
+                for (unsigned int j = 0; j < container->size; j++)
+                    out = roar_write(out, container->data.values[j], 2);
+                break;
+            case BITMAP:
+                for (unsigned int j = 0; j < WORDS; j++)
+                    out = roar_write(out, container->data.words[j], 8);
+                break;
+            default:
+                for (unsigned int j = 0; j < container->size; j++)
+                {
+                    out = roar_write(out, container->data.runs[j].start, 2);
+                    out = roar_write(out, container->data.runs[j].length, 2);
+                }
+                break;
+        }
+    }
+    const size_t written = (size_t)(out - (unsigned char*)buffer);
+
+    /* Unlock the data structure. */
+    sync_read_end(bitmap->rw_sync);
+
+    return written;
+}
+
+/*
+ * Inserts an integer into the bitmap.
+ * Returns true if the integer was not already present.
+ * Ω(1), O(log(n) + a), where a is the maximum size of an array container.
+ */
+bool roar_add(RoaringBitmap* const bitmap, const unsigned int value)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(bitmap->rw_sync);
+
+    bool found;
+    const size_t index = roar_search(bitmap, HIGH(value), &found);
+    roar_Container* const container = found ?
+            &bitmap->containers[index] : roar_insert(bitmap, index, HIGH(value));
+    const bool added = roar_container_add(container, LOW(value));
+
+    /* Unlock the data structure. */
+    sync_write_end(bitmap->rw_sync);
+
+    return added;
+}
+
+/*
+ * Removes an integer from the bitmap.
+ * Returns true if the integer was present.
+ * Ω(1), O(log(n) + a), where a is the maximum size of an array container.
+ */
+bool roar_remove(RoaringBitmap* const bitmap, const unsigned int value)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(bitmap->rw_sync);
+
+    bool found, removed = false;
+    const size_t index = roar_search(bitmap, HIGH(value), &found);
+    if (found)
+    {
+        roar_Container* const container = &bitmap->containers[index];
+        removed = roar_container_remove(container, LOW(value));
+        if (container->cardinality == 0) roar_erase(bitmap, index);
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(bitmap->rw_sync);
+
+    return removed;
+}
+
+/*
+ * Converts each container into runs where they are smaller, and back out of runs where they are not.
+ * Run containers are converted back into arrays or bitmaps when next modified.
+ * Θ(n)
+ */
+void roar_optimize(RoaringBitmap* const bitmap)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(bitmap->rw_sync);
+
+    for (size_t i = 0; i < bitmap->count; i++)
+    {
+        roar_Container* const container = &bitmap->containers[i];
+        const size_t run_bytes = roar_runs(container) * sizeof(roar_Run);
+        const size_t bytes = container->cardinality <= ARRAY_MAX ?
+                container->cardinality * sizeof(unsigned short) : WORDS * sizeof(unsigned long long);
+        if (run_bytes < bytes) roar_to_run(container);
+        else roar_expand(container);
+    }
+
+    /* Unlock the data structure. */
+    sync_write_end(bitmap->rw_sync);
+}
+
+/*
+ * Removes all integers from the bitmap.
+ * Θ(c), where c is the number of containers.
+ */
+void roar_clear(RoaringBitmap* const bitmap)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(bitmap->rw_sync);
+
+    for (size_t i = 0; i < bitmap->count; i++)
+        roar_release(&bitmap->containers[i]);
+    bitmap->count = 0;
+
+    /* Unlock the data structure. */
+    sync_write_end(bitmap->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(c), where c is the number of containers.
+ */
+void roar_destroy(RoaringBitmap* const bitmap)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    for (size_t i = 0; i < bitmap->count; i++)
+        roar_release(&bitmap->containers[i]);
+    mem_free(bitmap->containers, bitmap->capacity * sizeof(roar_Container));
+    sync_destroy(bitmap->rw_sync);
+    mem_free(bitmap, sizeof(RoaringBitmap));
+}
+
+/*
+ * Constructor function.
+ * Θ(1)
+ */
+roar_Iterator* roar_iter(const RoaringBitmap* const bitmap)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+
+    roar_Iterator* const iter = mem_calloc(1, sizeof(roar_Iterator));
+    iter->ref = bitmap;
+    roar_iter_advance(iter);
+    return iter;
+}
+
+/*
+ * Returns the iterator's current integer and advances it forward.
+ * Θ(1) amortized.
+ */
+unsigned int roar_iter_next(roar_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    io_assert(roar_iter_has_next(iter), IO_MSG_OUT_OF_BOUNDS);
+
+    const unsigned int current = iter->next;
+    roar_iter_advance(iter);
+    return current;
+}
+
+/*
+ * Returns true if the iterator has a next integer.
+ * Θ(1)
+ */
+bool roar_iter_has_next(const roar_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    return iter->has_next;
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void roar_iter_destroy(roar_Iterator* const iter)
+{
+    io_assert(iter != NULL, IO_MSG_NULL_PTR);
+    mem_free(iter, sizeof(roar_Iterator));
+}
+
+/*
+ * Returns the index of the container with the specified key.
+ * If there is no such container, `found` is set to false and the index where it would be inserted is returned.
+ * Θ(log(c)), where c is the number of containers.
+ */
+static size_t roar_search(const RoaringBitmap* const bitmap, const unsigned short key, bool* const found)
+{
+    size_t low = 0, high = bitmap->count;
+    while (low < high)
+    {
+        const size_t middle = low + (high - low) / 2;
+        if (bitmap->containers[middle].key < key) low = middle + 1;
+        else high = middle;
+    }
+
+    *found = low < bitmap->count && bitmap->containers[low].key == key;
+    return low;
+}
+
+/*
+ * Inserts an empty array container with the specified key at the specified index.
+ * Θ(c), where c is the number of containers.
+ */
+static roar_Container* roar_insert(RoaringBitmap* const bitmap, const size_t index, const unsigned short key)
+{
+    if (bitmap->count == bitmap->capacity)
+    {
+        bitmap->containers = mem_realloc(bitmap->containers, bitmap->capacity * sizeof(roar_Container),
+                                         bitmap->capacity * GROW_FACTOR * sizeof(roar_Container));
+        bitmap->capacity *= GROW_FACTOR;
+    }
+
+    roar_Container* const container = &bitmap->containers[index];
+    memmove(container + 1, container, (bitmap->count - index) * sizeof(roar_Container));
+    bitmap->count++;
+
+    memset(container, 0, sizeof(roar_Container));
+    container->key = key;
+    container->type = ARRAY;
+    container->capacity = DEFAULT_INITIAL_CAPACITY;
+    container->data.values = mem_malloc(DEFAULT_INITIAL_CAPACITY * sizeof(unsigned short));
+    return container;
+}
+
+/*
+ * Appends a container to the bitmap, taking ownership of its data. Its key must exceed every other key.
+ * Θ(1) amortized.
+ */
+static void roar_push(RoaringBitmap* const bitmap, const roar_Container* const container)
+{
+    if (bitmap->count == bitmap->capacity)
+    {
+        bitmap->containers = mem_realloc(bitmap->containers, bitmap->capacity * sizeof(roar_Container),
+                                         bitmap->capacity * GROW_FACTOR * sizeof(roar_Container));
+        bitmap->capacity *= GROW_FACTOR;
+    }
+    bitmap->containers[bitmap->count++] = *container;
+}
+
+/*
+ * Removes the container at the specified index.
+ * Θ(c), where c is the number of containers.
+ */
+static void roar_erase(RoaringBitmap* const bitmap, const size_t index)
+{
+    roar_release(&bitmap->containers[index]);
+    bitmap->count--;
+    memmove(&bitmap->containers[index], &bitmap->containers[index + 1],
+            (bitmap->count - index) * sizeof(roar_Container));
+}
+
+/*
+ * Returns a new bitmap of the specified set operation applied to two bitmaps.
+ * Containers are matched up by key; a key present in only one bitmap is copied or skipped as the operation demands.
+ * Θ(n + m)
+ */
+static RoaringBitmap* roar_combine(const RoaringBitmap* const bitmap, const RoaringBitmap* const other,
+                                   const unsigned int op)
+{
+    io_assert(bitmap != NULL, IO_MSG_NULL_PTR);
+    io_assert(other != NULL, IO_MSG_NULL_PTR);
+
+    RoaringBitmap* const result = RoaringBitmap_new();
+
+    /* Lock the data structures to future writers. */
+    sync_read_start(bitmap->rw_sync);
+    if (other != bitmap) sync_read_start(other->rw_sync);
+
+    size_t i = 0, j = 0;
+    while (i < bitmap->count || j < other->count)
+    {
+        const unsigned int a_key = i < bitmap->count ? bitmap->containers[i].key : 0x10000U;
+        const unsigned int b_key = j < other->count ? other->containers[j].key : 0x10000U;
+
+        roar_Container container;
+        if (a_key < b_key)
+        {
+            if (op == AND) { i++; continue; }
+            roar_copy(&bitmap->containers[i++], &container);
+        }
+        else if (b_key < a_key)
+        {
+            if (op != OR) { j++; continue; }
+            roar_copy(&other->containers[j++], &container);
+        }
+        else
+        {
+            roar_apply(&bitmap->containers[i++], &other->containers[j++], op, &container);
+            if (container.cardinality == 0)
+            {
+                roar_release(&container);
+                continue;
+            }
+        }
+        roar_push(result, &container);
+    }
+
+    /* Unlock the data structures. */
+    if (other != bitmap) sync_read_end(other->rw_sync);
+    sync_read_end(bitmap->rw_sync);
+
+    return result;
+}
+
+/*
+ * Returns the number of bytes allocated for the container's data.
+ * Θ(1)
+ */
+static size_t roar_bytes(const roar_Container* const container)
+{
+    switch (container->type)
+    {
+        case ARRAY: return container->capacity * sizeof(unsigned short);
+        case BITMAP: return WORDS * sizeof(unsigned long long);
+        default: return container->capacity * sizeof(roar_Run);
+    }
+}
+
+/*
+ * Frees the container's data.
+ * Θ(1)
+ */
+static void roar_release(roar_Container* const container)
+{
+    mem_free(container->data.values, roar_bytes(container));
+}
+
+/*
+ * Copies a container into `out`, including a copy of its data.
+ * Θ(s), where s is the size of the container.
+ */
+static void roar_copy(const roar_Container* const container, roar_Container* const out)
+{
+    *out = *container;
+    out->data.values = mem_malloc(roar_bytes(container));
+    memcpy(out->data.values, container->data.values, roar_bytes(container));
+}
+
+/*
+ * Returns the index of the first array value which is at least the specified value.
+ * Θ(log(s)), where s is the size of the array.
+ */
+static unsigned int roar_lower_bound(const unsigned short* const values, const unsigned int size,
+                                     const unsigned short low)
+{
+    unsigned int first = 0, last = size;
+    while (first < last)
+    {
+        const unsigned int middle = first + (last - first) / 2;
+        if (values[middle] < low) first = middle + 1;
+        else last = middle;
+    }
+    return first;
+}
+
+/*
+ * Returns true if the container holds the specified lower 16 bits.
+ * Ω(1), O(log(s)), where s is the size of the container.
+ */
+static bool roar_container_contains(const roar_Container* const container, const unsigned short low)
+{
+    switch (container->type)
+    {
+        case ARRAY:
+        {
+            const unsigned int index = roar_lower_bound(container->data.values, container->size, low);
+            return index < container->size && container->data.values[index] == low;
+        }
+        case BITMAP:
+            return TEST(container->data.words, low) != 0;
+        default:
+        {
+            /* Find the last run which starts at or before the value. */
+            const roar_Run* const runs = container->data.runs;
+            unsigned int first = 0, last = container->size;
+            while (first < last)
+            {
+                const unsigned int middle = first + (last - first) / 2;
+                if (runs[middle].start <= low) first = middle + 1;
+                else last = middle;
+            }
+            return first > 0 && low - runs[first - 1].start <= runs[first - 1].length;
+        }
+    }
+}
+
+/*
+ * Inserts the specified lower 16 bits into the container.
+ * A full array is converted into a bitmap, and runs are converted back out of runs.
+ * Returns true if the value was not already present.
+ * Ω(1), O(a), where a is the maximum size of an array container.
+ */
+static bool roar_container_add(roar_Container* const container, const unsigned short low)
+{
+    if (container->type == RUN)
+    {
+        if (roar_container_contains(container, low)) return false;
+        roar_expand(container);
+    }
+
+    if (container->type == ARRAY)
+    {
+        unsigned short* values = container->data.values;
+        const unsigned int index = roar_lower_bound(values, container->size, low);
+        if (index < container->size && values[index] == low) return false;
+
+        if (container->size < ARRAY_MAX)
+        {
+            if (container->size == container->capacity)
+            {
+                const unsigned int capacity = container->capacity * GROW_FACTOR < ARRAY_MAX ?
+                        container->capacity * GROW_FACTOR : ARRAY_MAX;
+                values = container->data.values = mem_realloc(values, container->capacity * sizeof(unsigned short),
+                                                              capacity * sizeof(unsigned short));
+                container->capacity = capacity;
+            }
+
+            memmove(values + index + 1, values + index, (container->size - index) * sizeof(unsigned short));
+            values[index] = low;
+            container->size++;
+            container->cardinality++;
+            return true;
+        }
+
+        roar_to_bitmap(container);
+    }
+
+    if (TEST(container->data.words, low)) return false;
+    SET(container->data.words, low);
+    container->cardinality++;
+    return true;
+}
+
+/*
+ * Removes the specified lower 16 bits from the container.
+ * A bitmap left sparse is converted into an array, and runs are converted back out of runs.
+ * Returns true if the value was present.
+ * Ω(1), O(a), where a is the maximum size of an array container.
+ */
+static bool roar_container_remove(roar_Container* const container, const unsigned short low)
+{
+    if (!roar_container_contains(container, low)) return false;
+    roar_expand(container);
+
+    if (container->type == ARRAY)
+    {
+        unsigned short* const values = container->data.values;
+        const unsigned int index = roar_lower_bound(values, container->size, low);
+        container->size--;
+        memmove(values + index, values + index + 1, (container->size - index) * sizeof(unsigned short));
+    }
+    else container->data.words[low >> 6] &= ~(1ULL << (low & 63));
+
+    container->cardinality--;
+    if (container->type == BITMAP && container->cardinality <= ARRAY_MAX) roar_to_array(container);
+    return true;
+}
+
+/*
+ * Returns the number of runs of consecutive integers in the container.
+ * A bitmap counts the set bits whose lower neighbor is clear, carrying the neighbor across words.
+ * Θ(s), where s is the size of the container.
+ */
+static unsigned int roar_runs(const roar_Container* const container)
+{
+    unsigned int runs = 0;
+    switch (container->type)
+    {
+        case ARRAY:
+            for (unsigned int i = 0; i < container->size; i++)
+                if (i == 0 || container->data.values[i] != container->data.values[i - 1] + 1) runs++;
+            return runs;
+        case BITMAP:
+        {
+            unsigned long long carry = 0;
+            for (unsigned int i = 0; i < WORDS; i++)
+            {
+                const unsigned long long word = container->data.words[i];
+                runs += math_popcount64(word & ~((word << 1) | carry));
+                carry = word >> 63;
+            }
+            return runs;
+        }
+        default:
+            return container->size;
+    }
+}
+
+/*
+ * Converts a container into an array. Its cardinality must not exceed ARRAY_MAX.
+ * Θ(s), where s is the size of the container.
+ */
+static void roar_to_array(roar_Container* const container)
+{
+    if (container->type == ARRAY) return;
+
+    const unsigned int capacity = MAX(container->cardinality, 1);
+    unsigned short* const values = mem_malloc(capacity * sizeof(unsigned short));
+    unsigned int size = 0;
+    if (container->type == BITMAP)
+    {
+        for (unsigned int i = 0; i < WORDS; i++)
+            for (unsigned long long word = container->data.words[i]; word != 0; word &= word - 1)
+                values[size++] = (unsigned short)(i * 64 + math_ilog2(word & (0 - word)));
+    }
+    else
+    {
+        for (unsigned int i = 0; i < container->size; i++)
+        {
+            const roar_Run run = container->data.runs[i];
+            for (unsigned int j = 0; j <= run.length; j++)
+                values[size++] = (unsigned short)(run.start + j);
+        }
+    }
+
+    roar_release(container);
+    container->type = ARRAY;
+    container->data.values = values;
+    container->size = size;
+    container->capacity = capacity;
+}
+
+/*
+ * Converts a container into a bitmap.
+ * Θ(s), where s is the size of the container.
+ */
+static void roar_to_bitmap(roar_Container* const container)
+{
+    if (container->type == BITMAP) return;
+
+    unsigned long long* const words = mem_calloc(WORDS, sizeof(unsigned long long));
+    if (container->type == ARRAY)
+    {
+        for (unsigned int i = 0; i < container->size; i++)
+            SET(words, container->data.values[i]);
+    }
+    else
+    {
+        for (unsigned int i = 0; i < container->size; i++)
+        {
+            const roar_Run run = container->data.runs[i];
+            for (unsigned int j = run.start; j <= (unsigned int)run.start + run.length; j++)
+                SET(words, j);
+        }
+    }
+
+    roar_release(container);
+    container->type = BITMAP;
+    container->data.words = words;
+    container->size = container->capacity = 0;
+}
+
+/*
+ * Converts a container into runs of consecutive integers.
+ * Θ(s), where s is the size of the container.
+ */
+static void roar_to_run(roar_Container* const container)
+{
+    if (container->type == RUN) return;
+
+    const unsigned int capacity = MAX(roar_runs(container), 1);
+    roar_Run* const runs = mem_malloc(capacity * sizeof(roar_Run));
+    unsigned int size = 0;
+    if (container->type == ARRAY)
+    {
+        for (unsigned int i = 0; i < container->size; i++)
+        {
+            const unsigned short low = container->data.values[i];
+            if (size > 0 && low == runs[size - 1].start + runs[size - 1].length + 1) runs[size - 1].length++;
+            else runs[size++] = (roar_Run){ low, 0 };
+        }
+    }
+    else
+    {
+        for (unsigned int i = 0; i < WORDS; i++)
+            for (unsigned long long word = container->data.words[i]; word != 0; word &= word - 1)
+            {
+                const unsigned int low = i * 64 + math_ilog2(word & (0 - word));
+                if (size > 0 && low == runs[size - 1].start + runs[size - 1].length + 1U) runs[size - 1].length++;
+                else runs[size++] = (roar_Run){ (unsigned short)low, 0 };
+            }
+    }
+
+    roar_release(container);
+    container->type = RUN;
+    container->data.runs = runs;
+    container->size = size;
+    container->capacity = capacity;
+}
+
+/*
+ * Converts a run container back into an array or a bitmap, whichever its cardinality calls for.
+ * Θ(s), where s is the size of the container.
+ */
+static void roar_expand(roar_Container* const container)
+{
+    if (container->type != RUN) return;
+    if (container->cardinality <= ARRAY_MAX) roar_to_array(container);
+    else roar_to_bitmap(container);
+}
+
+/*
+ * Applies the specified set operation to two containers of the same key, storing the result into `out`.
+ * Run containers are first expanded into temporary copies. The result is an array if it is small enough.
+ * Θ(s), where s is the combined size of the containers.
+ */
+static void roar_apply(const roar_Container* const a, const roar_Container* const b,
+                       const unsigned int op, roar_Container* const out)
+{
+    roar_Container a_copy, b_copy;
+    const roar_Container *x = a, *y = b;
+    if (a->type == RUN) { roar_copy(a, &a_copy); roar_expand(&a_copy); x = &a_copy; }
+    if (b->type == RUN) { roar_copy(b, &b_copy); roar_expand(&b_copy); y = &b_copy; }
+
+    memset(out, 0, sizeof(roar_Container));
+    out->key = a->key;
+    if (x->type == ARRAY && y->type == ARRAY)
+    {
+        out->type = ARRAY;
+        out->capacity = MAX(op == AND ? (x->size < y->size ? x->size : y->size) :
+                            op == OR ? x->size + y->size : x->size, 1);
+        out->data.values = mem_malloc(out->capacity * sizeof(unsigned short));
+        out->size = op == AND ? roar_intersect(x->data.values, x->size, y->data.values, y->size, out->data.values)
+                : roar_merge(x->data.values, x->size, y->data.values, y->size, op, out->data.values);
+        out->cardinality = out->size;
+        if (out->cardinality > ARRAY_MAX) roar_to_bitmap(out);
+    }
+    else if (x->type == BITMAP && y->type == BITMAP)
+    {
+        out->type = BITMAP;
+        out->data.words = mem_malloc(WORDS * sizeof(unsigned long long));
+        out->cardinality = roar_bitwise(x->data.words, y->data.words, op, out->data.words);
+    }
+    else if (op == AND || (op == ANDNOT && x->type == ARRAY))
+    {
+        /* Filter the array through the bitmap. */
+        const roar_Container* const array = x->type == ARRAY ? x : y;
+        const roar_Container* const bits = x->type == ARRAY ? y : x;
+        out->type = ARRAY;
+        out->capacity = MAX(array->size, 1);
+        out->data.values = mem_malloc(out->capacity * sizeof(unsigned short));
+        out->size = out->cardinality = roar_filter(array->data.values, array->size, bits->data.words,
+                                                   op == AND, out->data.values);
+    }
+    else
+    {
+        /* Set or clear the array's bits within a copy of the bitmap. */
+        const roar_Container* const array = x->type == ARRAY ? x : y;
+        roar_copy(x->type == BITMAP ? x : y, out);
+        out->key = a->key;
+        unsigned long long* const words = out->data.words;
+        for (unsigned int i = 0; i < array->size; i++)
+        {
+            const unsigned short low = array->data.values[i];
+            const bool set = TEST(words, low) != 0;
+            if (op == OR && !set) { SET(words, low); out->cardinality++; }
+            else if (op == ANDNOT && set) { words[low >> 6] &= ~(1ULL << (low & 63)); out->cardinality--; }
+        }
+    }
+
+    if (out->type == BITMAP && out->cardinality <= ARRAY_MAX) roar_to_array(out);
+    if (x == &a_copy) roar_release(&a_copy);
+    if (y == &b_copy) roar_release(&b_copy);
+}
+
+/*
+ * Applies the specified set operation to two bitmaps' words, storing the result into `out`.
+ * Returns the cardinality of the result.
+ * Θ(w), where w is the number of words in a bitmap.
+ */
+static unsigned int roar_bitwise(const unsigned long long* const a, const unsigned long long* const b,
+                                 const unsigned int op, unsigned long long* const out)
+{
+#ifdef ROAR_SSE2
+    for (unsigned int i = 0; i < WORDS; i += 2)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        const __m128i result = op == AND ? _mm_and_si128(x, y) : op == OR ? _mm_or_si128(x, y) : _mm_andnot_si128(y, x);
+        _mm_storeu_si128((__m128i*)(out + i), result);
+    }
+#else
+    for (unsigned int i = 0; i < WORDS; i++)
+        out[i] = op == AND ? a[i] & b[i] : op == OR ? a[i] | b[i] : a[i] & ~b[i];
+#endif
+
+    unsigned int cardinality = 0;
+    for (unsigned int i = 0; i < WORDS; i++)
+        cardinality += math_popcount64(out[i]);
+    return cardinality;
+}
+
+/*
+ * Stores the values common to two sorted arrays into `out`, returning their number.
+ * With SSE2, blocks of eight values from each array are compared all against all, using the eight
+ * rotations of one block, and the block with the smaller maximum is then advanced past.
+ * Θ(a + b)
+ */
+static unsigned int roar_intersect(const unsigned short* const a, const unsigned int a_size,
+                                   const unsigned short* const b, const unsigned int b_size,
+                                   unsigned short* const out)
+{
+    unsigned int i = 0, j = 0, count = 0;
+#ifdef ROAR_SSE2
+#define ROTATE(v, k) _mm_or_si128(_mm_srli_si128(v, 2 * (k)), _mm_slli_si128(v, 16 - 2 * (k)))
+    while (i + 8 <= a_size && j + 8 <= b_size)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(b + j));
+        __m128i matches = _mm_cmpeq_epi16(x, y);
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(x, ROTATE(y, 1)));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(x, ROTATE(y, 2)));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(x, ROTATE(y, 3)));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(x, ROTATE(y, 4)));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(x, ROTATE(y, 5)));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(x, ROTATE(y, 6)));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi16(x, ROTATE(y, 7)));
+
+        /* Each matching value sets both bits of its lane in the mask, of which one is kept. */
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(matches) & 0x5555U;
+        for (; mask != 0; mask &= mask - 1)
+            out[count++] = a[i + math_ilog2(mask & (0 - mask)) / 2];
+
+        const unsigned short a_max = a[i + 7], b_max = b[j + 7];
+        if (a_max <= b_max) i += 8;
+        if (b_max <= a_max) j += 8;
+    }
+#undef ROTATE
+#endif
+
+    while (i < a_size && j < b_size)
+    {
+        if (a[i] < b[j]) i++;
+        else if (b[j] < a[i]) j++;
+        else
+        {
+            out[count++] = a[i];
+            i++, j++;
+        }
+    }
+    return count;
+}
+
+/*
+ * Stores the union or the difference of two sorted arrays into `out`, returning its size.
+ * Θ(a + b)
+ */
+static unsigned int roar_merge(const unsigned short* const a, const unsigned int a_size,
+                               const unsigned short* const b, const unsigned int b_size,
+                               const unsigned int op, unsigned short* const out)
+{
+    unsigned int i = 0, j = 0, count = 0;
+    while (i < a_size && j < b_size)
+    {
+        if (a[i] < b[j]) out[count++] = a[i++];
+        else if (b[j] < a[i])
+        {
+            if (op == OR) out[count++] = b[j];
+            j++;
+        }
+        else
+        {
+            if (op == OR) out[count++] = a[i];
+            i++, j++;
+        }
+    }
+
+    while (i < a_size)
+        out[count++] = a[i++];
+    if (op == OR)
+        while (j < b_size)
+            out[count++] = b[j++];
+    return count;
+}
+
+/*
+ * Stores the array values whose bits are set, or clear if `keep` is false, into `out`, returning their number.
+ * Θ(s), where s is the size of the array.
+ */
+static unsigned int roar_filter(const unsigned short* const values, const unsigned int size,
+                                const unsigned long long* const words, const bool keep,
+                                unsigned short* const out)
+{
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < size; i++)
+        if ((TEST(words, values[i]) != 0) == keep)
+            out[count++] = values[i];
+    return count;
+}
+
+/*
+ * Writes the lowest `bytes` bytes of a value in little-endian order, returning the position after them.
+ * Θ(1)
+ */
+static unsigned char* roar_write(unsigned char* const out, const unsigned long long value, const unsigned int bytes)
+{
+    for (unsigned int i = 0; i < bytes; i++)
+        out[i] = (unsigned char)(value >> (8 * i));
+    return out + bytes;
+}
+
+/*
+ * Reads a value of `bytes` bytes in little-endian order.
+ * Θ(1)
+ */
+static unsigned long long roar_read(const unsigned char* const in, const unsigned int bytes)
+{
+    unsigned long long value = 0;
+    for (unsigned int i = 0; i < bytes; i++)
+        value |= (unsigned long long)in[i] << (8 * i);
+    return value;
+}
+
+/*
+ * Advances the iterator to the next integer, moving on to the next container once one is exhausted.
+ * Θ(1) amortized.
+ */
+static void roar_iter_advance(roar_Iterator* const iter)
+{
+    const RoaringBitmap* const bitmap = iter->ref;
+    while (iter->container < bitmap->count)
+    {
+        const roar_Container* const container = &bitmap->containers[iter->container];
+        const unsigned int high = (unsigned int)container->key << 16;
+        switch (container->type)
+        {
+            case ARRAY:
+                if (iter->position < container->size)
+                {
+                    iter->next = high | container->data.values[iter->position++];
+                    iter->has_next = true;
+                    return;
+                }
+                break;
+            case BITMAP:
+                while (iter->word == 0 && iter->position < WORDS)
+                    iter->word = container->data.words[iter->position++];
+                if (iter->word != 0)
+                {
+                    const unsigned int bit = math_ilog2(iter->word & (0 - iter->word));
+                    iter->word &= iter->word - 1;
+                    iter->next = high | ((iter->position - 1) * 64 + bit);
+                    iter->has_next = true;
+                    return;
+                }
+                break;
+            default:
+                if (iter->position < container->size)
+                {
+                    const roar_Run run = container->data.runs[iter->position];
+                    iter->next = high | (run.start + iter->offset);
+                    if (iter->offset++ == run.length)
+                    {
+                        iter->position++;
+                        iter->offset = 0;
+                    }
+                    iter->has_next = true;
+                    return;
+                }
+                break;
+        }
+
+        iter->container++;
+        iter->position = iter->offset = 0;
+        iter->word = 0;
+    }
+
+    iter->has_next = false;
+}
@@ -0,0 +1,530 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       StringPool.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/StringPool.h"
+#include <limits.h>
+
+/* Slot array capacity components. */
+#define DEFAULT_INITIAL_CAPACITY 16
+#define LOAD_FACTOR 0.5f
+#define GROW_FACTOR 2
+/* Size of a typical arena block. Longer strings receive a block of their own. */
+#define BLOCK_SIZE 65536
+
+/* Number of strings which a shard of the specified capacity can hold. */
+#define DESIGN_LOAD(capacity) ((size_t)((capacity) * LOAD_FACTOR))
+/* Shard which a string of the specified hash is interned in, taken from the hash's highest bits. */
+#define SHARD(pool, hash) ((pool)->shard_bits > 0 ? (unsigned int)((hash) >> (64 - (pool)->shard_bits)) : 0)
+/* Header stored in front of an interned string. */
+#define HEADER(interned) ((const pool_Header*)(interned) - 1)
+
+/*
+ * Layout:
+ * Strings are copied back to back into large arena blocks, each behind a small header holding its
+ * length and ID. Blocks are never moved or freed until the pool is cleared, so interned strings are stable
+ * and cost no allocation of their own. The strings are indexed by an open-addressed table with linear
+ * probing, whose slots carry the length and hash of their string so that most mismatches are rejected
+ * without reading the string itself. Strings are hashed a word at a time rather than a byte at a time.
+ * In sharded mode, the highest bits of a string's hash select one of several independent shards, each
+ * with its own lock, slots and arena.
+ * For details, see: https://en.wikipedia.org/wiki/String_interning
+ */
+
+/* Arena block structure. */
+typedef struct pool_Block
+{
+    struct pool_Block *next;
+    size_t capacity, used;
+    char data[];
+} pool_Block;
+
+/* Header structure, stored in front of each interned string. */
+typedef struct pool_Header
+{
+    unsigned int length, id;
+} pool_Header;
+
+/* Slot structure. An empty slot has a NULL string. */
+typedef struct pool_Slot
+{
+    const char *string;
+    unsigned int hash, length;
+} pool_Slot;
+
+/* Shard structure. */
+typedef struct pool_Shard
+{
+    pool_Slot *slots;
+    size_t capacity, size;
+    /* Interned strings, indexed by the local part of their IDs. */
+    const char **strings;
+    /* Arena blocks, starting with the block being filled. */
+    pool_Block *blocks;
+    size_t bytes;
+    unsigned int index;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+} pool_Shard;
+
+/* StringPool structure. */
+struct StringPool
+{
+    pool_Shard *shards;
+    unsigned int shard_count, shard_bits;
+};
+
+/* Local functions. */
+static unsigned long long pool_hash(const char* const string, size_t length);
+static const char* pool_search(const pool_Shard* const shard, const char* const string,
+                               const size_t length, const unsigned int hash);
+static const char* pool_insert(pool_Shard* const shard, const char* const string,
+                               const size_t length, const unsigned int hash, const unsigned int shard_bits);
+static char* pool_allocate(pool_Shard* const shard, const size_t size);
+static void pool_rehash(pool_Shard* const shard, const size_t capacity);
+static void pool_release(pool_Shard* const shard);
+
+/*
+ * Constructor function.
+ * Θ(s), where s is the number of shards.
+ */
+StringPool* StringPool_new(const unsigned int shards)
+{
+    io_assert(shards > 0, IO_MSG_INVALID_SIZE);
+
+    StringPool* const pool = mem_calloc(1, sizeof(StringPool));
+    pool->shard_count = (unsigned int)math_next_pow2(shards);
+    pool->shard_bits = math_ilog2(pool->shard_count);
+    pool->shards = mem_calloc(pool->shard_count, sizeof(pool_Shard));
+    for (unsigned int i = 0; i < pool->shard_count; i++)
+    {
+        pool_Shard* const shard = &pool->shards[i];
+        shard->slots = mem_calloc(DEFAULT_INITIAL_CAPACITY, sizeof(pool_Slot));
+        shard->strings = mem_malloc(DESIGN_LOAD(DEFAULT_INITIAL_CAPACITY) * sizeof(const char*));
+        shard->capacity = DEFAULT_INITIAL_CAPACITY;
+        shard->index = i;
+        shard->rw_sync = ReadWriteSync_new();
+    }
+    return pool;
+}
+
+/*
+ * Returns the interned copy of the specified string, or NULL if it has not been interned.
+ * Ω(k), O(n + k), where k is the length of the string.
+ */
+const char* pool_find(const StringPool* const pool, const char* const string)
+{
+    io_assert(pool != NULL, IO_MSG_NULL_PTR);
+    io_assert(string != NULL, IO_MSG_NULL_PTR);
+
+    const size_t length = strlen(string);
+    const unsigned long long hash = pool_hash(string, length);
+    const pool_Shard* const shard = &pool->shards[SHARD(pool, hash)];
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(shard->rw_sync);
+
+    const char* const interned = pool_search(shard, string, length, (unsigned int)hash);
+
+    /* Unlock the data structure. */
+    sync_read_end(shard->rw_sync);
+
+    return interned;
+}
+
+/*
+ * Returns the interned string of the specified ID.
+ * Θ(1)
+ */
+const char* pool_string(const StringPool* const pool, const unsigned int id)
+{
+    io_assert(pool != NULL, IO_MSG_NULL_PTR);
+
+    const pool_Shard* const shard = &pool->shards[id & (pool->shard_count - 1)];
+    const size_t local = id >> pool->shard_bits;
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(shard->rw_sync);
+
+    io_assert(local < shard->size, IO_MSG_OUT_OF_BOUNDS);
+    const char* const interned = shard->strings[local];
+
+    /* Unlock the data structure. */
+    sync_read_end(shard->rw_sync);
+
+    return interned;
+}
+
+/*
+ * Returns the ID of an interned string.
+ * The string must have been returned by a pool.
+ * The pool is not needed, as the ID is stored alongside the string.
+ * Θ(1)
+ */
+unsigned int pool_id(const char* const interned)
+{
+    io_assert(interned != NULL, IO_MSG_NULL_PTR);
+    return HEADER(interned)->id;
+}
+
+/*
+ * Returns the length of an interned string.
+ * The string must have been returned by a pool.
+ * The pool is not needed, as the length is stored alongside the string.
+ * Θ(1)
+ */
+size_t pool_length(const char* const interned)
+{
+    io_assert(interned != NULL, IO_MSG_NULL_PTR);
+    return HEADER(interned)->length;
+}
+
+/*
+ * Returns the number of strings in the pool.
+ * Θ(s), where s is the number of shards.
+ */
+size_t pool_size(const StringPool* const pool)
+{
+    io_assert(pool != NULL, IO_MSG_NULL_PTR);
+
+    size_t size = 0;
+    for (unsigned int i = 0; i < pool->shard_count; i++)
+    {
+        const pool_Shard* const shard = &pool->shards[i];
+
+        /* Lock the data structure to future writers. */
+        sync_read_start(shard->rw_sync);
+
+        size += shard->size;
+
+        /* Unlock the data structure. */
+        sync_read_end(shard->rw_sync);
+    }
+
+    return size;
+}
+
+/*
+ * Returns the number of bytes which the pool's strings occupy, including their headers.
+ * Θ(s), where s is the number of shards.
+ */
+size_t pool_bytes(const StringPool* const pool)
+{
+    io_assert(pool != NULL, IO_MSG_NULL_PTR);
+
+    size_t bytes = 0;
+    for (unsigned int i = 0; i < pool->shard_count; i++)
+    {
+        const pool_Shard* const shard = &pool->shards[i];
+
+        /* Lock the data structure to future writers. */
+        sync_read_start(shard->rw_sync);
+
+        bytes += shard->bytes;
+
+        /* Unlock the data structure. */
+        sync_read_end(shard->rw_sync);
+    }
+
+    return bytes;
+}
+
+/*
+ * Prints out the contents of the pool to the console window.
+ * Strings are printed shard by shard, in the order that they were interned.
+ * Θ(n)
+ */
+void pool_print(const StringPool* const pool)
+{
+    io_assert(pool != NULL, IO_MSG_NULL_PTR);
+
+    bool first = true;
+    printf("%c", '[');
+    for (unsigned int i = 0; i < pool->shard_count; i++)
+    {
+        const pool_Shard* const shard = &pool->shards[i];
+
+        /* Lock the data structure to future writers. */
+        sync_read_start(shard->rw_sync);
+
+        for (size_t j = 0; j < shard->size; j++)
+        {
+            printf(first ? "%s" : ", %s", shard->strings[j]);
+            first = false;
+        }
+
+        /* Unlock the data structure. */
+        sync_read_end(shard->rw_sync);
+    }
+    printf("]\n");
+}
+
+/*
+ * Returns the interned copy of the specified string, interning it if necessary.
+ * Ω(k), O(n + k), where k is the length of the string.
+ */
+const char* pool_intern(StringPool* const pool, const char* const string)
+{
+    io_assert(string != NULL, IO_MSG_NULL_PTR);
+    return pool_intern_slice(pool, string, strlen(string));
+}
+
+/*
+ * Returns the interned copy of the specified characters, interning them if necessary.
+ * The characters need not be null-terminated, though their interned copy is.
+ * Strings which are already interned are found under a shared lock.
+ * Ω(k), O(n + k), where k is the length of the string.
+ */
+const char* pool_intern_slice(StringPool* const pool, const char* const string, const size_t length)
+{
+    io_assert(pool != NULL, IO_MSG_NULL_PTR);
+    io_assert(string != NULL, IO_MSG_NULL_PTR);
+    io_assert(length < UINT_MAX, IO_MSG_INVALID_SIZE);
+
+    const unsigned long long hash = pool_hash(string, length);
+    pool_Shard* const shard = &pool->shards[SHARD(pool, hash)];
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(shard->rw_sync);
+
+    const char *interned = pool_search(shard, string, length, (unsigned int)hash);
+
+    /* Unlock the data structure. */
+    sync_read_end(shard->rw_sync);
+
+    if (interned != NULL) return interned;
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(shard->rw_sync);
+
+    /* Another writer may have interned the string since the search. */
+    interned = pool_search(shard, string, length, (unsigned int)hash);
+    if (interned == NULL)
+        interned = pool_insert(shard, string, length, (unsigned int)hash, pool->shard_bits);
+
+    /* Unlock the data structure. */
+    sync_write_end(shard->rw_sync);
+
+    return interned;
+}
+
+/*
+ * Removes all strings from the pool.
+ * Previously interned strings and IDs become invalid.
+ * Θ(n)
+ */
+void pool_clear(StringPool* const pool)
+{
+    io_assert(pool != NULL, IO_MSG_NULL_PTR);
+
+    for (unsigned int i = 0; i < pool->shard_count; i++)
+    {
+        pool_Shard* const shard = &pool->shards[i];
+
+        /* Lock the data structure to future readers/writers. */
+        sync_write_start(shard->rw_sync);
+
+        pool_release(shard);
+        shard->slots = mem_calloc(DEFAULT_INITIAL_CAPACITY, sizeof(pool_Slot));
+        shard->strings = mem_malloc(DESIGN_LOAD(DEFAULT_INITIAL_CAPACITY) * sizeof(const char*));
+        shard->capacity = DEFAULT_INITIAL_CAPACITY;
+        shard->size = shard->bytes = 0;
+
+        /* Unlock the data structure. */
+        sync_write_end(shard->rw_sync);
+    }
+}
+
+/*
+ * De-constructor function.
+ * Θ(n)
+ */
+void pool_destroy(StringPool* const pool)
+{
+    io_assert(pool != NULL, IO_MSG_NULL_PTR);
+
+    for (unsigned int i = 0; i < pool->shard_count; i++)
+    {
+        pool_release(&pool->shards[i]);
+        sync_destroy(pool->shards[i].rw_sync);
+    }
+    mem_free(pool->shards, pool->shard_count * sizeof(pool_Shard));
+    mem_free(pool, sizeof(StringPool));
+}
+
+/*
+ * Returns the hash of the specified characters.
+ * Characters are mixed in eight at a time, and the result is finalized so that every bit is usable.
+ * Θ(k), where k is the length of the string.
+ */
+static unsigned long long pool_hash(const char* const string, size_t length)
+{
+    const char *position = string;
+    unsigned long long hash = length * 0x9E3779B97F4A7C15ULL, word;
+    for (; length >= sizeof(word); length -= sizeof(word), position += sizeof(word))
+    {
+        memcpy(&word, position, sizeof(word));
+        hash ^= word * 0x87C37B91114253D5ULL;
+        hash = ((hash << 31) | (hash >> 33)) * 0x4CF5AD432745937FULL;
+    }
+    if (length > 0)
+    {
+        word = 0;
+        memcpy(&word, position, length);
+        hash ^= word * 0x87C37B91114253D5ULL;
+        hash = ((hash << 31) | (hash >> 33)) * 0x4CF5AD432745937FULL;
+    }
+
+    return math_fmix64(hash);
+}
+
+/*
+ * Returns the interned copy of the specified characters within the shard, or NULL if there is none.
+ * Ω(k), O(n + k), where k is the length of the string.
+ */
+static const char* pool_search(const pool_Shard* const shard, const char* const string,
+                               const size_t length, const unsigned int hash)
+{
+    const size_t mask = shard->capacity - 1;
+    for (size_t i = hash & mask; shard->slots[i].string != NULL; i = (i + 1) & mask)
+    {
+        const pool_Slot* const slot = &shard->slots[i];
+        if (slot->hash == hash && slot->length == length && memcmp(slot->string, string, length) == 0)
+            return slot->string;
+    }
+
+    return NULL;
+}
+
+/*
+ * Interns the specified characters into the shard, which must not contain them yet.
+ * Returns the interned copy.
+ * Θ(k) amortized, where k is the length of the string.
+ */
+static const char* pool_insert(pool_Shard* const shard, const char* const string,
+                               const size_t length, const unsigned int hash, const unsigned int shard_bits)
+{
+    if (shard->size >= DESIGN_LOAD(shard->capacity))
+        pool_rehash(shard, shard->capacity * GROW_FACTOR);
+
+    /* Round up to the header's alignment, leaving room for the null-terminator. */
+    const size_t size = (sizeof(pool_Header) + length + sizeof(pool_Header)) & ~(sizeof(pool_Header) - 1);
+    pool_Header* const header = (pool_Header*)pool_allocate(shard, size);
+    header->length = (unsigned int)length;
+    header->id = (unsigned int)(shard->size << shard_bits) | shard->index;
+    char* const interned = (char*)(header + 1);
+    memcpy(interned, string, length);
+    interned[length] = '\0';
+
+    const size_t mask = shard->capacity - 1;
+    size_t i = hash & mask;
+    while (shard->slots[i].string != NULL)
+        i = (i + 1) & mask;
+    shard->slots[i].string = interned;
+    shard->slots[i].hash = hash;
+    shard->slots[i].length = (unsigned int)length;
+    shard->strings[shard->size++] = interned;
+    return interned;
+}
+
+/*
+ * Allocates the specified number of bytes from the shard's arena.
+ * Θ(1)
+ */
+static char* pool_allocate(pool_Shard* const shard, const size_t size)
+{
+    pool_Block *block = shard->blocks;
+    if (block == NULL || block->capacity - block->used < size)
+    {
+        const size_t capacity = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+        pool_Block* const created = mem_malloc(sizeof(pool_Block) + capacity);
+        created->capacity = capacity;
+        created->used = 0;
+
+        /* An oversized block is filled at once, so the current block continues to be filled. */
+        if (block != NULL && size > BLOCK_SIZE)
+        {
+            created->next = block->next;
+            block->next = created;
+        }
+        else
+        {
+            created->next = block;
+            shard->blocks = created;
+        }
+        block = created;
+    }
+
+    char* const memory = block->data + block->used;
+    block->used += size;
+    shard->bytes += size;
+    return memory;
+}
+
+/*
+ * Re-distributes the shard's strings into a slot array of the specified capacity.
+ * Θ(n)
+ */
+static void pool_rehash(pool_Shard* const shard, const size_t capacity)
+{
+    pool_Slot* const slots = mem_calloc(capacity, sizeof(pool_Slot));
+    const size_t mask = capacity - 1;
+    for (size_t i = 0; i < shard->capacity; i++)
+    {
+        const pool_Slot* const slot = &shard->slots[i];
+        if (slot->string == NULL) continue;
+
+        size_t j = slot->hash & mask;
+        while (slots[j].string != NULL)
+            j = (j + 1) & mask;
+        slots[j] = *slot;
+    }
+
+    shard->strings = mem_realloc(shard->strings, DESIGN_LOAD(shard->capacity) * sizeof(const char*),
+                                 DESIGN_LOAD(capacity) * sizeof(const char*));
+    mem_free(shard->slots, shard->capacity * sizeof(pool_Slot));
+    shard->slots = slots;
+    shard->capacity = capacity;
+}
+
+/*
+ * Frees the shard's slots, string index and arena blocks.
+ * Θ(b), where b is the number of arena blocks.
+ */
+static void pool_release(pool_Shard* const shard)
+{
+    for (pool_Block *block = shard->blocks, *next; block != NULL; block = next)
+    {
+        next = block->next;
+        mem_free(block, sizeof(pool_Block) + block->capacity);
+    }
+    shard->blocks = NULL;
+    mem_free(shard->slots, shard->capacity * sizeof(pool_Slot));
+    mem_free(shard->strings, DESIGN_LOAD(shard->capacity) * sizeof(const char*));
+}
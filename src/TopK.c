@@ -0,0 +1,328 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       TopK.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "../include/TopK.h"
+
+/* Heap navigation. */
+#define PARENT(index) (((index) - 1) / 2)
+#define LEFT(index) (2 * (index) + 1)
+
+/*
+ * Tracking:
+ * Every key is counted by a CountMinSketch, while a min-heap holds the k keys with the largest
+ * estimates seen so far. A key which is added replaces the root of the heap once its estimate
+ * exceeds the smallest tracked estimate. Merging sums the sketches, then re-ranks the union of
+ * both heaps against the merged sketch, so no key's estimate is lost by the merge.
+ */
+
+/* Tracked key structure. */
+typedef struct topk_Entry
+{
+    const void *key;
+    unsigned long long count;
+} topk_Entry;
+
+/* TopK structure. */
+struct TopK
+{
+    CountMinSketch *sketch;
+    /* Min-heap of the tracked keys, ordered by their estimated counts. */
+    topk_Entry *heap;
+    unsigned int k, size;
+
+    /* Synchronization. */
+    ReadWriteSync *rw_sync;
+
+    /* Function pointers. */
+    unsigned int(*hash)(const void*);
+    bool(*equals)(const void*, const void*);
+};
+
+/* Local functions. */
+static void topk_offer(TopK* const topk, const void* const key, const unsigned long long count);
+static void topk_sift_up(TopK* const topk, unsigned int index);
+static void topk_sift_down(TopK* const topk, unsigned int index);
+static int topk_Entry_compare(const void* const a, const void* const b);
+
+/*
+ * Constructor function.
+ * The `hash` function must be defined to call this function.
+ * The `equals` function must be defined to call this function.
+ * Θ(w * d), where w and d are the width and depth
+ */
+TopK* TopK_new(const unsigned int k, const size_t width, const unsigned int depth,
+               unsigned int(*hash)(const void*), bool(*equals)(const void*, const void*))
+{
+    io_assert(k > 0, IO_MSG_INVALID_SIZE);
+    io_assert(hash != NULL, IO_MSG_NOT_SUPPORTED);
+    io_assert(equals != NULL, IO_MSG_NOT_SUPPORTED);
+
+    TopK* const topk = mem_calloc(1, sizeof(TopK));
+    topk->sketch = CountMinSketch_new(width, depth, hash);
+    topk->heap = mem_calloc(k, sizeof(topk_Entry));
+    topk->k = k;
+    topk->hash = hash;
+    topk->equals = equals;
+    topk->rw_sync = ReadWriteSync_new();
+    return topk;
+}
+
+/*
+ * Returns the estimated number of times the specified key was added.
+ * Θ(d), where d is the depth
+ */
+unsigned long long topk_estimate(const TopK* const topk, const void* const key)
+{
+    io_assert(topk != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+    return cms_estimate(topk->sketch, key);
+}
+
+/*
+ * Returns the number of keys currently tracked.
+ * Θ(1)
+ */
+size_t topk_size(const TopK* const topk)
+{
+    io_assert(topk != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(topk->rw_sync);
+
+    const size_t size = topk->size;
+
+    /* Unlock the data structure. */
+    sync_read_end(topk->rw_sync);
+
+    return size;
+}
+
+/*
+ * Returns a new Vector of the tracked keys, from the most to the least frequently added.
+ * Θ(k*log(k))
+ */
+Vector* topk_list(const TopK* const topk)
+{
+    io_assert(topk != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(topk->rw_sync);
+
+    const unsigned int size = topk->size;
+    topk_Entry* const sorted = mem_malloc((size > 0 ? size : 1) * sizeof(topk_Entry));
+    memcpy(sorted, topk->heap, size * sizeof(topk_Entry));
+
+    /* Unlock the data structure. */
+    sync_read_end(topk->rw_sync);
+
+    qsort(sorted, size, sizeof(topk_Entry), &topk_Entry_compare);
+    Vector* const list = Vector_new(NULL, NULL);
+    for (unsigned int i = 0; i < size; i++)
+        vect_push_back(list, sorted[i].key);
+
+    mem_free(sorted, (size > 0 ? size : 1) * sizeof(topk_Entry));
+    return list;
+}
+
+/*
+ * Adds a key to the TopK the specified number of times.
+ * Θ(k + d), where d is the depth
+ */
+void topk_add(TopK* const topk, const void* const key, const unsigned long long count)
+{
+    io_assert(topk != NULL, IO_MSG_NULL_PTR);
+    io_assert(key != NULL, IO_MSG_NULL_PTR);
+
+    const unsigned int hash = topk->hash(key);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(topk->rw_sync);
+
+    cms_add_hash(topk->sketch, hash, count);
+    topk_offer(topk, key, cms_estimate_hash(topk->sketch, hash));
+
+    /* Unlock the data structure. */
+    sync_write_end(topk->rw_sync);
+}
+
+/*
+ * Adds every count which was added to another TopK, as if it had been added to this one.
+ * Both must have the same sketch dimensions and hash function.
+ * Θ(w * d + k * (k + d)), where w and d are the width and depth
+ */
+void topk_merge(TopK* const topk, const TopK* const other)
+{
+    io_assert(topk != NULL, IO_MSG_NULL_PTR);
+    io_assert(other != NULL, IO_MSG_NULL_PTR);
+    io_assert(topk != other, IO_MSG_NOT_SUPPORTED);
+
+    /*
+     * Lock the data structures to future writers, and to readers of the merged TopK.
+     * The lower address is always locked first, so that opposing merges cannot deadlock.
+     */
+    if (topk < other)
+    {
+        sync_write_start(topk->rw_sync);
+        sync_read_start(other->rw_sync);
+    }
+    else
+    {
+        sync_read_start(other->rw_sync);
+        sync_write_start(topk->rw_sync);
+    }
+
+    cms_merge(topk->sketch, other->sketch);
+
+    /* Gather both sets of tracked keys, then re-rank them against the merged sketch. */
+    const unsigned int candidates = topk->size + other->size;
+    const void** const keys = mem_malloc((candidates > 0 ? candidates : 1) * sizeof(void*));
+    for (unsigned int i = 0; i < topk->size; i++)
+        keys[i] = topk->heap[i].key;
+    for (unsigned int i = 0; i < other->size; i++)
+        keys[topk->size + i] = other->heap[i].key;
+
+    topk->size = 0;
+    for (unsigned int i = 0; i < candidates; i++)
+        topk_offer(topk, keys[i], cms_estimate(topk->sketch, keys[i]));
+    mem_free((void*)keys, (candidates > 0 ? candidates : 1) * sizeof(void*));
+
+    /* Unlock the data structures. */
+    sync_read_end(other->rw_sync);
+    sync_write_end(topk->rw_sync);
+}
+
+/*
+ * Removes every count and tracked key from the TopK.
+ * Θ(w * d), where w and d are the width and depth
+ */
+void topk_clear(TopK* const topk)
+{
+    io_assert(topk != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(topk->rw_sync);
+
+    cms_clear(topk->sketch);
+    topk->size = 0;
+
+    /* Unlock the data structure. */
+    sync_write_end(topk->rw_sync);
+}
+
+/*
+ * De-constructor function.
+ * Θ(1)
+ */
+void topk_destroy(TopK* const topk)
+{
+    io_assert(topk != NULL, IO_MSG_NULL_PTR);
+    cms_destroy(topk->sketch);
+    mem_free(topk->heap, topk->k * sizeof(topk_Entry));
+    sync_destroy(topk->rw_sync);
+    mem_free(topk, sizeof(TopK));
+}
+
+/*
+ * Updates the estimate of a tracked key, or starts tracking the key if its estimate is large enough.
+ * Note: The TopK must already be locked.
+ * Θ(k)
+ */
+static void topk_offer(TopK* const topk, const void* const key, const unsigned long long count)
+{
+    for (unsigned int i = 0; i < topk->size; i++)
+        if (topk->heap[i].key == key || topk->equals(key, topk->heap[i].key))
+        {
+            /* Estimates only grow, so the key can only sink away from the root. */
+            if (count > topk->heap[i].count)
+            {
+                topk->heap[i].count = count;
+                topk_sift_down(topk, i);
+            }
+            return;
+        }
+
+    if (topk->size < topk->k)
+    {
+        topk->heap[topk->size].key = key;
+        topk->heap[topk->size].count = count;
+        topk_sift_up(topk, topk->size++);
+    }
+    /* Evict the least frequent tracked key. */
+    else if (count > topk->heap[0].count)
+    {
+        topk->heap[0].key = key;
+        topk->heap[0].count = count;
+        topk_sift_down(topk, 0);
+    }
+}
+
+/*
+ * Moves the entry at the specified index up the heap until its parent's count is no larger.
+ * Θ(log(k))
+ */
+static void topk_sift_up(TopK* const topk, unsigned int index)
+{
+    const topk_Entry entry = topk->heap[index];
+    while (index > 0 && topk->heap[PARENT(index)].count > entry.count)
+    {
+        topk->heap[index] = topk->heap[PARENT(index)];
+        index = PARENT(index);
+    }
+    topk->heap[index] = entry;
+}
+
+/*
+ * Moves the entry at the specified index down the heap until its children's counts are no smaller.
+ * Θ(log(k))
+ */
+static void topk_sift_down(TopK* const topk, unsigned int index)
+{
+    const topk_Entry entry = topk->heap[index];
+    while (LEFT(index) < topk->size)
+    {
+        unsigned int child = LEFT(index);
+        if (child + 1 < topk->size && topk->heap[child + 1].count < topk->heap[child].count)
+            child++;
+        if (topk->heap[child].count >= entry.count)
+            break;
+        topk->heap[index] = topk->heap[child];
+        index = child;
+    }
+    topk->heap[index] = entry;
+}
+
+/*
+ * Orders entries from the largest to the smallest count.
+ * Θ(1)
+ */
+static int topk_Entry_compare(const void* const a, const void* const b)
+{
+    const unsigned long long count_a = ((const topk_Entry*)a)->count, count_b = ((const topk_Entry*)b)->count;
+    return (count_a < count_b) - (count_a > count_b);
+}
@@ -28,30 +28,73 @@ SOFTWARE.
  */
 
 #include "../include/Vector.h"
+#include <limits.h>
 
-/* Array capacity components. */
-#define DEFAULT_INITIAL_CAPACITY 10
+/* Array capacity components. Capacities are powers of two, so indexes wrap with a mask. */
+#define DEFAULT_INITIAL_CAPACITY 16
 #define GROW_FACTOR 2
 
-#define INDEX_RIGHT(index, capacity) (index == capacity - 1) ? 0 : index + 1
-#define INDEX_LEFT(index, capacity) (index == 0) ? capacity - 1 : index - 1
+#define INDEX_RIGHT(index, capacity) (((index) + 1) & ((capacity) - 1))
+#define INDEX_LEFT(index, capacity) (((index) - 1) & ((capacity) - 1))
 
-/* Vector structure. */
+/* Vectors smaller than this are shuffled by a single thread. */
+#define PARALLEL_SHUFFLE_MIN 65536
+
+/* Read-copy-update components. */
+#define EPOCHS 3
+/* The sequence is odd while a writer is modifying the Vector. */
+#define LOCKED(sequence) (((sequence) & 1) != 0)
+
+/*
+ * Read-copy-update:
+ * Accessors read the Vector's properties without locking, then check that the sequence did not change.
+ * Growth fills the larger table while readers continue to read the old one, then swaps the tables.
+ * Readers announce themselves in the current epoch. The epoch only advances once every reader of the epoch
+ * before it has left, so a table retired in epoch e is unreachable by the time the epoch reaches e + 2.
+ */
+
+/* Table which was replaced, but may still be read. */
+typedef struct vect_Retired vect_Retired;
+struct vect_Retired
+{
+    const void **table;
+    sync_Word *refs;
+    size_t capacity;
+    LONG64 epoch;
+    vect_Retired *next;
+};
+
+/* Vector structure. Its leading members must match `vect_Layout`, which the unchecked accessors read. */
 struct Vector
 {
     const void** table;
     /* Start and end let us know where the data is. */
     unsigned int start, end;
     size_t size, capacity;
+    /* Number of Vectors sharing the table. Shared tables are copied before they are modified. */
+    sync_Word* refs;
 
     /* Synchronization. */
     ReadWriteSync *rw_sync;
+    /* Read-copy-update. Depth counts nested writes of the writer holding the lock. */
+    bool rcu;
+    unsigned int depth;
+    sync_Word sequence, epoch, readers[EPOCHS];
+    vect_Retired *retired;
 
     /* Function pointers. */
     int(*compare)(const void*, const void*);
     char*(*toString)(const void*);
 };
 
+/* Portion of a parallel shuffle, which a single thread performs. */
+typedef struct vect_Shuffle
+{
+    const void** table;
+    /* Either shuffles [start, end), or merges the shuffled ranges [start, middle) and [middle, end). */
+    size_t start, middle, end;
+} vect_Shuffle;
+
 /* Structure to assist in looping through Vector. */
 struct vect_Iterator
 {
@@ -69,6 +112,21 @@ static void vect_merge_sort(const Vector* const vect, const unsigned int start,
 static void vect_quick_sort(const Vector* const vect, const unsigned int index, const size_t size);
 static void vect_shift(Vector* const vect, const unsigned int start, const unsigned int stop, const bool leftwards);
 static unsigned int vect_backend_index(const Vector *const vect, const unsigned int index);
+static const void* vect_element(const Vector* const vect, const unsigned int index);
+static void vect_write_start(const Vector* const vect);
+static void vect_write_end(const Vector* const vect);
+static size_t vect_rcu_read(const Vector* const vect, const size_t index, const bool backwards, const void** const data);
+static unsigned int vect_rcu_enter(Vector* const vect);
+static void vect_rcu_exit(Vector* const vect, const unsigned int slot);
+static void vect_rcu_retire(Vector* const vect, const void** const table, const size_t capacity, sync_Word* const refs);
+static sync_Word* vect_refs_new();
+static void vect_release(const void** const table, const size_t capacity, sync_Word* const refs);
+static void vect_rcu_reclaim(Vector* const vect);
+static DWORD vect_shuffle_block(vect_Shuffle* const task);
+static DWORD vect_shuffle_merge(vect_Shuffle* const task);
+static bool vect_sample_add(unsigned int* const set, const size_t slots, const unsigned int index);
+static void vect_shuffle_run(vect_Shuffle* const tasks, const unsigned int count,
+                             DWORD(*task)(vect_Shuffle* const));
 
 /*
  * Constructor function.
@@ -78,6 +136,7 @@ Vector* Vector_new(int(*compare)(const void*, const void*), char*(*toString)(con
 {
     Vector* const vect = mem_calloc(1, sizeof(Vector));
     vect->table = mem_calloc(DEFAULT_INITIAL_CAPACITY, sizeof(void*));
+    vect->refs = vect_refs_new();
     vect->capacity = DEFAULT_INITIAL_CAPACITY;
     vect->compare = compare;
     vect->toString = toString;
@@ -93,6 +152,15 @@ void* vect_at(const Vector* const vect, const unsigned int index)
 {
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
+    if (vect->rcu)
+    {
+        const void* val = NULL;
+        const size_t size = vect_rcu_read(vect, index, false, &val);
+        io_assert(index < size, IO_MSG_OUT_OF_BOUNDS);
+        (void)size;
+        return (void*)val;
+    }
+
     /* Lock the data structure to future writers. */
     sync_read_start(vect->rw_sync);
 
@@ -115,6 +183,15 @@ void* vect_front(const Vector* const vect)
 {
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
+    if (vect->rcu)
+    {
+        const void* val = NULL;
+        const size_t size = vect_rcu_read(vect, 0, false, &val);
+        io_assert(size > 0, IO_MSG_EMPTY);
+        (void)size;
+        return (void*)val;
+    }
+
     /* Lock the data structure to future writers. */
     sync_read_start(vect->rw_sync);
 
@@ -135,6 +212,15 @@ void* vect_back(const Vector* const vect)
 {
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
+    if (vect->rcu)
+    {
+        const void* val = NULL;
+        const size_t size = vect_rcu_read(vect, 0, true, &val);
+        io_assert(size > 0, IO_MSG_EMPTY);
+        (void)size;
+        return (void*)val;
+    }
+
     /* Lock the data structure to future writers. */
     sync_read_start(vect->rw_sync);
 
@@ -155,6 +241,9 @@ size_t vect_size(const Vector* const vect)
 {
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
+    if (vect->rcu)
+        return vect_rcu_read(vect, 0, false, NULL);
+
     /* Lock the data structure to future writers. */
     sync_read_start(vect->rw_sync);
 
@@ -174,6 +263,9 @@ bool vect_empty(const Vector* const vect)
 {
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
+    if (vect->rcu)
+        return vect_rcu_read(vect, 0, false, NULL) == 0;
+
     /* Lock the data structure to future writers. */
     sync_read_start(vect->rw_sync);
 
@@ -278,14 +370,28 @@ void vect_print(const Vector* const vect)
 
 /*
  * Returns a shallow copy of the Vector.
- * Θ(n)
+ * The copy shares the Vector's table until either of them is modified, which copies the table.
+ * Θ(1)
  */
 Vector* vect_clone(const Vector* const vect)
 {
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
-    Vector* const copy = Vector_new(vect->compare, vect->toString);
-    vect_append(copy, vect);
+    Vector* const copy = mem_calloc(1, sizeof(Vector));
+    copy->compare = vect->compare;
+    copy->toString = vect->toString;
+    copy->rw_sync = ReadWriteSync_new();
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(vect->rw_sync);
+
+    copy->table = vect->table;
+    copy->refs = vect->refs;
+    sync_fetch_add(copy->refs, 1);
+    copy->start = vect->start;
+    copy->end = vect->end;
+    copy->size = vect->size;
+    copy->capacity = vect->capacity;
 
     /* Unlock the data structure. */
     sync_read_end(vect->rw_sync);
@@ -293,6 +399,101 @@ Vector* vect_clone(const Vector* const vect)
     return copy;
 }
 
+/*
+ * Returns a View of the specified number of elements, starting at the specified index.
+ * When the range wraps around the end of the table, the second segment continues from the table's start.
+ * Θ(1)
+ */
+vect_View vect_view(const Vector* const vect, const unsigned int index, const size_t length)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    vect_View view;
+    memset(&view, 0, sizeof(vect_View));
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(vect->rw_sync);
+
+    io_assert(index <= vect->size && length <= vect->size - index, IO_MSG_OUT_OF_BOUNDS);
+
+    if (length > 0)
+    {
+        const unsigned int first = vect_backend_index(vect, index);
+        const size_t before_wrap = vect->capacity - first;
+
+        view.segments[0].data = vect->table + first;
+        view.segments[0].length = length < before_wrap ? length : before_wrap;
+        if (length > before_wrap)
+        {
+            view.segments[1].data = vect->table;
+            view.segments[1].length = length - before_wrap;
+        }
+        view.size = length;
+    }
+
+    /* Unlock the data structure. */
+    sync_read_end(vect->rw_sync);
+
+    return view;
+}
+
+/*
+ * Returns a new Vector of the specified number of elements, chosen at random without replacement.
+ * Utilizes Floyd's Sampling Algorithm, which draws exactly `count` random indexes:
+ * each draw covers one more index than the last, and a repeated draw takes that newest index instead.
+ * Elements are appended in no particular order.
+ * Θ(k), where k is the count
+ */
+Vector* vect_sample(const Vector* const vect, const unsigned int count)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    Vector* const sample = Vector_new(vect->compare, vect->toString);
+    vect_resize(sample, count);
+
+    /* Lock the data structure to future writers. */
+    sync_read_start(vect->rw_sync);
+
+    io_assert(count <= vect->size, IO_MSG_INVALID_SIZE);
+
+    /* Open-addressed set of the chosen indexes, at most half full. */
+    const size_t slots = math_next_pow2((size_t)count * 2);
+    unsigned int* const chosen = mem_malloc(slots * sizeof(unsigned int));
+    memset(chosen, 0xFF, slots * sizeof(unsigned int));
+
+    const unsigned int size = (unsigned int)vect->size;
+    for (unsigned int i = size - count; i < size; i++)
+    {
+        unsigned int index = rand_limit(i + 1);
+        /* The newest index cannot have been chosen yet. */
+        if (!vect_sample_add(chosen, slots, index))
+        {
+            index = i;
+            vect_sample_add(chosen, slots, i);
+        }
+        vect_push_back(sample, vect_element(vect, index));
+    }
+
+    /* Unlock the data structure. */
+    sync_read_end(vect->rw_sync);
+
+    mem_free(chosen, slots * sizeof(unsigned int));
+    return sample;
+}
+
+/*
+ * Returns the element at the specified index of the View.
+ * Θ(1)
+ */
+void* vect_view_at(const vect_View* const view, const size_t index)
+{
+    io_assert(view != NULL, IO_MSG_NULL_PTR);
+    io_assert(index < view->size, IO_MSG_OUT_OF_BOUNDS);
+
+    const size_t first = view->segments[0].length;
+    return (void*)(index < first ? view->segments[0].data[index] : view->segments[1].data[index - first]);
+}
+
 /*
  * Replaces an element in the Vector at a specified index.
  * Θ(1)
@@ -303,14 +504,14 @@ void vect_assign(const Vector* const vect, const unsigned int index, const void*
     io_assert(data != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     io_assert(index < vect->size, IO_MSG_OUT_OF_BOUNDS);
 
     vect->table[vect_backend_index(vect, index)] = data;
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -323,7 +524,7 @@ void vect_insert(Vector* const vect, const unsigned int index, const void* const
     io_assert(data != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     io_assert(index <= vect->size, IO_MSG_OUT_OF_BOUNDS);
 
@@ -353,7 +554,7 @@ void vect_insert(Vector* const vect, const unsigned int index, const void* const
     }
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -368,7 +569,7 @@ bool vect_remove(Vector* const vect, const void* const data)
     io_assert(vect->compare != NULL, IO_MSG_NOT_SUPPORTED);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     unsigned int index;
     bool success;
@@ -376,7 +577,7 @@ bool vect_remove(Vector* const vect, const void* const data)
         vect_erase(vect, index);
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 
     return success;
 }
@@ -390,7 +591,7 @@ void vect_erase(Vector* const vect, const unsigned int index)
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     io_assert(index < vect->size, IO_MSG_OUT_OF_BOUNDS);
 
@@ -416,7 +617,7 @@ void vect_erase(Vector* const vect, const unsigned int index)
     }
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -429,14 +630,14 @@ void vect_push_back(Vector * const vect, const void* const data)
     io_assert(data != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     /* Check if we need to increase the array's capacity. */
     if (vect_full(vect))
         vect_resize(vect, vect->size + 1);
 
     /* When Vector has one or less element(s), start and end must point to the same index. */
-    if (!vect_empty(vect))
+    if (vect->size > 0)
         /* Increment end and wrap. */
         vect->end = INDEX_RIGHT(vect->end, vect->capacity);
 
@@ -444,7 +645,7 @@ void vect_push_back(Vector * const vect, const void* const data)
     vect->size++;
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -457,14 +658,14 @@ void vect_push_front(Vector* const vect, const void* const data)
     io_assert(data != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     /* Check if we need to increase the array's capacity. */
     if (vect_full(vect))
         vect_resize(vect, vect->size + 1);
 
     /* When Vector has one or less element(s), start and end must point to the same index. */
-    if (!vect_empty(vect))
+    if (vect->size > 0)
         /* Increment end and wrap. */
         vect->start = INDEX_LEFT(vect->start, vect->capacity);
 
@@ -472,7 +673,7 @@ void vect_push_front(Vector* const vect, const void* const data)
     vect->size++;
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -484,7 +685,7 @@ void vect_pop_back(Vector* const vect)
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     io_assert(vect->size > 0, IO_MSG_EMPTY);
 
@@ -493,7 +694,7 @@ void vect_pop_back(Vector* const vect)
         vect->end = INDEX_LEFT(vect->end, vect->capacity);
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -505,7 +706,7 @@ void vect_pop_front(Vector* const vect)
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     io_assert(vect->size > 0, IO_MSG_EMPTY);
 
@@ -514,7 +715,7 @@ void vect_pop_front(Vector* const vect)
         vect->start = INDEX_RIGHT(vect->start, vect->capacity);
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -527,7 +728,7 @@ void vect_append(Vector* const vect, const Vector* const other)
     io_assert(other != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
     /* Lock the other data structure to future writers. */
     sync_read_start(other->rw_sync);
 
@@ -541,7 +742,7 @@ void vect_append(Vector* const vect, const Vector* const other)
     vect_iter_destroy(iter);
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
     /* Unlock the other data structure. */
     sync_read_end(other->rw_sync);
 }
@@ -551,7 +752,7 @@ void vect_append(Vector* const vect, const Vector* const other)
  * This function can be used both to grow and shrink the Vector.
  * Specified sizes which are less than the amount of elements are ignored.
  * The final capacity will always be of the form x * y^n,
- * where x is the default initial capacity, y is the grow factor.
+ * where x is the default initial capacity, y is the grow factor. Both are powers of two.
  * Ω(1), O(n)
  */
 void vect_resize(Vector *const vect, const size_t min_size)
@@ -559,31 +760,45 @@ void vect_resize(Vector *const vect, const size_t min_size)
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     size_t desired_capacity = DEFAULT_INITIAL_CAPACITY;
     if (min_size > DEFAULT_INITIAL_CAPACITY)
-        /* Capacity becomes the nth power of the grow factor times the default initial capacity. */
-        desired_capacity *= math_min_power_gt(GROW_FACTOR, MATH_DIV_CEIL(min_size, DEFAULT_INITIAL_CAPACITY));
+        /* Both are powers of two, so the capacity is the next power of two. */
+        desired_capacity = math_next_pow2(min_size);
 
     if (desired_capacity >= vect->size)
     {
+        /* Every caller grows the Vector before modifying it, so readers may read the old table during the copy. */
+        if (vect->rcu)
+            sync_fetch_add(&vect->sequence, 1);
+
         /* Create a larger table and add the old table's data into it. */
         const void **const expanded_table = mem_calloc(desired_capacity, sizeof(void *));
         for (unsigned int i = 0; i < vect->size; i++)
-            expanded_table[i] = vect_at(vect, i);
+            expanded_table[i] = vect_element(vect, i);
+        const void **const table = vect->table;
+        sync_Word *const refs = vect->refs;
+
+        if (vect->rcu)
+            sync_fetch_add(&vect->sequence, 1);
 
-        /* Destroy the old table. */
-        mem_free(vect->table, vect->capacity * sizeof(void *));
         /* Update the Vector's properties. */
-        vect->table = expanded_table;
-        vect->capacity = desired_capacity;
+        sync_store_ptr(&vect->table, expanded_table);
+        vect->refs = vect_refs_new();
         vect->start = 0;
-        vect->end = !vect_empty(vect) ? vect->size - 1 : 0;
+        vect->end = vect->size > 0 ? vect->size - 1 : 0;
+
+        /* Destroy the old table once no reader can be reading it. */
+        if (vect->rcu)
+            vect_rcu_retire(vect, table, vect->capacity, refs);
+        else
+            vect_release(table, vect->capacity, refs);
+        vect->capacity = desired_capacity;
     }
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -595,12 +810,12 @@ void vect_clear(Vector* const vect)
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     vect->start = vect->end = vect->size = 0;
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -613,12 +828,12 @@ void vect_sort(const Vector* const vect)
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
     vect_quick_sort(vect, 0, vect->size);
 
     /* Unlock the data structure. */
-    sync_write_end(vect->rw_sync);
+    vect_write_end(vect);
 }
 
 /*
@@ -632,14 +847,97 @@ void vect_shuffle(const Vector* const vect)
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
     /* Lock the data structure to future readers/writers. */
-    sync_write_start(vect->rw_sync);
+    vect_write_start(vect);
 
-    for (unsigned int i = vect->size - 1; i > 0; i--)
+    for (unsigned int i = (unsigned int)vect->size; i > 1; i--)
     {
-        const unsigned int swap_location = rand_limit(i + 1);
-        vect_swap(vect, i, swap_location);
+        const unsigned int swap_location = rand_limit(i);
+        vect_pswap(&vect->table[vect_backend_index(vect, i - 1)],
+                   &vect->table[vect_backend_index(vect, swap_location)]);
     }
 
+    /* Unlock the data structure. */
+    vect_write_end(vect);
+}
+
+/*
+ * Shuffles the elements inside the Vector pseudo-randomly, using up to the specified number of threads.
+ * Utilizes the MergeShuffle Algorithm, which shuffles blocks in parallel, then merges pairs of blocks in parallel
+ * by coin flips. For details, see: Bacher, Bodini, Hollender, and Lumbroso, "MergeShuffle".
+ * Small Vectors are shuffled by the calling thread alone.
+ * Θ(n * log(t)) work, where t is the number of threads
+ */
+void vect_shuffle_parallel(Vector* const vect, const unsigned int threads)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+    io_assert(threads > 0, IO_MSG_INVALID_SIZE);
+
+    /* Lock the data structure to future readers/writers. */
+    vect_write_start(vect);
+
+    if (threads == 1 || vect->size < PARALLEL_SHUFFLE_MIN)
+        vect_shuffle(vect);
+    else
+    {
+        /* Blocks must be contiguous, so a table which wraps around is straightened first. */
+        if (vect->start + vect->size > vect->capacity)
+            vect_resize(vect, vect->capacity);
+
+        /* Blocks merge in pairs, so their number is the largest power of two within the thread count. */
+        unsigned int blocks = (unsigned int)math_next_pow2(threads);
+        if (blocks > threads) blocks >>= 1;
+
+        /* Block boundaries, evenly spread over the Vector. */
+        size_t* const bounds = mem_malloc((blocks + 1) * sizeof(size_t));
+        for (unsigned int i = 0; i <= blocks; i++)
+            bounds[i] = (size_t)((unsigned long long)vect->size * i / blocks);
+
+        vect_Shuffle* const tasks = mem_malloc(blocks * sizeof(vect_Shuffle));
+        for (unsigned int i = 0; i < blocks; i++)
+        {
+            tasks[i].table = vect->table + vect->start;
+            tasks[i].start = tasks[i].middle = bounds[i];
+            tasks[i].end = bounds[i + 1];
+        }
+        vect_shuffle_run(tasks, blocks, vect_shuffle_block);
+
+        /* Each round merges pairs of neighboring ranges, halving the number of ranges. */
+        for (unsigned int width = 1; width < blocks; width <<= 1)
+        {
+            const unsigned int merges = blocks / (width * 2);
+            for (unsigned int i = 0; i < merges; i++)
+            {
+                tasks[i].start = bounds[i * width * 2];
+                tasks[i].middle = bounds[i * width * 2 + width];
+                tasks[i].end = bounds[(i + 1) * width * 2];
+            }
+            vect_shuffle_run(tasks, merges, vect_shuffle_merge);
+        }
+
+        mem_free(tasks, blocks * sizeof(vect_Shuffle));
+        mem_free(bounds, (blocks + 1) * sizeof(size_t));
+    }
+
+    /* Unlock the data structure. */
+    vect_write_end(vect);
+}
+
+/*
+ * Sets whether the Vector grows by read-copy-update.
+ * While enabled, `vect_at`, `vect_front`, `vect_back`, `vect_size`, and `vect_empty` do not lock.
+ * They retry only while a writer modifies the Vector in place, and never wait on the Vector growing.
+ * Replaced tables are de-allocated once no reader can still be reading them.
+ * Θ(1)
+ */
+void vect_rcu(Vector* const vect, const bool enabled)
+{
+    io_assert(vect != NULL, IO_MSG_NULL_PTR);
+
+    /* Lock the data structure to future readers/writers. */
+    sync_write_start(vect->rw_sync);
+
+    vect->rcu = enabled;
+
     /* Unlock the data structure. */
     sync_write_end(vect->rw_sync);
 }
@@ -652,7 +950,14 @@ void vect_destroy(Vector* const vect)
 {
     io_assert(vect != NULL, IO_MSG_NULL_PTR);
 
-    mem_free(vect->table, vect->capacity * sizeof(void*));
+    vect_release(vect->table, vect->capacity, vect->refs);
+    while (vect->retired != NULL)
+    {
+        vect_Retired* const retired = vect->retired;
+        vect->retired = retired->next;
+        vect_release(retired->table, retired->capacity, retired->refs);
+        mem_free(retired, sizeof(vect_Retired));
+    }
     sync_destroy(vect->rw_sync);
     mem_free(vect, sizeof(Vector));
 }
@@ -770,8 +1075,8 @@ bool vect_full(const Vector* const vect)
 */
 void vect_swap(const Vector* const vect, const unsigned int i, const unsigned int h)
 {
-    const void* const temp = vect_at(vect, i);
-    vect_assign(vect, i, vect_at(vect, h));
+    const void* const temp = vect_element(vect, i);
+    vect_assign(vect, i, vect_element(vect, h));
     vect_assign(vect, h, temp);
 }
 
@@ -792,7 +1097,198 @@ void vect_pswap(const void **const v1, const void **const v2)
  */
 unsigned int vect_backend_index(const Vector *const vect, const unsigned int index)
 {
-    return (vect->start + index) % vect->capacity;
+    return (vect->start + index) & (vect->capacity - 1);
+}
+
+/*
+ * Returns the element at the specified index without locking.
+ * Used by writers, which already hold the Vector's lock.
+ * Θ(1)
+ */
+const void* vect_element(const Vector* const vect, const unsigned int index)
+{
+    return vect->table[vect_backend_index(vect, index)];
+}
+
+/*
+ * Locks the Vector to future readers/writers.
+ * A table which is shared with clones is copied, so that the write does not affect them.
+ * With read-copy-update, the outermost write also makes the sequence odd so that lock-free readers retry.
+ * Θ(1), or Θ(n) if the table is shared
+ */
+void vect_write_start(const Vector* const vect)
+{
+    Vector* const writable = (Vector*)vect;
+    sync_write_start(writable->rw_sync);
+
+    /* Readers may keep reading the shared table while it is copied. */
+    const void** const shared = writable->table;
+    const void** copy = NULL;
+    if (sync_load(writable->refs) > 1)
+    {
+        copy = mem_malloc(writable->capacity * sizeof(void*));
+        memcpy(copy, shared, writable->capacity * sizeof(void*));
+    }
+
+    if (writable->rcu && writable->depth++ == 0)
+        sync_fetch_add(&writable->sequence, 1);
+
+    if (copy != NULL)
+    {
+        sync_Word* const refs = writable->refs;
+        sync_store_ptr(&writable->table, copy);
+        writable->refs = vect_refs_new();
+        if (writable->rcu)
+            vect_rcu_retire(writable, shared, writable->capacity, refs);
+        else
+            vect_release(shared, writable->capacity, refs);
+    }
+}
+
+/*
+ * Unlocks the Vector, making the sequence even again after the outermost write.
+ * Θ(1) amortized
+ */
+void vect_write_end(const Vector* const vect)
+{
+    Vector* const writable = (Vector*)vect;
+    if (writable->rcu && --writable->depth == 0)
+    {
+        sync_fetch_add(&writable->sequence, 1);
+        if (writable->retired != NULL)
+            vect_rcu_reclaim(writable);
+    }
+    sync_write_end(writable->rw_sync);
+}
+
+/*
+ * Reads the Vector's size and, if `data` is non-NULL, the element at the specified index without locking.
+ * Backwards indexes count from the back of the Vector. Indexes past the size read no element.
+ * Θ(1) when uncontended
+ */
+size_t vect_rcu_read(const Vector* const vect, const size_t index, const bool backwards, const void** const data)
+{
+    Vector* const readable = (Vector*)vect;
+    const unsigned int slot = vect_rcu_enter(readable);
+
+    size_t size = 0;
+    for (unsigned int attempt = 0; ; sync_backoff(attempt++))
+    {
+        const LONG64 sequence = sync_load(&vect->sequence);
+        if (LOCKED(sequence)) continue;
+
+        const void** const table = sync_load_ptr(&vect->table);
+        const size_t capacity = vect->capacity;
+        const unsigned int start = vect->start;
+        size = vect->size;
+
+        /* The properties must agree with each other before the table may be indexed. */
+        sync_load_fence();
+        if (sync_load(&vect->sequence) != sequence) continue;
+        if (data == NULL || index >= size) break;
+
+        *data = table[(start + (backwards ? size - 1 - index : index)) & (capacity - 1)];
+
+        /* The element must not have been moved while it was read. */
+        sync_load_fence();
+        if (sync_load(&vect->sequence) == sequence) break;
+    }
+
+    vect_rcu_exit(readable, slot);
+    return size;
+}
+
+/*
+ * Announces a reader in the current epoch and returns the epoch's slot.
+ * Θ(1) when uncontended
+ */
+unsigned int vect_rcu_enter(Vector* const vect)
+{
+    while (true)
+    {
+        const LONG64 epoch = sync_load(&vect->epoch);
+        const unsigned int slot = (unsigned int)(epoch % EPOCHS);
+        sync_fetch_add(&vect->readers[slot], 1);
+
+        /* The epoch may have advanced before the reader was counted. */
+        if (sync_load(&vect->epoch) == epoch)
+            return slot;
+        sync_fetch_add(&vect->readers[slot], -1);
+    }
+}
+
+/*
+ * Removes a reader from the epoch it announced itself in.
+ * Θ(1)
+ */
+void vect_rcu_exit(Vector* const vect, const unsigned int slot)
+{
+    sync_fetch_add(&vect->readers[slot], -1);
+}
+
+/*
+ * Defers the de-allocation of a table which readers can no longer reach, but may still be reading.
+ * Θ(1)
+ */
+void vect_rcu_retire(Vector* const vect, const void** const table, const size_t capacity, sync_Word* const refs)
+{
+    vect_Retired* const retired = mem_malloc(sizeof(vect_Retired));
+    retired->table = table;
+    retired->refs = refs;
+    retired->capacity = capacity;
+    retired->epoch = sync_load(&vect->epoch);
+    retired->next = vect->retired;
+    vect->retired = retired;
+}
+
+/*
+ * Advances the epoch if every reader of the epoch before the current one has left,
+ * then de-allocates the tables which were retired at least two epochs ago.
+ * Θ(r), where r is the number of retired tables
+ */
+void vect_rcu_reclaim(Vector* const vect)
+{
+    const LONG64 epoch = sync_load(&vect->epoch);
+    if (sync_load(&vect->readers[(epoch + EPOCHS - 1) % EPOCHS]) == 0)
+        sync_fetch_add(&vect->epoch, 1);
+
+    const LONG64 current = sync_load(&vect->epoch);
+    vect_Retired** link = &vect->retired;
+    while (*link != NULL)
+    {
+        vect_Retired* const retired = *link;
+        if (retired->epoch + 2 <= current)
+        {
+            *link = retired->next;
+            vect_release(retired->table, retired->capacity, retired->refs);
+            mem_free(retired, sizeof(vect_Retired));
+        }
+        else link = &retired->next;
+    }
+}
+
+/*
+ * Returns a new reference count for a table which is not yet shared.
+ * Θ(1)
+ */
+sync_Word* vect_refs_new()
+{
+    sync_Word* const refs = mem_malloc(sizeof(sync_Word));
+    *refs = 1;
+    return refs;
+}
+
+/*
+ * Releases a reference to a table, de-allocating the table if no other Vector shares it.
+ * Θ(1)
+ */
+void vect_release(const void** const table, const size_t capacity, sync_Word* const refs)
+{
+    if (sync_fetch_add(refs, -1) == 1)
+    {
+        mem_free(table, capacity * sizeof(void*));
+        mem_free((void*)refs, sizeof(sync_Word));
+    }
 }
 
 /*
@@ -806,7 +1302,7 @@ void vect_quick_sort(const Vector* const vect, const unsigned int index, const s
         return;
     /* Pivot in this implementation is the right element. */
     const unsigned int pivot_index = index + size - 1;
-    const void* const pivot = vect_at(vect, pivot_index);
+    const void* const pivot = vect_element(vect, pivot_index);
 
     /* Left and right iterators. */
     unsigned int left = index, right = pivot_index;
@@ -814,9 +1310,9 @@ void vect_quick_sort(const Vector* const vect, const unsigned int index, const s
     while (true)
     {
         /* Move the indexes until they cross OR find swappable values. */
-        while (left < right && vect->compare(vect_at(vect, left), pivot) < 0)
+        while (left < right && vect->compare(vect_element(vect, left), pivot) < 0)
             left++;
-        while (left < right && vect->compare(vect_at(vect, --right), pivot) > 0);
+        while (left < right && vect->compare(vect_element(vect, --right), pivot) > 0);
 
         if (left >= right)
             break;
@@ -854,9 +1350,9 @@ void vect_merge_sort(const Vector* const vect, const unsigned int start, const s
     const void** const arr_left = mem_calloc(size_left, sizeof(void*));
     const void** const arr_right = mem_calloc(size_right, sizeof(void*));
     for (unsigned int i = 0; i < size_left; i++)
-        arr_left[i] = vect_at(vect, start + i);
+        arr_left[i] = vect_element(vect, start + i);
     for (unsigned int i = 0; i < size_right; i++)
-        arr_right[i] = vect_at(vect, start_right + i);
+        arr_right[i] = vect_element(vect, start_right + i);
 
     /* Maintain track of an iterator for the combined array and the two sub-arrays. */
     unsigned int iter = start, vect_iter_left = 0, vect_iter_right = 0;
@@ -902,4 +1398,85 @@ void vect_shift(Vector* const vect, const unsigned int start, const unsigned int
     }
 
     vect_iter_destroy(iter);
+}
+
+/*
+ * Shuffles a range of the table using the Fisher-Yates Shuffling Algorithm.
+ * Θ(n)
+ */
+static DWORD vect_shuffle_block(vect_Shuffle* const task)
+{
+    const void** const table = task->table;
+    for (size_t i = task->end; i > task->start + 1; i--)
+        vect_pswap(&table[i - 1], &table[task->start + rand_limit((unsigned int)(i - task->start))]);
+    return 0;
+}
+
+/*
+ * Merges two neighboring, shuffled ranges of the table into one shuffled range.
+ * Coin flips choose which range supplies the next element until either range runs out.
+ * The elements left over are then inserted at random positions, as in Fisher-Yates.
+ * Θ(n) expected
+ */
+static DWORD vect_shuffle_merge(vect_Shuffle* const task)
+{
+    const void** const table = task->table;
+    size_t i = task->start, j = task->middle;
+    while (true)
+    {
+        if (rand_bool())
+        {
+            if (j == task->end) break;
+            vect_pswap(&table[i], &table[j++]);
+        }
+        else if (i == j) break;
+        i++;
+    }
+
+    for (; i < task->end; i++)
+        vect_pswap(&table[i], &table[task->start + rand_limit((unsigned int)(i - task->start + 1))]);
+    return 0;
+}
+
+/*
+ * Performs every task of a shuffle round, each in its own thread.
+ * The calling thread performs the first task itself, and any task whose thread could not be created.
+ * Θ(t), where t is the number of tasks, plus the time of the longest task
+ */
+static void vect_shuffle_run(vect_Shuffle* const tasks, const unsigned int count,
+                             DWORD(*task)(vect_Shuffle* const))
+{
+    HANDLE* const workers = mem_calloc(count, sizeof(HANDLE));
+    for (unsigned int i = 1; i < count; i++)
+        workers[i] = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)task, &tasks[i], 0, NULL);
+
+    task(&tasks[0]);
+    for (unsigned int i = 1; i < count; i++)
+        if (workers[i] == NULL)
+            task(&tasks[i]);
+        else
+        {
+            WaitForSingleObject(workers[i], INFINITE);
+            CloseHandle(workers[i]);
+        }
+
+    mem_free(workers, count * sizeof(HANDLE));
+}
+
+/*
+ * Adds an index to a set of sampled indexes, returning false if it was already present.
+ * The set uses linear probing, and empty slots hold UINT_MAX.
+ * Θ(1) expected
+ */
+static bool vect_sample_add(unsigned int* const set, const size_t slots, const unsigned int index)
+{
+    for (size_t slot = MATH_FASTRANGE(index * 0x9E3779B9U, slots); ; slot = (slot + 1) & (slots - 1))
+    {
+        if (set[slot] == index) return false;
+        if (set[slot] == UINT_MAX)
+        {
+            set[slot] = index;
+            return true;
+        }
+    }
 }
\ No newline at end of file
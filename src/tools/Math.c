@@ -28,6 +28,11 @@ SOFTWARE.
  */
 
 #include "Math.h"
+#include <limits.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 /*
  * Returns the base to the power of the exponent.
@@ -62,10 +67,149 @@ unsigned int math_max(const unsigned int a, const unsigned int b)
 /*
  * Returns the smallest power of the base which is greater than or equal to the specified value.
  * Ex. base=4, value=111 -> return=256
- * Θ(1)
+ * Θ(1) if the base is a power of two, otherwise Θ(log(n))
  */
 unsigned int math_min_power_gt(const unsigned int base, const unsigned int greater_than)
 {
-    if (greater_than <= base) return base;
-    return (unsigned int)math_pow(base, (unsigned int)ceil(log((double)greater_than) / log((double)base)));
+    /* Every power of 0 or 1 is itself. */
+    if (greater_than <= base || base <= 1) return base;
+    if ((base & (base - 1)) == 0)
+    {
+        /* The power must also be a power of the base, so round its exponent up to a multiple of the base's. */
+        const unsigned int step = math_ilog2(base);
+        const unsigned int exp = math_ilog2(math_next_pow2(greater_than));
+        return 1U << (MATH_DIV_CEIL(exp, step) * step);
+    }
+
+    unsigned long long power = base;
+    while (power < greater_than)
+        power *= base;
+    return (unsigned int)power;
+}
+
+/*
+ * Returns the number of bits which are set in the value.
+ * Bits are summed in parallel: pairs, then nibbles, then bytes.
+ * Θ(1)
+ */
+unsigned int math_popcount(unsigned int value)
+{
+    value = value - ((value >> 1) & 0x55555555U);
+    value = (value & 0x33333333U) + ((value >> 2) & 0x33333333U);
+    value = (value + (value >> 4)) & 0x0F0F0F0FU;
+    return (value * 0x01010101U) >> 24;
+}
+
+/*
+ * Returns the number of bits which are set in the 64-bit value.
+ * Compiles down to a single population count instruction where one is available.
+ * Θ(1)
+ */
+unsigned int math_popcount64(const unsigned long long value)
+{
+#if defined(__GNUC__)
+    return (unsigned int)__builtin_popcountll(value);
+#else
+    return math_popcount((unsigned int)value) + math_popcount((unsigned int)(value >> 32));
+#endif
+}
+
+/*
+ * Returns the index of the highest set bit of a non-zero value.
+ * Compiles down to a single count-leading-zeros instruction where one is available.
+ * Θ(1)
+ */
+unsigned int math_ilog2(const unsigned long long value)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return index;
+#elif defined(__GNUC__)
+    return (unsigned int)(sizeof(unsigned long long) * CHAR_BIT - 1) - (unsigned int)__builtin_clzll(value);
+#else
+    unsigned long long remaining = value;
+    unsigned int result = 0;
+    /* Halve the search window each step, from half the bits down to a single bit. */
+    for (unsigned int bits = sizeof(unsigned long long) * CHAR_BIT / 2; bits > 0; bits >>= 1)
+        if (remaining >> bits)
+        {
+            remaining >>= bits;
+            result += bits;
+        }
+    return result;
+#endif
+}
+
+/*
+ * Returns the smallest power of two which is greater than or equal to the specified value.
+ * Values of 0 and 1 both return 1.
+ * Θ(1)
+ */
+size_t math_next_pow2(const size_t value)
+{
+    if (value <= 1) return 1;
+    return (size_t)1 << (math_ilog2(value - 1) + 1);
+}
+
+/*
+ * Returns the 32-bit hash with its bits avalanched, so that every input bit affects every output bit.
+ * This is the finalizer of MurmurHash3. For details, see: https://github.com/aappleby/smhasher
+ * Θ(1)
+ */
+unsigned int math_fmix32(unsigned int hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6BU;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35U;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/*
+ * Returns the 64-bit hash with its bits avalanched, so that every input bit affects every output bit.
+ * This is the 64-bit finalizer of MurmurHash3.
+ * Θ(1)
+ */
+unsigned long long math_fmix64(unsigned long long hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/*
+ * Stores the product of two sizes and returns true if it overflowed.
+ * The product is only meaningful when no overflow occurred.
+ * Θ(1)
+ */
+bool math_mul_overflows(const size_t a, const size_t b, size_t* const product)
+{
+    *product = a * b;
+    return a != 0 && *product / a != b;
+}
+
+/*
+ * Returns the upper 64 bits of the 128-bit product of two integers.
+ * Θ(1)
+ */
+unsigned long long math_mulhi(const unsigned long long a, const unsigned long long b)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    return __umulh(a, b);
+#elif defined(__SIZEOF_INT128__)
+    return (unsigned long long)(((unsigned __int128)a * b) >> 64);
+#else
+    /* Multiply the 32-bit halves, carrying the middle terms into the upper half. */
+    const unsigned long long a_lo = (unsigned int)a, a_hi = a >> 32;
+    const unsigned long long b_lo = (unsigned int)b, b_hi = b >> 32;
+    const unsigned long long low = a_lo * b_lo;
+    const unsigned long long middle = a_hi * b_lo + (low >> 32);
+    const unsigned long long carry = (unsigned int)middle + a_lo * b_hi;
+    return a_hi * b_hi + (middle >> 32) + (carry >> 32);
+#endif
 }
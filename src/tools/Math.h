@@ -31,7 +31,12 @@ SOFTWARE.
 
 #include "Math.h"
 
+#include <stddef.h>
+#include <stdbool.h>
+
 #define MATH_DIV_CEIL(dividend, divisor) (1 + ((dividend - 1) / divisor))
+/* Maps a 32-bit hash onto [0, range) with a multiply and a shift instead of a modulus. */
+#define MATH_FASTRANGE(hash, range) ((size_t)(((unsigned long long)(unsigned int)(hash) * (range)) >> 32))
 
 /* Returns the base to the power of the exponent. */
 unsigned long long math_pow(unsigned long long base, unsigned int exp);
@@ -39,3 +44,19 @@ unsigned long long math_pow(unsigned long long base, unsigned int exp);
 unsigned int math_max(const unsigned int a, const unsigned int b);
 /* Returns the smallest power of the base which is greater than or equal to the specified value. */
 unsigned int math_min_power_gt(const unsigned int base, const unsigned int greater_than);
+/* Returns the number of bits which are set in the value. */
+unsigned int math_popcount(unsigned int value);
+/* Returns the number of bits which are set in the 64-bit value. */
+unsigned int math_popcount64(const unsigned long long value);
+/* Returns the index of the highest set bit of a non-zero value. */
+unsigned int math_ilog2(const unsigned long long value);
+/* Returns the smallest power of two which is greater than or equal to the specified value. */
+size_t math_next_pow2(const size_t value);
+/* Returns the 32-bit hash with its bits avalanched, so that every input bit affects every output bit. */
+unsigned int math_fmix32(unsigned int hash);
+/* Returns the 64-bit hash with its bits avalanched, so that every input bit affects every output bit. */
+unsigned long long math_fmix64(unsigned long long hash);
+/* Stores the product of two sizes and returns true if it overflowed. */
+bool math_mul_overflows(const size_t a, const size_t b, size_t* const product);
+/* Returns the upper 64 bits of the 128-bit product of two integers. */
+unsigned long long math_mulhi(const unsigned long long a, const unsigned long long b);
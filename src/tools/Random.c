@@ -0,0 +1,225 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       Random.c
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#include "Random.h"
+#include "Synchronize.h"
+
+#include <time.h>
+
+/* Storage class of the per-thread generator. */
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+/* Independent generators which `rand_fill` advances side by side, so that the compiler can vectorize them. */
+#define LANES 4
+#define ROTATE(value, bits) (((value) << (bits)) | ((value) >> (64 - (bits))))
+
+/*
+ * Generator:
+ * Each thread owns a xoshiro256++ generator, so generating never locks or shares cache lines.
+ * For details, see: Blackman and Vigna, "Scrambled Linear Pseudorandom Number Generators".
+ * Unseeded threads draw a distinct seed from a shared counter, which SplitMix64 spreads over the state.
+ */
+
+/* Generator structure. */
+typedef struct rand_State
+{
+    unsigned long long s[4];
+    bool seeded;
+} rand_State;
+
+/* Generator of the calling thread. */
+static THREAD_LOCAL rand_State state;
+/* Number of generators which were seeded automatically. */
+static sync_Word generators;
+/* Coin flips left over from the calling thread's last call to `rand_bool`. */
+static THREAD_LOCAL unsigned long long flips;
+static THREAD_LOCAL unsigned int flips_left;
+
+/* Local functions. */
+static rand_State* rand_state();
+static unsigned long long rand_splitmix(unsigned long long* const seed);
+static unsigned long long rand_xoshiro(unsigned long long* const s);
+
+/*
+ * Seeds the calling thread's generator, making its sequence reproducible.
+ * Θ(1)
+ */
+void rand_seed(const unsigned long long seed)
+{
+    unsigned long long mixed = seed;
+    for (unsigned int i = 0; i < 4; i++)
+        state.s[i] = rand_splitmix(&mixed);
+    state.seeded = true;
+    flips_left = 0;
+}
+
+/*
+ * Returns 64 pseudo-random bits.
+ * Θ(1)
+ */
+unsigned long long rand_next()
+{
+    return rand_xoshiro(rand_state()->s);
+}
+
+/*
+ * Returns a pseudo-random integer from 0 up to, but excluding, the specified limit.
+ * The result is exactly uniform. Multiplying maps the random bits onto the range without a division,
+ * and the few products which would bias the result are rejected.
+ * For details, see: Lemire, "Fast Random Integer Generation in an Interval".
+ * Θ(1) expected
+ */
+unsigned int rand_limit(const unsigned int limit)
+{
+    io_assert(limit > 0, IO_MSG_INVALID_SIZE);
+
+    unsigned long long product = (rand_next() >> 32) * limit;
+    if ((unsigned int)product < limit)
+    {
+        /* Only products whose lower half falls below 2^32 mod limit are biased. */
+        const unsigned int threshold = (0U - limit) % limit;
+        while ((unsigned int)product < threshold)
+            product = (rand_next() >> 32) * limit;
+    }
+    return (unsigned int)(product >> 32);
+}
+
+/*
+ * Returns true or false with equal probability.
+ * A single 64-bit draw is spent across 64 calls.
+ * Θ(1)
+ */
+bool rand_bool()
+{
+    if (flips_left == 0)
+    {
+        flips = rand_next();
+        flips_left = 64;
+    }
+    const bool flip = (flips & 1) != 0;
+    flips >>= 1;
+    flips_left--;
+    return flip;
+}
+
+/*
+ * Returns a pseudo-random real number between 0 and 1, exclusive of both.
+ * The upper 53 bits fill a double's mantissa, offset by half a step so that neither 0 nor 1 can be returned.
+ * Θ(1)
+ */
+double rand_unit()
+{
+    return ((double)(rand_next() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/*
+ * Fills the buffer with the specified number of pseudo-random 64-bit integers.
+ * Lanes seeded from the thread's generator are stepped together, one output from each lane per step.
+ * Θ(n)
+ */
+void rand_fill(unsigned long long* const buffer, const size_t count)
+{
+    io_assert(buffer != NULL, IO_MSG_NULL_PTR);
+
+    /* State is stored lane by lane, so each word of the step is one vector operation across the lanes. */
+    unsigned long long s0[LANES], s1[LANES], s2[LANES], s3[LANES];
+    for (unsigned int lane = 0; lane < LANES; lane++)
+    {
+        unsigned long long seed = rand_next();
+        s0[lane] = rand_splitmix(&seed);
+        s1[lane] = rand_splitmix(&seed);
+        s2[lane] = rand_splitmix(&seed);
+        s3[lane] = rand_splitmix(&seed);
+    }
+
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES)
+        for (unsigned int lane = 0; lane < LANES; lane++)
+        {
+            buffer[i + lane] = ROTATE(s0[lane] + s3[lane], 23) + s0[lane];
+            const unsigned long long t = s1[lane] << 17;
+            s2[lane] ^= s0[lane];
+            s3[lane] ^= s1[lane];
+            s1[lane] ^= s2[lane];
+            s0[lane] ^= s3[lane];
+            s2[lane] ^= t;
+            s3[lane] = ROTATE(s3[lane], 45);
+        }
+    for (; i < count; i++)
+        buffer[i] = rand_next();
+}
+
+/*
+ * Returns the calling thread's generator, seeding it first if needed.
+ * Θ(1)
+ */
+static rand_State* rand_state()
+{
+    if (!state.seeded)
+    {
+        /* Distinct threads and processes start from distinct seeds. */
+        const unsigned long long seed = (unsigned long long)time(NULL) ^ (unsigned long long)(size_t)&state;
+        rand_seed(seed + (unsigned long long)sync_fetch_add(&generators, 1) * 0x9E3779B97F4A7C15ULL);
+    }
+    return &state;
+}
+
+/*
+ * Advances a SplitMix64 seed and returns its next output.
+ * Used to spread seeds over generator state, which must not be all zeroes.
+ * Θ(1)
+ */
+static unsigned long long rand_splitmix(unsigned long long* const seed)
+{
+    unsigned long long z = (*seed += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/*
+ * Advances a xoshiro256++ state and returns its next output.
+ * Θ(1)
+ */
+static unsigned long long rand_xoshiro(unsigned long long* const s)
+{
+    const unsigned long long result = ROTATE(s[0] + s[3], 23) + s[0];
+    const unsigned long long t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = ROTATE(s[3], 45);
+    return result;
+}
@@ -0,0 +1,56 @@
+
+/*
+Copyright © 2017 Kevin Tyrrell
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * File Name:       Random.h
+ * File Author:     Kevin Tyrrell
+ * Date Created:    10/18/2026
+ */
+
+#pragma once
+
+#include "Memory.h"
+#include "Math.h"
+
+#include <stdbool.h>
+
+/* ~~~~~ Mutators ~~~~~ */
+
+/*
+ * Seeds the calling thread's generator, making its sequence reproducible.
+ * Threads which never call this function are seeded with distinct values automatically.
+ */
+void rand_seed(const unsigned long long seed);
+
+/* ~~~~~ Generators ~~~~~ */
+
+/* Returns 64 pseudo-random bits. */
+unsigned long long rand_next();
+/* Returns a pseudo-random integer from 0 up to, but excluding, the specified limit. */
+unsigned int rand_limit(const unsigned int limit);
+/* Returns true or false with equal probability. */
+bool rand_bool();
+/* Returns a pseudo-random real number between 0 and 1, exclusive of both. */
+double rand_unit();
+/* Fills the buffer with the specified number of pseudo-random 64-bit integers. */
+void rand_fill(unsigned long long* const buffer, const size_t count);
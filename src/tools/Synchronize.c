@@ -30,6 +30,8 @@ SOFTWARE.
 #include "Synchronize.h"
 
 #define SYNC_SEMAPHORE_MAX 1
+/* Number of failed attempts after which `sync_backoff` gives up the time slice. */
+#define SYNC_SPIN_LIMIT 16
 #define SYNC_MSG_NO_READERS "Unable to stop reading since there are no current readers!"
 #define SYNC_MSG_NO_WRITERS "Unable to stop writing since there are no current writers!"
 
@@ -182,6 +184,42 @@ void sync_write_end(ReadWriteSync* const rw_sync)
     mutex_signal(rw_sync->writers_mutex);
 }
 
+/*
+ * Yields the processor to other threads after a failed lock-free attempt.
+ * The first few attempts only spin, later attempts give up the thread's time slice.
+ * Θ(1)
+ */
+void sync_backoff(const unsigned int attempt)
+{
+    if (attempt < SYNC_SPIN_LIMIT)
+        YieldProcessor();
+    else SwitchToThread();
+}
+
+/*
+ * Returns the number of NUMA nodes in the system.
+ * Systems without NUMA support are treated as a single node.
+ * Θ(1)
+ */
+unsigned int sync_numa_nodes()
+{
+    ULONG highest;
+    return GetNumaHighestNodeNumber(&highest) ? (unsigned int)highest + 1 : 1;
+}
+
+/*
+ * Returns the NUMA node of the processor which is running the calling thread.
+ * The thread may be moved to another processor at any time, so the result is only a hint.
+ * Θ(1)
+ */
+unsigned int sync_numa_node()
+{
+    PROCESSOR_NUMBER processor;
+    USHORT node;
+    GetCurrentProcessorNumberEx(&processor);
+    return GetNumaProcessorNodeEx(&processor, &node) ? node : 0;
+}
+
 /*
  * De-constructor function.
  * Θ(1)
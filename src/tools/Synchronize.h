@@ -53,6 +53,49 @@ void sync_write_start(ReadWriteSync* const rw_sync);
 /* Removes a writer that was previously writing. */
 void sync_write_end(ReadWriteSync* const rw_sync);
 
+/* Yields the processor to other threads after a failed lock-free attempt. */
+void sync_backoff(const unsigned int attempt);
+
+/* ~~~~~ Topology ~~~~~ */
+
+/* Returns the number of NUMA nodes in the system. */
+unsigned int sync_numa_nodes();
+/* Returns the NUMA node of the processor which is running the calling thread. */
+unsigned int sync_numa_node();
+
 /* ~~~~~ De-constructors ~~~~~ */
 
-void sync_destroy(ReadWriteSync* const rw_sync);
\ No newline at end of file
+void sync_destroy(ReadWriteSync* const rw_sync);
+
+/* ~~~~~ Atomics ~~~~~ */
+
+/* Integer which may be read and written by multiple threads without a lock. */
+typedef volatile LONG64 sync_Word;
+
+/* Returns the value of a shared word. Later loads cannot be ordered before it. */
+#define sync_load(word) ReadAcquire64(word)
+/* Stores a value into a shared word. Earlier stores cannot be ordered after it. */
+#define sync_store(word, value) WriteRelease64(word, value)
+/* Replaces a shared word with `desired` if it still holds `expected`. Returns true on success. */
+#define sync_cas(word, expected, desired) (InterlockedCompareExchange64(word, desired, expected) == (expected))
+/* Adds to a shared word and returns its previous value. */
+#define sync_fetch_add(word, value) InterlockedExchangeAdd64(word, value)
+/* Sets bits of a shared word and returns its previous value. */
+#define sync_fetch_or(word, value) InterlockedOr64(word, value)
+
+/* Returns the value of a shared pointer. Later loads cannot be ordered before it. */
+#define sync_load_ptr(ptr) ReadPointerAcquire((void* volatile*)(ptr))
+/* Stores a value into a shared pointer. Earlier stores cannot be ordered after it. */
+#define sync_store_ptr(ptr, value) WritePointerRelease((void* volatile*)(ptr), (void*)(value))
+/* Replaces a shared pointer with `desired` if it still holds `expected`. Returns true on success. */
+#define sync_cas_ptr(ptr, expected, desired) \
+    (InterlockedCompareExchangePointer((void* volatile*)(ptr), (void*)(desired), (void*)(expected)) == (expected))
+
+/* Prevents loads before the fence from being re-ordered after loads following it. */
+#if defined(_M_ARM) || defined(_M_ARM64)
+#define sync_load_fence() MemoryBarrier()
+#else
+#define sync_load_fence() _ReadWriteBarrier()
+#endif
+/* Prevents any load or store from being re-ordered across the fence, including a store before a later load. */
+#define sync_fence() MemoryBarrier()
\ No newline at end of file